@@ -82,6 +82,12 @@ namespace iroha {
        */
       virtual rxcpp::observable<model::Block> getTopBlocks(uint32_t count) = 0;
 
+      /**
+       * Get top block of the ledger, which is kept in memory
+       * @return top block or nullptr, if the ledger is empty
+       */
+      virtual std::shared_ptr<const model::Block> getTopBlock() = 0;
+
       /**
        * Synchronously gets transaction by its hash
        * @param hash - hash to search
@@ -89,6 +95,14 @@ namespace iroha {
        */
       virtual boost::optional<model::Transaction> getTxByHashSync(
           const std::string &hash) = 0;
+
+      /**
+       * Synchronously gets block by its hash
+       * @param hash - hash of the block
+       * @return block or boost::none
+       */
+      virtual boost::optional<model::Block> getBlockByHash(
+          const model::Block::HashType &hash) = 0;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
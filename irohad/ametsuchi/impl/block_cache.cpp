@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    constexpr size_t BlockCache::DEFAULT_BUDGET;
+
+    BlockCache::BlockCache(size_t budget)
+        : budget_(budget), used_(0), hits_(0), misses_(0) {}
+
+    void BlockCache::put(std::shared_ptr<const model::Block> block,
+                         size_t size) {
+      if (size > budget_) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      auto it = index_.find(block->height);
+      if (it != index_.end()) {
+        used_ -= it->second->size;
+        lru_.erase(it->second);
+        index_.erase(it);
+      }
+      const auto height = block->height;
+      lru_.push_front(Entry{std::move(block), size});
+      index_.emplace(height, lru_.begin());
+      used_ += size;
+      evict();
+    }
+
+    std::shared_ptr<const model::Block> BlockCache::get(HeightType height) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto it = index_.find(height);
+      if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+      }
+      ++hits_;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->block;
+    }
+
+    void BlockCache::clear() {
+      std::lock_guard<std::mutex> lock(lock_);
+      index_.clear();
+      lru_.clear();
+      used_ = 0;
+    }
+
+    size_t BlockCache::hits() const {
+      return hits_;
+    }
+
+    size_t BlockCache::misses() const {
+      return misses_;
+    }
+
+    size_t BlockCache::used() const {
+      std::lock_guard<std::mutex> lock(lock_);
+      return used_;
+    }
+
+    size_t BlockCache::budget() const {
+      return budget_;
+    }
+
+    void BlockCache::evict() {
+      while (used_ > budget_) {
+        const auto &entry = lru_.back();
+        used_ -= entry.size;
+        index_.erase(entry.block->height);
+        lru_.pop_back();
+      }
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_CACHE_HPP
+#define IROHA_BLOCK_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Bounded LRU cache of decoded blocks keyed by height.
+     * Memory used by a block is approximated by the size of its serialized
+     * form; least recently used blocks are evicted when the total exceeds
+     * the budget. Safe to use from multiple threads.
+     */
+    class BlockCache {
+     public:
+      using HeightType = model::Block::BlockHeightType;
+
+      static constexpr size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+      /**
+       * @param budget - maximal total size of cached blocks in bytes,
+       * zero disables the cache
+       */
+      explicit BlockCache(size_t budget = DEFAULT_BUDGET);
+
+      /**
+       * Cache block, replacing the one with the same height if present.
+       * Blocks larger than the whole budget are not cached.
+       * @param block - decoded block
+       * @param size - approximate size of the block in bytes
+       */
+      void put(std::shared_ptr<const model::Block> block, size_t size);
+
+      /**
+       * Get block and mark it as recently used
+       * @param height - height of the block
+       * @return cached block or nullptr, if there is no such block in cache
+       */
+      std::shared_ptr<const model::Block> get(HeightType height);
+
+      /**
+       * Remove all blocks from the cache
+       */
+      void clear();
+
+      /**
+       * @return number of get calls which found a block
+       */
+      size_t hits() const;
+
+      /**
+       * @return number of get calls which did not find a block
+       */
+      size_t misses() const;
+
+      /**
+       * @return total size of cached blocks in bytes
+       */
+      size_t used() const;
+
+      /**
+       * @return maximal total size of cached blocks in bytes
+       */
+      size_t budget() const;
+
+     private:
+      struct Entry {
+        std::shared_ptr<const model::Block> block;
+        size_t size;
+      };
+
+      /**
+       * Remove least recently used blocks until cache fits in budget
+       */
+      void evict();
+
+      const size_t budget_;
+      size_t used_;
+
+      // most recently used blocks are in the front
+      std::list<Entry> lru_;
+      std::unordered_map<HeightType, std::list<Entry>::iterator> index_;
+
+      std::atomic<size_t> hits_;
+      std::atomic<size_t> misses_;
+
+      mutable std::mutex lock_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_CACHE_HPP
@@ -23,7 +23,8 @@
 namespace iroha {
   namespace ametsuchi {
     /**
-     * Internal interface for modifying index on blocks and transactions
+     * Internal interface for modifying index on blocks and transactions.
+     * Indexed blocks become visible to queries only after commit
      */
     class BlockIndex {
      public:
@@ -34,6 +35,16 @@ namespace iroha {
        * @param block to be indexed
        */
       virtual void index(const model::Block &block) = 0;
+
+      /**
+       * Make all blocks indexed so far visible to queries
+       */
+      virtual void commit() = 0;
+
+      /**
+       * Forget all blocks indexed since the last commit
+       */
+      virtual void discard() = 0;
     };
   } // namespace ametsuchi
 } // namespace iroha
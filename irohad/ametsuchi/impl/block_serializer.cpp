@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_serializer.hpp"
+
+#include <algorithm>
+
+#include "model/converters/json_common.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BlockSerializer::BlockSerializer()
+        : log_(logger::log("BlockSerializer")) {}
+
+    std::vector<uint8_t> BlockSerializer::serialize(const model::Block &block) {
+      auto pb_block = pb_factory_.serialize(block);
+      std::vector<uint8_t> bytes(1 + block.hash.size()
+                                 + pb_block.ByteSizeLong());
+      bytes[0] = PROTOBUF_V1;
+      std::copy(block.hash.begin(), block.hash.end(), bytes.begin() + 1);
+      pb_block.SerializeToArray(bytes.data() + 1 + block.hash.size(),
+                                bytes.size() - 1 - block.hash.size());
+      return bytes;
+    }
+
+    nonstd::optional<model::Block> BlockSerializer::deserialize(
+        const uint8_t *data, size_t size) {
+      if (size == 0) {
+        log_->error("empty block record");
+        return nonstd::nullopt;
+      }
+
+      switch (data[0]) {
+        case PROTOBUF_V1: {
+          const auto hash_size = model::Block::HashType::size();
+          protocol::Block pb_block;
+          if (size < 1 + hash_size
+              or not pb_block.ParseFromArray(data + 1 + hash_size,
+                                             size - 1 - hash_size)) {
+            log_->error("malformed protobuf block record");
+            return nonstd::nullopt;
+          }
+          try {
+            // keep the hash which block was committed with
+            model::Block::HashType hash;
+            std::copy(data + 1, data + 1 + hash_size, hash.begin());
+            return pb_factory_.deserialize(pb_block, hash);
+          } catch (const BadFormatException &e) {
+            log_->error("malformed protobuf block record: {}", e.what());
+            return nonstd::nullopt;
+          }
+        }
+        case JSON:
+          return model::converters::stringToJson(
+                     std::string(data, data + size))
+              | [this](const auto &json) {
+                  return json_factory_.deserialize(json);
+                };
+        default:
+          log_->error("unknown block record format {}", int(data[0]));
+          return nonstd::nullopt;
+      }
+    }
+
+    nonstd::optional<model::Block> BlockSerializer::deserialize(
+        const std::vector<uint8_t> &bytes) {
+      return deserialize(bytes.data(), bytes.size());
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
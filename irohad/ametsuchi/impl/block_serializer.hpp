@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_SERIALIZER_HPP
+#define IROHA_BLOCK_SERIALIZER_HPP
+
+#include <cstdint>
+#include <nonstd/optional.hpp>
+#include <vector>
+
+#include "logger/logger.hpp"
+#include "model/block.hpp"
+#include "model/converters/json_block_factory.hpp"
+#include "model/converters/pb_block_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * On-disk representation of blocks in block store.
+     *
+     * Every record starts with a format tag:
+     *  - PROTOBUF_V1: tag, hash of the block, serialized protocol::Block;
+     *  - JSON: legacy records, which are JSON documents starting with '{'.
+     * New blocks are always written in the latest binary format, legacy
+     * records are still readable, so existing ledgers do not need an offline
+     * migration.
+     */
+    class BlockSerializer {
+     public:
+      enum Format : uint8_t {
+        PROTOBUF_V1 = 0x01,  // tag + 32 bytes of hash + protobuf block
+        JSON = '{'           // legacy JSON document without tag
+      };
+
+      BlockSerializer();
+
+      /**
+       * Serialize block into latest binary format
+       * @param block - block to serialize
+       * @return tagged record
+       */
+      std::vector<uint8_t> serialize(const model::Block &block);
+
+      /**
+       * Deserialize block from record in any known format
+       * @param data - pointer to the beginning of record
+       * @param size - size of record
+       * @return block, if record is well-formed
+       */
+      nonstd::optional<model::Block> deserialize(const uint8_t *data,
+                                                 size_t size);
+
+      /**
+       * Deserialize block from record in any known format
+       * @param bytes - record
+       * @return block, if record is well-formed
+       */
+      nonstd::optional<model::Block> deserialize(
+          const std::vector<uint8_t> &bytes);
+
+     private:
+      model::converters::PbBlockFactory pb_factory_;
+      model::converters::JsonBlockFactory json_factory_;
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_SERIALIZER_HPP
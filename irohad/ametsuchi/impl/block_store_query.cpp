@@ -0,0 +1,154 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_store_query.hpp"
+
+#include <atomic>
+
+#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BlockStoreQuery::BlockStoreQuery(KeyValueStorage &block_store,
+                                     std::shared_ptr<BlockCache> block_cache)
+        : block_store_(block_store), block_cache_(std::move(block_cache)) {}
+
+    std::shared_ptr<const model::Block> BlockStoreQuery::getBlock(
+        uint32_t id) {
+      if (auto block = block_cache_->get(id)) {
+        return block;
+      }
+      auto view = block_store_.view(id);
+      if (not view.has_value()) {
+        return nullptr;
+      }
+      auto block = serializer_.deserialize(view->data(), view->size());
+      if (not block.has_value()) {
+        return nullptr;
+      }
+      auto result =
+          std::make_shared<const model::Block>(std::move(block.value()));
+      block_cache_->put(result, view->size());
+      return result;
+    }
+
+    rxcpp::observable<model::Block> BlockStoreQuery::getBlocks(uint32_t height,
+                                                               uint32_t count) {
+      auto to = height + count;
+      auto last_id = block_store_.last_id();
+      to = std::min(to, last_id);
+      if (height > to) {
+        return rxcpp::observable<>::empty<model::Block>();
+      }
+      return rxcpp::observable<>::range(height, to).flat_map([this](auto i) {
+        auto block = this->getBlock(i);
+        return rxcpp::observable<>::create<model::Block>([block](auto s) {
+          if (block) {
+            s.on_next(*block);
+          }
+          s.on_completed();
+        });
+      });
+    }
+
+    rxcpp::observable<model::Block> BlockStoreQuery::getBlocksFrom(
+        uint32_t height) {
+      return getBlocks(height, block_store_.last_id());
+    }
+
+    rxcpp::observable<model::Block> BlockStoreQuery::getTopBlocks(
+        uint32_t count) {
+      auto last_id = block_store_.last_id();
+      count = std::min(count, last_id);
+      return getBlocks(last_id - count + 1, count);
+    }
+
+    std::shared_ptr<const model::Block> BlockStoreQuery::getTopBlock() {
+      const auto last_id = block_store_.last_id();
+      if (last_id == 0) {
+        return nullptr;
+      }
+      auto top_block = std::atomic_load(&top_block_);
+      if (top_block and top_block->height == last_id) {
+        return top_block;
+      }
+      // block store was modified not through storage, e.g. dropped
+      top_block = getBlock(last_id);
+      std::atomic_store(&top_block_, top_block);
+      return top_block;
+    }
+
+    void BlockStoreQuery::setTopBlock(
+        std::shared_ptr<const model::Block> block) {
+      std::atomic_store(&top_block_, std::move(block));
+    }
+
+    rxcpp::observable<boost::optional<model::Transaction>>
+    BlockStoreQuery::getTransactions(
+        const std::vector<iroha::hash256_t> &tx_hashes) {
+      return rxcpp::observable<>::create<boost::optional<model::Transaction>>(
+          [this, tx_hashes](auto subscriber) {
+            std::for_each(tx_hashes.begin(),
+                          tx_hashes.end(),
+                          [ that = this, &subscriber ](auto tx_hash) {
+                            subscriber.on_next(
+                                that->getTxByHashSync(tx_hash.to_string()));
+                          });
+            subscriber.on_completed();
+          });
+    }
+
+    boost::optional<model::Transaction> BlockStoreQuery::getTxByHashSync(
+        const std::string &hash) {
+      auto position = getTxPosition(hash);
+      if (not position) {
+        return boost::none;
+      }
+      auto block = getBlock(position->height);
+      if (not block) {
+        return boost::none;
+      }
+      if (position->index) {
+        if (*position->index >= block->transactions.size()) {
+          return boost::none;
+        }
+        return block->transactions[*position->index];
+      }
+      auto it = std::find_if(
+          block->transactions.begin(),
+          block->transactions.end(),
+          [&hash](auto tx) { return iroha::hash(tx).to_string() == hash; });
+      return (it == block->transactions.end())
+          ? boost::none
+          : boost::optional<model::Transaction>(*it);
+    }
+
+    boost::optional<model::Block> BlockStoreQuery::getBlockByHash(
+        const model::Block::HashType &hash) {
+      auto height = getBlockHeight(hash.to_string());
+      if (not height) {
+        return boost::none;
+      }
+      auto block = getBlock(*height);
+      if (not block or block->hash != hash) {
+        return boost::none;
+      }
+      return *block;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_STORE_QUERY_HPP
+#define IROHA_BLOCK_STORE_QUERY_HPP
+
+#include "ametsuchi/block_query.hpp"
+
+#include <boost/optional.hpp>
+
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/key_value_storage.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+    /**
+     * Part of BlockQuery which reads blocks from block store, independent of
+     * index backend.
+     * Decoded blocks are kept in block cache, which may be shared with
+     * storage, so that committed blocks are served without reading them.
+     */
+    class BlockStoreQuery : public BlockQuery {
+     public:
+      BlockStoreQuery(KeyValueStorage &block_store,
+                      std::shared_ptr<BlockCache> block_cache);
+
+      rxcpp::observable<boost::optional<model::Transaction>> getTransactions(
+          const std::vector<iroha::hash256_t> &tx_hashes) override;
+
+      boost::optional<model::Transaction> getTxByHashSync(
+          const std::string &hash) override;
+
+      boost::optional<model::Block> getBlockByHash(
+          const model::Block::HashType &hash) override;
+
+      rxcpp::observable<model::Block> getBlocks(uint32_t height,
+                                                uint32_t count) override;
+
+      rxcpp::observable<model::Block> getBlocksFrom(uint32_t height) override;
+
+      rxcpp::observable<model::Block> getTopBlocks(uint32_t count) override;
+
+      std::shared_ptr<const model::Block> getTopBlock() override;
+
+      /**
+       * Remember the new top block of the ledger, so that it is not read
+       * from block store
+       * @param block - block which was just committed
+       */
+      void setTopBlock(std::shared_ptr<const model::Block> block);
+
+     protected:
+      /**
+       * Location of transaction in block store
+       */
+      struct TxPosition {
+        model::Block::BlockHeightType height;
+        /// index of transaction in the block, absent in legacy index entries
+        boost::optional<size_t> index;
+      };
+
+      /**
+       * Returns position of transaction with a given hash
+       * @param hash - hash of transaction
+       * @return block id and index of transaction in it or boost::none
+       */
+      virtual boost::optional<TxPosition> getTxPosition(
+          const std::string &hash) = 0;
+
+      /**
+       * Returns height of block with a given hash
+       * @param hash - hash of block
+       * @return block id or boost::none
+       */
+      virtual boost::optional<model::Block::BlockHeightType> getBlockHeight(
+          const std::string &hash) = 0;
+
+      /**
+       * Returns block with given height from cache or block store
+       * @param id - height of the block
+       * @return block or nullptr, if there is no such block
+       */
+      std::shared_ptr<const model::Block> getBlock(uint32_t id);
+
+      KeyValueStorage &block_store_;
+      std::shared_ptr<BlockCache> block_cache_;
+      BlockSerializer serializer_;
+
+     private:
+      // accessed only with atomic operations
+      std::shared_ptr<const model::Block> top_block_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORE_QUERY_HPP
@@ -0,0 +1,125 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/cached_wsv_command.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    CachedWsvCommand::CachedWsvCommand(std::unique_ptr<WsvCommand> command,
+                                       std::shared_ptr<WsvCache::Keys> written)
+        : command_(std::move(command)), written_(std::move(written)) {}
+
+    bool CachedWsvCommand::insertRole(const std::string &role_name) {
+      written_->role_permissions.insert(role_name);
+      return command_->insertRole(role_name);
+    }
+
+    bool CachedWsvCommand::insertAccountRole(const std::string &account_id,
+                                             const std::string &role_name) {
+      written_->account_roles.insert(account_id);
+      return command_->insertAccountRole(account_id, role_name);
+    }
+
+    bool CachedWsvCommand::deleteAccountRole(const std::string &account_id,
+                                             const std::string &role_name) {
+      written_->account_roles.insert(account_id);
+      return command_->deleteAccountRole(account_id, role_name);
+    }
+
+    bool CachedWsvCommand::insertRolePermissions(
+        const std::string &role_id, const std::set<std::string> &permissions) {
+      written_->role_permissions.insert(role_id);
+      return command_->insertRolePermissions(role_id, permissions);
+    }
+
+    bool CachedWsvCommand::insertAccount(const model::Account &account) {
+      written_->accounts.insert(account.account_id);
+      return command_->insertAccount(account);
+    }
+
+    bool CachedWsvCommand::updateAccount(const model::Account &account) {
+      written_->accounts.insert(account.account_id);
+      return command_->updateAccount(account);
+    }
+
+    bool CachedWsvCommand::setAccountKV(const std::string &account_id,
+                                        const std::string &creator_account_id,
+                                        const std::string &key,
+                                        const std::string &val) {
+      written_->accounts.insert(account_id);
+      return command_->setAccountKV(account_id, creator_account_id, key, val);
+    }
+
+    bool CachedWsvCommand::insertAsset(const model::Asset &asset) {
+      return command_->insertAsset(asset);
+    }
+
+    bool CachedWsvCommand::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      return command_->upsertAccountAsset(asset);
+    }
+
+    bool CachedWsvCommand::insertSignatory(const pubkey_t &signatory) {
+      return command_->insertSignatory(signatory);
+    }
+
+    bool CachedWsvCommand::insertAccountSignatory(const std::string &account_id,
+                                                  const pubkey_t &signatory) {
+      written_->signatories.insert(account_id);
+      return command_->insertAccountSignatory(account_id, signatory);
+    }
+
+    bool CachedWsvCommand::deleteAccountSignatory(const std::string &account_id,
+                                                  const pubkey_t &signatory) {
+      written_->signatories.insert(account_id);
+      return command_->deleteAccountSignatory(account_id, signatory);
+    }
+
+    bool CachedWsvCommand::deleteSignatory(const pubkey_t &signatory) {
+      return command_->deleteSignatory(signatory);
+    }
+
+    bool CachedWsvCommand::insertPeer(const model::Peer &peer) {
+      return command_->insertPeer(peer);
+    }
+
+    bool CachedWsvCommand::deletePeer(const model::Peer &peer) {
+      return command_->deletePeer(peer);
+    }
+
+    bool CachedWsvCommand::insertDomain(const model::Domain &domain) {
+      return command_->insertDomain(domain);
+    }
+
+    bool CachedWsvCommand::insertAccountGrantablePermission(
+        const std::string &permittee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      return command_->insertAccountGrantablePermission(
+          permittee_account_id, account_id, permission_id);
+    }
+
+    bool CachedWsvCommand::deleteAccountGrantablePermission(
+        const std::string &permittee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      return command_->deleteAccountGrantablePermission(
+          permittee_account_id, account_id, permission_id);
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
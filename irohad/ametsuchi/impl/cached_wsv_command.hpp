@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CACHED_WSV_COMMAND_HPP
+#define IROHA_CACHED_WSV_COMMAND_HPP
+
+#include "ametsuchi/wsv_command.hpp"
+
+#include <memory>
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Command which records keys of cached entities it writes, so that
+     * CachedWsvQuery of the same transaction bypasses the cache for them,
+     * and the cache is invalidated when the transaction is committed.
+     * Keys are never forgotten on rollback to savepoint: reading such an
+     * entity from the database is merely slower, never wrong.
+     */
+    class CachedWsvCommand : public WsvCommand {
+     public:
+      /**
+       * @param command - command to the database
+       * @param written - keys written in the transaction of command
+       */
+      CachedWsvCommand(std::unique_ptr<WsvCommand> command,
+                       std::shared_ptr<WsvCache::Keys> written);
+
+      bool insertRole(const std::string &role_name) override;
+
+      bool insertAccountRole(const std::string &account_id,
+                             const std::string &role_name) override;
+      bool deleteAccountRole(const std::string &account_id,
+                             const std::string &role_name) override;
+
+      bool insertRolePermissions(
+          const std::string &role_id,
+          const std::set<std::string> &permissions) override;
+
+      bool insertAccount(const model::Account &account) override;
+      bool updateAccount(const model::Account &account) override;
+      bool setAccountKV(const std::string &account_id,
+                        const std::string &creator_account_id,
+                        const std::string &key,
+                        const std::string &val) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool insertSignatory(const pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const pubkey_t &signatory) override;
+      bool deleteSignatory(const pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+      bool insertAccountGrantablePermission(
+          const std::string &permittee_account_id,
+          const std::string &account_id,
+          const std::string &permission_id) override;
+
+      bool deleteAccountGrantablePermission(
+          const std::string &permittee_account_id,
+          const std::string &account_id,
+          const std::string &permission_id) override;
+
+     private:
+      std::unique_ptr<WsvCommand> command_;
+      std::shared_ptr<WsvCache::Keys> written_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_CACHED_WSV_COMMAND_HPP
@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    CachedWsvQuery::CachedWsvQuery(
+        std::unique_ptr<WsvQuery> wsv,
+        std::shared_ptr<WsvCache> cache,
+        std::shared_ptr<const WsvCache::Keys> written)
+        : wsv_(std::move(wsv)),
+          cache_(std::move(cache)),
+          written_(std::move(written)) {}
+
+    nonstd::optional<std::vector<std::string>> CachedWsvQuery::getAccountRoles(
+        const std::string &account_id) {
+      if (written_->account_roles.count(account_id) != 0) {
+        return wsv_->getAccountRoles(account_id);
+      }
+      if (auto cached = cache_->getAccountRoles(account_id)) {
+        return cached;
+      }
+      auto generation = cache_->generation();
+      auto roles = wsv_->getAccountRoles(account_id);
+      if (roles) {
+        cache_->putAccountRoles(account_id, *roles, generation);
+      }
+      return roles;
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    CachedWsvQuery::getRolePermissions(const std::string &role_name) {
+      if (written_->role_permissions.count(role_name) != 0) {
+        return wsv_->getRolePermissions(role_name);
+      }
+      if (auto cached = cache_->getRolePermissions(role_name)) {
+        return cached;
+      }
+      auto generation = cache_->generation();
+      auto permissions = wsv_->getRolePermissions(role_name);
+      if (permissions) {
+        cache_->putRolePermissions(role_name, *permissions, generation);
+      }
+      return permissions;
+    }
+
+    nonstd::optional<model::PermissionSet>
+    CachedWsvQuery::getAccountPermissions(const std::string &account_id) {
+      // permission set depends on roles of account and on every role
+      if (written_->account_roles.count(account_id) != 0
+          or not written_->role_permissions.empty()) {
+        return wsv_->getAccountPermissions(account_id);
+      }
+      if (auto cached = cache_->getAccountPermissions(account_id)) {
+        return cached;
+      }
+      auto generation = cache_->generation();
+      auto permissions = wsv_->getAccountPermissions(account_id);
+      if (permissions) {
+        cache_->putAccountPermissions(account_id, *permissions, generation);
+      }
+      return permissions;
+    }
+
+    nonstd::optional<model::Account> CachedWsvQuery::getAccount(
+        const std::string &account_id) {
+      if (written_->accounts.count(account_id) != 0) {
+        return wsv_->getAccount(account_id);
+      }
+      if (auto cached = cache_->getAccount(account_id)) {
+        return cached;
+      }
+      auto generation = cache_->generation();
+      auto account = wsv_->getAccount(account_id);
+      if (account) {
+        cache_->putAccount(*account, generation);
+      }
+      return account;
+    }
+
+    nonstd::optional<std::string> CachedWsvQuery::getAccountDetail(
+        const std::string &account_id,
+        const std::string &creator_account_id,
+        const std::string &detail) {
+      return wsv_->getAccountDetail(account_id, creator_account_id, detail);
+    }
+
+    nonstd::optional<std::vector<pubkey_t>> CachedWsvQuery::getSignatories(
+        const std::string &account_id) {
+      if (written_->signatories.count(account_id) != 0) {
+        return wsv_->getSignatories(account_id);
+      }
+      if (auto cached = cache_->getSignatories(account_id)) {
+        return cached;
+      }
+      auto generation = cache_->generation();
+      auto signatories = wsv_->getSignatories(account_id);
+      if (signatories) {
+        cache_->putSignatories(account_id, *signatories, generation);
+      }
+      return signatories;
+    }
+
+    nonstd::optional<model::Asset> CachedWsvQuery::getAsset(
+        const std::string &asset_id) {
+      return wsv_->getAsset(asset_id);
+    }
+
+    nonstd::optional<model::AccountAsset> CachedWsvQuery::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      return wsv_->getAccountAsset(account_id, asset_id);
+    }
+
+    nonstd::optional<std::vector<model::Peer>> CachedWsvQuery::getPeers() {
+      return wsv_->getPeers();
+    }
+
+    nonstd::optional<std::vector<std::string>> CachedWsvQuery::getRoles() {
+      return wsv_->getRoles();
+    }
+
+    nonstd::optional<model::Domain> CachedWsvQuery::getDomain(
+        const std::string &domain_id) {
+      return wsv_->getDomain(domain_id);
+    }
+
+    bool CachedWsvQuery::hasAccountGrantablePermission(
+        const std::string &permitee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      return wsv_->hasAccountGrantablePermission(
+          permitee_account_id, account_id, permission_id);
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
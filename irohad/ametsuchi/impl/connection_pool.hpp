@@ -0,0 +1,183 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CONNECTION_POOL_HPP
+#define IROHA_CONNECTION_POOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Connection, which is returned to its pool on destruction
+     */
+    template <typename Connection>
+    using PooledConnection =
+        std::unique_ptr<Connection, std::function<void(Connection *)>>;
+
+    /**
+     * Bounded pool of reusable connections to a database.
+     * Connections are created on demand, checked before they are given out
+     * and reset when they are returned; broken ones are dropped.
+     * Safe to use from multiple threads.
+     * @tparam Connection - type of connection
+     */
+    template <typename Connection>
+    class ConnectionPool
+        : public std::enable_shared_from_this<ConnectionPool<Connection>> {
+     public:
+      /// open new connection, nullptr on failure
+      using Factory = std::function<std::unique_ptr<Connection>()>;
+      /// check connection, false if it is broken
+      using Check = std::function<bool(Connection &)>;
+
+      /**
+       * @param factory - opens new connections
+       * @param health_check - cheap check of idle connection before it is
+       * given out
+       * @param reset - restores state of returned connection, so that next
+       * user does not see changes of the previous one
+       * @param capacity - maximal number of open connections
+       * @param timeout - maximal time of waiting for a connection, when all
+       * of them are in use
+       * @return pool
+       */
+      static std::shared_ptr<ConnectionPool> create(
+          Factory factory,
+          Check health_check,
+          Check reset,
+          size_t capacity,
+          std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        return std::shared_ptr<ConnectionPool>(
+            new ConnectionPool(std::move(factory),
+                               std::move(health_check),
+                               std::move(reset),
+                               capacity,
+                               timeout));
+      }
+
+      /**
+       * Take idle connection, or open a new one if there is none
+       * @return connection or nullptr, if it cannot be opened or all
+       * connections are in use for longer than timeout
+       */
+      PooledConnection<Connection> acquire() {
+        std::unique_ptr<Connection> connection;
+        {
+          std::unique_lock<std::mutex> lock(lock_);
+          if (not available_.wait_for(lock, timeout_, [this] {
+                return in_use_ < capacity_;
+              })) {
+            return nullptr;
+          }
+          ++in_use_;
+          if (not idle_.empty()) {
+            connection = std::move(idle_.back());
+            idle_.pop_back();
+          }
+        }
+
+        if (connection and not health_check_(*connection)) {
+          connection.reset();
+        }
+        if (not connection) {
+          connection = factory_();
+        }
+        if (not connection) {
+          std::lock_guard<std::mutex> lock(lock_);
+          --in_use_;
+          available_.notify_one();
+          return nullptr;
+        }
+
+        std::weak_ptr<ConnectionPool> pool = this->shared_from_this();
+        return PooledConnection<Connection>(
+            connection.release(), [pool](Connection *connection) {
+              std::unique_ptr<Connection> owned(connection);
+              if (auto alive = pool.lock()) {
+                alive->release(std::move(owned));
+              }
+            });
+      }
+
+      /**
+       * @return number of connections which are open and not in use
+       */
+      size_t idle() const {
+        std::lock_guard<std::mutex> lock(lock_);
+        return idle_.size();
+      }
+
+      /**
+       * @return number of connections which are in use
+       */
+      size_t inUse() const {
+        std::lock_guard<std::mutex> lock(lock_);
+        return in_use_;
+      }
+
+     private:
+      ConnectionPool(Factory factory,
+                     Check health_check,
+                     Check reset,
+                     size_t capacity,
+                     std::chrono::milliseconds timeout)
+          : factory_(std::move(factory)),
+            health_check_(std::move(health_check)),
+            reset_(std::move(reset)),
+            capacity_(capacity),
+            timeout_(timeout),
+            in_use_(0) {}
+
+      /**
+       * Reset connection and make it available for reuse
+       * @param connection - connection returned by user
+       */
+      void release(std::unique_ptr<Connection> connection) {
+        if (not reset_(*connection)) {
+          connection.reset();
+        }
+        std::lock_guard<std::mutex> lock(lock_);
+        if (connection) {
+          idle_.push_back(std::move(connection));
+        }
+        --in_use_;
+        available_.notify_one();
+      }
+
+      const Factory factory_;
+      const Check health_check_;
+      const Check reset_;
+      const size_t capacity_;
+      const std::chrono::milliseconds timeout_;
+
+      std::vector<std::unique_ptr<Connection>> idle_;
+      size_t in_use_;
+
+      mutable std::mutex lock_;
+      std::condition_variable available_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_CONNECTION_POOL_HPP
@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_block_index.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    EmbeddedBlockIndex::EmbeddedBlockIndex(EmbeddedIndex &index)
+        : index_(index), log_(logger::log("EmbeddedBlockIndex")) {}
+
+    void EmbeddedBlockIndex::index(const model::Block &block) {
+      pending_.emplace_back(block.height, EmbeddedIndex::encode(block));
+    }
+
+    void EmbeddedBlockIndex::commit() {
+      for (const auto &block : pending_) {
+        // later blocks are not indexed, so that index has no gaps and is
+        // completed from block store on restart
+        if (not index_.add(block.first, block.second)) {
+          log_->error("Cannot index block {}", block.first);
+          break;
+        }
+      }
+      pending_.clear();
+    }
+
+    void EmbeddedBlockIndex::discard() {
+      pending_.clear();
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
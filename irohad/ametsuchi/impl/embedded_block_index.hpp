@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EMBEDDED_BLOCK_INDEX_HPP
+#define IROHA_EMBEDDED_BLOCK_INDEX_HPP
+
+#include "ametsuchi/impl/block_index.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "ametsuchi/impl/embedded_index/embedded_index.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+    /**
+     * Class which implements BlockIndex with an embedded backend.
+     * Entries of indexed blocks are buffered until commit
+     */
+    class EmbeddedBlockIndex : public BlockIndex {
+     public:
+      explicit EmbeddedBlockIndex(EmbeddedIndex &index);
+
+      void index(const model::Block &block) override;
+
+      void commit() override;
+
+      void discard() override;
+
+     private:
+      EmbeddedIndex &index_;
+      std::vector<std::pair<model::Block::BlockHeightType,
+                            std::vector<uint8_t>>>
+          pending_;
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_EMBEDDED_BLOCK_INDEX_HPP
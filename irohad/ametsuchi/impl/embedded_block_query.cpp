@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_block_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    EmbeddedBlockQuery::EmbeddedBlockQuery(
+        const EmbeddedIndex &index,
+        KeyValueStorage &file_store,
+        std::shared_ptr<BlockCache> block_cache)
+        : BlockStoreQuery(file_store, std::move(block_cache)), index_(index) {}
+
+    boost::optional<EmbeddedBlockQuery::TxPosition>
+    EmbeddedBlockQuery::getTxPosition(const std::string &hash) {
+      auto position = index_.getTxPosition(hash);
+      if (not position) {
+        return boost::none;
+      }
+      return TxPosition{position->height, position->index};
+    }
+
+    boost::optional<model::Block::BlockHeightType>
+    EmbeddedBlockQuery::getBlockHeight(const std::string &hash) {
+      auto height = index_.getBlockHeight(hash);
+      if (not height) {
+        return boost::none;
+      }
+      return *height;
+    }
+
+    void EmbeddedBlockQuery::emitTransactions(
+        const rxcpp::subscriber<model::Transaction> &s,
+        model::Block::BlockHeightType block_id,
+        const std::vector<size_t> &tx_indexes) {
+      if (tx_indexes.empty()) {
+        return;
+      }
+      auto block = getBlock(block_id);
+      if (not block) {
+        return;
+      }
+      for (auto tx_id : tx_indexes) {
+        s.on_next(block->transactions.at(tx_id));
+      }
+    }
+
+    rxcpp::observable<model::Transaction>
+    EmbeddedBlockQuery::getAccountTransactions(const std::string &account_id) {
+      return rxcpp::observable<>::create<model::Transaction>(
+          [this, account_id](auto subscriber) {
+            for (auto block_id : index_.getBlockIds(account_id)) {
+              this->emitTransactions(
+                  subscriber,
+                  block_id,
+                  index_.getTxIndexes(account_id, block_id));
+            }
+            subscriber.on_completed();
+          });
+    }
+
+    rxcpp::observable<model::Transaction>
+    EmbeddedBlockQuery::getAccountAssetTransactions(
+        const std::string &account_id, const std::string &asset_id) {
+      return rxcpp::observable<>::create<model::Transaction>(
+          [this, account_id, asset_id](auto subscriber) {
+            for (auto block_id : index_.getBlockIds(account_id)) {
+              this->emitTransactions(
+                  subscriber,
+                  block_id,
+                  index_.getTxIndexes(account_id, block_id, asset_id));
+            }
+            subscriber.on_completed();
+          });
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,65 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EMBEDDED_BLOCK_QUERY_HPP
+#define IROHA_EMBEDDED_BLOCK_QUERY_HPP
+
+#include "ametsuchi/impl/block_store_query.hpp"
+#include "ametsuchi/impl/embedded_index/embedded_index.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+    /**
+     * Class which implements BlockQuery with an embedded backend.
+     */
+    class EmbeddedBlockQuery : public BlockStoreQuery {
+     public:
+      EmbeddedBlockQuery(const EmbeddedIndex &index,
+                         KeyValueStorage &file_store,
+                         std::shared_ptr<BlockCache> block_cache =
+                             std::make_shared<BlockCache>());
+
+      rxcpp::observable<model::Transaction> getAccountTransactions(
+          const std::string &account_id) override;
+
+      rxcpp::observable<model::Transaction> getAccountAssetTransactions(
+          const std::string &account_id, const std::string &asset_id) override;
+
+     protected:
+      boost::optional<TxPosition> getTxPosition(
+          const std::string &hash) override;
+
+      boost::optional<model::Block::BlockHeightType> getBlockHeight(
+          const std::string &hash) override;
+
+     private:
+      /**
+       * Emit transactions of the block with given indexes
+       * @param s - subscriber to supply transactions to
+       * @param block_id - height of the block
+       * @param tx_indexes - indexes of transactions in the block
+       */
+      void emitTransactions(const rxcpp::subscriber<model::Transaction> &s,
+                            model::Block::BlockHeightType block_id,
+                            const std::vector<size_t> &tx_indexes);
+
+      const EmbeddedIndex &index_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_EMBEDDED_BLOCK_QUERY_HPP
@@ -0,0 +1,279 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_index/embedded_index.hpp"
+
+#include <set>
+
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
+#include "model/commands/transfer_asset.hpp"
+
+using namespace iroha::ametsuchi;
+
+const std::string EmbeddedIndex::JOURNAL_DIR = "index";
+
+namespace {
+  /**
+   * Index entries of one transaction
+   */
+  struct TxEntry {
+    std::string hash;
+    std::string creator;
+    /// accounts and assets of transfers, without duplicates
+    std::vector<std::pair<std::string, std::string>> account_assets;
+  };
+
+  // entries are little-endian integers and length-prefixed strings
+
+  void put32(std::vector<uint8_t> &dst, uint32_t value) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      dst.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+
+  void putString(std::vector<uint8_t> &dst, const std::string &value) {
+    put32(dst, value.size());
+    dst.insert(dst.end(), value.begin(), value.end());
+  }
+
+  /**
+   * Bounds-checked reader of serialized entries
+   */
+  class Reader {
+   public:
+    Reader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    bool get32(uint32_t &value) {
+      if (size_ < sizeof(value)) {
+        return false;
+      }
+      value = 0;
+      for (size_t i = 0; i < sizeof(value); ++i) {
+        value |= static_cast<uint32_t>(data_[i]) << (8 * i);
+      }
+      data_ += sizeof(value);
+      size_ -= sizeof(value);
+      return true;
+    }
+
+    bool getString(std::string &value) {
+      uint32_t length;
+      if (not get32(length) or size_ < length) {
+        return false;
+      }
+      value.assign(data_, data_ + length);
+      data_ += length;
+      size_ -= length;
+      return true;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+   private:
+    const uint8_t *data_;
+    size_t size_;
+  };
+}  // namespace
+
+std::unique_ptr<EmbeddedIndex> EmbeddedIndex::create(const std::string &path) {
+  auto log = logger::log("EmbeddedIndex");
+  auto journal = SegmentedFile::create(path);
+  if (not journal) {
+    log->error("Cannot open index journal in {}", path);
+    return nullptr;
+  }
+
+  std::unique_ptr<EmbeddedIndex> index(new EmbeddedIndex(std::move(journal)));
+  const auto last_id = index->journal_->last_id();
+  for (Identifier id = 1; id <= last_id; ++id) {
+    auto entries = index->journal_->view(id);
+    if (not entries or not index->apply(id, entries->data(), entries->size())) {
+      log->error("Index journal is corrupted at block {}", id);
+      return nullptr;
+    }
+  }
+  log->info("Index of {} blocks is loaded", last_id);
+  return index;
+}
+
+std::vector<uint8_t> EmbeddedIndex::encode(const model::Block &block) {
+  std::vector<uint8_t> entries;
+  putString(entries, block.hash.to_string());
+  put32(entries, block.transactions.size());
+  for (const auto &tx : block.transactions) {
+    putString(entries, iroha::hash(tx).to_string());
+    putString(entries, tx.creator_account_id);
+
+    std::set<std::pair<std::string, std::string>> account_assets;
+    for (const auto &command : tx.commands) {
+      auto transfer = std::dynamic_pointer_cast<model::TransferAsset>(command);
+      if (not transfer) {
+        continue;
+      }
+      for (const auto &id : {tx.creator_account_id,
+                             transfer->src_account_id,
+                             transfer->dest_account_id}) {
+        account_assets.emplace(id, transfer->asset_id);
+      }
+    }
+    put32(entries, account_assets.size());
+    for (const auto &account_asset : account_assets) {
+      putString(entries, account_asset.first);
+      putString(entries, account_asset.second);
+    }
+  }
+  return entries;
+}
+
+bool EmbeddedIndex::add(HeightType height,
+                        const std::vector<uint8_t> &entries) {
+  std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+  if (not journal_->add(height, entries)) {
+    log_->error("Block {} cannot be written to index journal", height);
+    return false;
+  }
+  return apply(height, entries.data(), entries.size());
+}
+
+EmbeddedIndex::HeightType EmbeddedIndex::lastHeight() const {
+  return journal_->last_id();
+}
+
+nonstd::optional<EmbeddedIndex::TxPosition> EmbeddedIndex::getTxPosition(
+    const std::string &hash) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  auto it = tx_positions_.find(hash);
+  if (it == tx_positions_.end()) {
+    return nonstd::nullopt;
+  }
+  return it->second;
+}
+
+nonstd::optional<EmbeddedIndex::HeightType> EmbeddedIndex::getBlockHeight(
+    const std::string &hash) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  auto it = block_heights_.find(hash);
+  if (it == block_heights_.end()) {
+    return nonstd::nullopt;
+  }
+  return it->second;
+}
+
+std::vector<EmbeddedIndex::HeightType> EmbeddedIndex::getBlockIds(
+    const std::string &account_id) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  auto it = account_blocks_.find(account_id);
+  if (it == account_blocks_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::vector<size_t> EmbeddedIndex::getTxIndexes(const std::string &account_id,
+                                                HeightType height) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  auto it = account_txs_.find(std::make_pair(account_id, height));
+  if (it == account_txs_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::vector<size_t> EmbeddedIndex::getTxIndexes(
+    const std::string &account_id,
+    HeightType height,
+    const std::string &asset_id) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  auto it =
+      account_asset_txs_.find(std::make_tuple(account_id, height, asset_id));
+  if (it == account_asset_txs_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+void EmbeddedIndex::dropAll() {
+  std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+  journal_->dropAll();
+  block_heights_.clear();
+  tx_positions_.clear();
+  account_blocks_.clear();
+  account_txs_.clear();
+  account_asset_txs_.clear();
+}
+
+// ----------| private API |----------
+
+EmbeddedIndex::EmbeddedIndex(std::unique_ptr<KeyValueStorage> journal)
+    : journal_(std::move(journal)), log_(logger::log("EmbeddedIndex")) {}
+
+bool EmbeddedIndex::apply(HeightType height,
+                          const uint8_t *data,
+                          size_t size) {
+  // parse everything first, so that malformed entries are not applied
+  Reader reader(data, size);
+  std::string block_hash;
+  uint32_t tx_count;
+  if (not reader.getString(block_hash) or not reader.get32(tx_count)) {
+    return false;
+  }
+  std::vector<TxEntry> txs;
+  for (uint32_t i = 0; i < tx_count; ++i) {
+    TxEntry tx;
+    uint32_t assets_count;
+    if (not reader.getString(tx.hash) or not reader.getString(tx.creator)
+        or not reader.get32(assets_count)) {
+      return false;
+    }
+    for (uint32_t j = 0; j < assets_count; ++j) {
+      std::pair<std::string, std::string> account_asset;
+      if (not reader.getString(account_asset.first)
+          or not reader.getString(account_asset.second)) {
+        return false;
+      }
+      tx.account_assets.push_back(std::move(account_asset));
+    }
+    txs.push_back(std::move(tx));
+  }
+  if (not reader.empty()) {
+    return false;
+  }
+
+  block_heights_[block_hash] = height;
+  auto add_block = [this, height](const std::string &account_id) {
+    auto &heights = account_blocks_[account_id];
+    if (heights.empty() or heights.back() != height) {
+      heights.push_back(height);
+    }
+  };
+  for (size_t index = 0; index < txs.size(); ++index) {
+    const auto &tx = txs[index];
+    tx_positions_[tx.hash] = TxPosition{height, index};
+    add_block(tx.creator);
+    account_txs_[std::make_pair(tx.creator, height)].push_back(index);
+    for (const auto &account_asset : tx.account_assets) {
+      add_block(account_asset.first);
+      account_asset_txs_[std::make_tuple(
+                             account_asset.first, height, account_asset.second)]
+          .push_back(index);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,168 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EMBEDDED_INDEX_HPP
+#define IROHA_EMBEDDED_INDEX_HPP
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "ametsuchi/key_value_storage.hpp"
+#include "logger/logger.hpp"
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * In-process persistent index on blocks and transactions, alternative
+     * to Redis.
+     *
+     * Index entries of every block are appended to a journal, which is a
+     * segmented block log keyed by block height, and applied to in-memory
+     * tables. On start the tables are rebuilt from the journal, so lookups
+     * never touch disk and do not require an external service.
+     * The index keeps the same relations as RedisBlockIndex:
+     *  - block hash -> block height;
+     *  - tx hash -> block height and index of tx in the block;
+     *  - account id -> heights of blocks with its txs;
+     *  - account id, height -> indexes of txs created by the account;
+     *  - account id, height, asset id -> indexes of txs transferring the
+     *    asset, where the account is creator, source or destination.
+     */
+    class EmbeddedIndex {
+     public:
+      using HeightType = model::Block::BlockHeightType;
+
+      /**
+       * Location of transaction in block store
+       */
+      struct TxPosition {
+        HeightType height;
+        size_t index;
+      };
+
+      /**
+       * Name of the journal folder inside of block store folder
+       */
+      static const std::string JOURNAL_DIR;
+
+      /**
+       * Open index in path, replaying the journal
+       * @param path - folder of the journal
+       * @return index, nullptr if journal cannot be opened or is corrupted
+       */
+      static std::unique_ptr<EmbeddedIndex> create(const std::string &path);
+
+      /**
+       * Collect index entries of the block
+       * @param block - block to be indexed
+       * @return serialized entries to be passed to add
+       */
+      static std::vector<uint8_t> encode(const model::Block &block);
+
+      /**
+       * Persist and apply entries of the next block
+       * @param height - height of the block, must follow the last indexed one
+       * @param entries - result of encode
+       * @return true if the block is indexed
+       */
+      bool add(HeightType height, const std::vector<uint8_t> &entries);
+
+      /**
+       * @return height of the last indexed block, 0 if index is empty
+       */
+      HeightType lastHeight() const;
+
+      /**
+       * @param hash - hash of transaction
+       * @return position of transaction, if it is indexed
+       */
+      nonstd::optional<TxPosition> getTxPosition(const std::string &hash) const;
+
+      /**
+       * @param hash - hash of block
+       * @return height of the block, if it is indexed
+       */
+      nonstd::optional<HeightType> getBlockHeight(const std::string &hash) const;
+
+      /**
+       * @param account_id - account id
+       * @return heights of blocks with transactions of the account
+       */
+      std::vector<HeightType> getBlockIds(const std::string &account_id) const;
+
+      /**
+       * @param account_id - creator of transactions
+       * @param height - height of the block
+       * @return indexes of transactions created by the account in the block
+       */
+      std::vector<size_t> getTxIndexes(const std::string &account_id,
+                                       HeightType height) const;
+
+      /**
+       * @param account_id - creator, source or destination of transfers
+       * @param height - height of the block
+       * @param asset_id - transferred asset
+       * @return indexes of transactions in the block, which transfer the
+       * asset on behalf of, from or to the account
+       */
+      std::vector<size_t> getTxIndexes(const std::string &account_id,
+                                       HeightType height,
+                                       const std::string &asset_id) const;
+
+      /**
+       * Remove all entries from the index and its journal
+       */
+      void dropAll();
+
+     private:
+      explicit EmbeddedIndex(std::unique_ptr<KeyValueStorage> journal);
+
+      /**
+       * Apply serialized entries of block to in-memory tables
+       * @return false if entries are malformed
+       */
+      bool apply(HeightType height, const uint8_t *data, size_t size);
+
+      std::unique_ptr<KeyValueStorage> journal_;
+
+      std::unordered_map<std::string, HeightType> block_heights_;
+      std::unordered_map<std::string, TxPosition> tx_positions_;
+      std::unordered_map<std::string, std::vector<HeightType>> account_blocks_;
+      std::map<std::pair<std::string, HeightType>, std::vector<size_t>>
+          account_txs_;
+      std::map<std::tuple<std::string, HeightType, std::string>,
+               std::vector<size_t>>
+          account_asset_txs_;
+
+      // Allows multiple readers and a single writer
+      mutable std::shared_timed_mutex rw_lock_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_EMBEDDED_INDEX_HPP
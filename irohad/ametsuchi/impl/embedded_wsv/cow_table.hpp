@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_COW_TABLE_HPP
+#define IROHA_COW_TABLE_HPP
+
+#include <array>
+#include <map>
+#include <memory>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Ordered key-value table, which is split into shards by key hash.
+     * Copies of the table share shards until a shard is written, so a copy
+     * is cheap, and a write copies a single shard at most.
+     * Shards shared with other copies are never modified, thus a copy
+     * which is only read can be used from any thread.
+     * @tparam Key - ordered key
+     * @tparam Value - stored value
+     * @tparam Hash - hash of the key, which selects the shard
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class CowTable {
+     public:
+      static constexpr size_t SHARDS = 64;
+
+      CowTable() {
+        for (auto &shard : shards_) {
+          shard = std::make_shared<Shard>();
+        }
+      }
+
+      /**
+       * @return value of key, nullptr if it is absent
+       */
+      const Value *find(const Key &key) const {
+        const auto &shard = *shards_[index(key)];
+        auto it = shard.find(key);
+        return it == shard.end() ? nullptr : &it->second;
+      }
+
+      /**
+       * Insert value, or replace existing one
+       */
+      void put(const Key &key, Value value) {
+        writable(key)[key] = std::move(value);
+      }
+
+      /**
+       * Erase value of key if it is present
+       */
+      void erase(const Key &key) {
+        if (find(key) != nullptr) {
+          writable(key).erase(key);
+        }
+      }
+
+      /**
+       * Visit all entries, ordered by key within each shard
+       * @param visitor - callable with key and value
+       */
+      template <typename Visitor>
+      void forEach(Visitor &&visitor) const {
+        for (const auto &shard : shards_) {
+          for (const auto &entry : *shard) {
+            visitor(entry.first, entry.second);
+          }
+        }
+      }
+
+     private:
+      using Shard = std::map<Key, Value>;
+
+      size_t index(const Key &key) const {
+        return Hash()(key) % SHARDS;
+      }
+
+      /**
+       * Shard of key, which is copied first if other tables share it
+       */
+      Shard &writable(const Key &key) {
+        auto &shard = shards_[index(key)];
+        if (shard.use_count() > 1) {
+          shard = std::make_shared<Shard>(*shard);
+        }
+        return *shard;
+      }
+
+      std::array<std::shared_ptr<Shard>, SHARDS> shards_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_COW_TABLE_HPP
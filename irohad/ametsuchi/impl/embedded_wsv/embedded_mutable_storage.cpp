@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_wsv/embedded_mutable_storage.hpp"
+
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_command.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+    EmbeddedMutableStorage::EmbeddedMutableStorage(
+        hash256_t top_hash,
+        std::unique_ptr<BlockIndex> block_index,
+        std::shared_ptr<const EmbeddedWsvState> state,
+        std::shared_ptr<model::CommandExecutorFactory> command_executors)
+        : top_hash_(top_hash),
+          committed_state_(state),
+          committed_(std::move(state)),
+          overlay_(committed_),
+          block_index_(std::move(block_index)),
+          command_executors_(std::move(command_executors)),
+          committed(false) {}
+
+    bool EmbeddedMutableStorage::apply(
+        const model::Block &block,
+        std::function<bool(const model::Block &, WsvQuery &, const hash256_t &)>
+            function) {
+      auto execute_transaction = [this](auto &transaction) {
+        auto execute_command = [this, &transaction](auto command) {
+          return command_executors_->getCommandExecutor(command)->execute(
+              *command, overlay_, overlay_, transaction.creator_account_id);
+        };
+        return std::all_of(transaction.commands.begin(),
+                           transaction.commands.end(),
+                           execute_command);
+      };
+
+      auto result = function(block, overlay_, top_hash_)
+          and std::all_of(block.transactions.begin(),
+                          block.transactions.end(),
+                          execute_transaction);
+
+      if (result) {
+        block_store_.insert(std::make_pair(block.height, block));
+        if (block_index_) {
+          block_index_->index(block);
+        }
+
+        top_hash_ = block.hash;
+        overlay_.release();
+      } else {
+        overlay_.rollback();
+      }
+      return result;
+    }
+
+    std::shared_ptr<const EmbeddedWsvState> EmbeddedMutableStorage::state() {
+      auto state = std::make_shared<EmbeddedWsvState>(*committed_state_);
+      EmbeddedWsvCommand command(*state);
+      if (not overlay_.flush(command)) {
+        return nullptr;
+      }
+      return state;
+    }
+
+    EmbeddedMutableStorage::~EmbeddedMutableStorage() {
+      if (not committed and block_index_) {
+        block_index_->discard();
+      }
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
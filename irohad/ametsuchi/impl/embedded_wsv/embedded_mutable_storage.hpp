@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EMBEDDED_MUTABLE_STORAGE_HPP
+#define IROHA_EMBEDDED_MUTABLE_STORAGE_HPP
+
+#include "ametsuchi/mutable_storage.hpp"
+
+#include <map>
+
+#include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_query.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
+#include "model/execution/command_executor_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Mutable storage, which keeps changes of applied blocks in memory on
+     * top of snapshot of embedded world state view
+     */
+    class EmbeddedMutableStorage : public MutableStorage {
+      friend class StorageImpl;
+
+     public:
+      /**
+       * @param top_hash - hash of last committed block
+       * @param block_index - index of applied blocks, nullptr if blocks are
+       * already indexed, e.g. when state is restored from block store
+       * @param state - snapshot of committed state
+       * @param command_executors - executors of block commands
+       */
+      EmbeddedMutableStorage(
+          hash256_t top_hash,
+          std::unique_ptr<BlockIndex> block_index,
+          std::shared_ptr<const EmbeddedWsvState> state,
+          std::shared_ptr<model::CommandExecutorFactory> command_executors);
+
+      bool apply(const model::Block &block,
+                 std::function<bool(const model::Block &,
+                                    WsvQuery &, const hash256_t &)>
+                 function) override;
+
+      /**
+       * Build new state from committed snapshot and applied blocks
+       * @return state, nullptr if changes cannot be written
+       */
+      std::shared_ptr<const EmbeddedWsvState> state();
+
+      ~EmbeddedMutableStorage() override;
+
+     private:
+      hash256_t top_hash_;
+      // ordered collection is used to enforce block insertion order in
+      // StorageImpl::commit
+      std::map<uint32_t, model::Block> block_store_;
+
+      std::shared_ptr<const EmbeddedWsvState> committed_state_;
+      EmbeddedWsvQuery committed_;
+      WsvOverlay overlay_;
+      std::unique_ptr<BlockIndex> block_index_;
+      std::shared_ptr<model::CommandExecutorFactory> command_executors_;
+
+      bool committed;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_EMBEDDED_MUTABLE_STORAGE_HPP
@@ -0,0 +1,52 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_wsv/embedded_temporary_wsv.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+    EmbeddedTemporaryWsv::EmbeddedTemporaryWsv(
+        std::shared_ptr<const EmbeddedWsvState> state,
+        std::shared_ptr<model::CommandExecutorFactory> command_executors)
+        : committed_(std::move(state)),
+          overlay_(committed_),
+          command_executors_(std::move(command_executors)) {}
+
+    bool EmbeddedTemporaryWsv::apply(
+        const model::Transaction &transaction,
+        std::function<bool(const model::Transaction &, WsvQuery &)>
+            apply_function) {
+      const auto &tx_creator = transaction.creator_account_id;
+      auto execute_command = [this, &tx_creator](auto command) {
+        auto executor = command_executors_->getCommandExecutor(command);
+        return executor->validate(*command, overlay_, tx_creator)
+            && executor->execute(*command, overlay_, overlay_, tx_creator);
+      };
+
+      auto result = apply_function(transaction, overlay_)
+          && std::all_of(transaction.commands.begin(),
+                         transaction.commands.end(),
+                         execute_command);
+      if (result) {
+        overlay_.release();
+      } else {
+        overlay_.rollback();
+      }
+      return result;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,51 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EMBEDDED_TEMPORARY_WSV_HPP
+#define IROHA_EMBEDDED_TEMPORARY_WSV_HPP
+
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_query.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
+#include "ametsuchi/temporary_wsv.hpp"
+#include "model/execution/command_executor_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Temporary world state view over snapshot of embedded storage
+     */
+    class EmbeddedTemporaryWsv : public TemporaryWsv {
+     public:
+      EmbeddedTemporaryWsv(
+          std::shared_ptr<const EmbeddedWsvState> state,
+          std::shared_ptr<model::CommandExecutorFactory> command_executors);
+
+      bool apply(const model::Transaction &transaction,
+                 std::function<bool(const model::Transaction &,
+                                    WsvQuery &)>
+                 function) override;
+
+     private:
+      EmbeddedWsvQuery committed_;
+      WsvOverlay overlay_;
+      std::shared_ptr<model::CommandExecutorFactory> command_executors_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_EMBEDDED_TEMPORARY_WSV_HPP
@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    std::shared_ptr<const EmbeddedWsvState> EmbeddedWsv::snapshot() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return state_;
+    }
+
+    void EmbeddedWsv::commit(std::shared_ptr<const EmbeddedWsvState> state) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      state_ = std::move(state);
+    }
+
+    void EmbeddedWsv::clear() {
+      commit(std::make_shared<EmbeddedWsvState>());
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
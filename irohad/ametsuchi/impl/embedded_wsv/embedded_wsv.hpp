@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_EMBEDDED_WSV_HPP
+#define IROHA_EMBEDDED_WSV_HPP
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ametsuchi/impl/embedded_wsv/cow_table.hpp"
+#include "model/account.hpp"
+#include "model/account_asset.hpp"
+#include "model/asset.hpp"
+#include "model/domain.hpp"
+#include "model/peer.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Hash of composite key by its first element, so that rows of one
+     * account are kept in one shard
+     */
+    struct FirstHash {
+      template <typename Pair>
+      size_t operator()(const Pair &key) const {
+        return std::hash<std::string>()(key.first);
+      }
+    };
+
+    /**
+     * Snapshot of world state view of embedded storage.
+     * Copies share unchanged shards of tables, see CowTable
+     */
+    struct EmbeddedWsvState {
+      /// role -> its permissions
+      CowTable<std::string, std::set<std::string>> roles;
+      CowTable<std::string, model::Domain> domains;
+      CowTable<std::string, model::Account> accounts;
+      /// account -> its roles in order of appending
+      CowTable<std::string, std::vector<std::string>> account_roles;
+      /// account -> its signatories in order of adding
+      CowTable<std::string, std::vector<pubkey_t>> account_signatories;
+      /// account -> creator -> key -> value
+      CowTable<std::string,
+               std::map<std::string, std::map<std::string, std::string>>>
+          account_details;
+      /// permittee -> account, permission
+      CowTable<std::string, std::set<std::pair<std::string, std::string>>>
+          grantable_permissions;
+      CowTable<std::string, model::Asset> assets;
+      /// account, asset -> balance
+      CowTable<std::pair<std::string, std::string>,
+               model::AccountAsset,
+               FirstHash>
+          account_assets;
+      /// peers in order of adding
+      std::shared_ptr<const std::vector<model::Peer>> peers =
+          std::make_shared<std::vector<model::Peer>>();
+    };
+
+    /**
+     * In-process world state view, alternative to PostgreSQL.
+     * Committed state is an immutable snapshot, which is replaced on commit,
+     * so readers never wait for writers.
+     * State is not persisted, it is restored by applying blocks of block
+     * store on start of the storage.
+     */
+    class EmbeddedWsv {
+     public:
+      /**
+       * @return last committed state
+       */
+      std::shared_ptr<const EmbeddedWsvState> snapshot() const;
+
+      /**
+       * Replace committed state
+       * @param state - state derived from last committed one
+       */
+      void commit(std::shared_ptr<const EmbeddedWsvState> state);
+
+      /**
+       * Drop all committed state
+       */
+      void clear();
+
+     private:
+      mutable std::mutex mutex_;
+      std::shared_ptr<const EmbeddedWsvState> state_ =
+          std::make_shared<EmbeddedWsvState>();
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_EMBEDDED_WSV_HPP
@@ -0,0 +1,233 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_command.hpp"
+
+#include <algorithm>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    EmbeddedWsvCommand::EmbeddedWsvCommand(EmbeddedWsvState &state)
+        : state_(state) {}
+
+    bool EmbeddedWsvCommand::insertRole(const std::string &role_name) {
+      if (state_.roles.find(role_name)) {
+        return false;
+      }
+      state_.roles.put(role_name, {});
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertAccountRole(const std::string &account_id,
+                                               const std::string &role_name) {
+      if (not state_.accounts.find(account_id)
+          or not state_.roles.find(role_name)) {
+        return false;
+      }
+      auto roles = state_.account_roles.find(account_id);
+      auto updated = roles ? *roles : std::vector<std::string>{};
+      if (std::find(updated.begin(), updated.end(), role_name)
+          != updated.end()) {
+        return false;
+      }
+      updated.push_back(role_name);
+      state_.account_roles.put(account_id, std::move(updated));
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::deleteAccountRole(const std::string &account_id,
+                                               const std::string &role_name) {
+      if (auto roles = state_.account_roles.find(account_id)) {
+        auto updated = *roles;
+        updated.erase(std::remove(updated.begin(), updated.end(), role_name),
+                      updated.end());
+        state_.account_roles.put(account_id, std::move(updated));
+      }
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertRolePermissions(
+        const std::string &role_id, const std::set<std::string> &permissions) {
+      auto current = state_.roles.find(role_id);
+      if (not current) {
+        return false;
+      }
+      auto updated = *current;
+      for (const auto &permission : permissions) {
+        if (not updated.insert(permission).second) {
+          return false;
+        }
+      }
+      state_.roles.put(role_id, std::move(updated));
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertAccountGrantablePermission(
+        const std::string &permittee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      if (not state_.accounts.find(permittee_account_id)
+          or not state_.accounts.find(account_id)) {
+        return false;
+      }
+      auto current = state_.grantable_permissions.find(permittee_account_id);
+      auto updated =
+          current ? *current : std::set<std::pair<std::string, std::string>>{};
+      if (not updated.emplace(account_id, permission_id).second) {
+        return false;
+      }
+      state_.grantable_permissions.put(permittee_account_id,
+                                       std::move(updated));
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::deleteAccountGrantablePermission(
+        const std::string &permittee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      if (auto current =
+              state_.grantable_permissions.find(permittee_account_id)) {
+        auto updated = *current;
+        updated.erase(std::make_pair(account_id, permission_id));
+        state_.grantable_permissions.put(permittee_account_id,
+                                         std::move(updated));
+      }
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertAccount(const model::Account &account) {
+      if (state_.accounts.find(account.account_id)
+          or not state_.domains.find(account.domain_id)) {
+        return false;
+      }
+      state_.accounts.put(account.account_id, account);
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::updateAccount(const model::Account &account) {
+      if (auto current = state_.accounts.find(account.account_id)) {
+        auto updated = *current;
+        updated.quorum = account.quorum;
+        state_.accounts.put(account.account_id, std::move(updated));
+      }
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::setAccountKV(
+        const std::string &account_id,
+        const std::string &creator_account_id,
+        const std::string &key,
+        const std::string &val) {
+      if (state_.accounts.find(account_id)) {
+        auto current = state_.account_details.find(account_id);
+        auto updated = current
+            ? *current
+            : std::map<std::string, std::map<std::string, std::string>>{};
+        updated[creator_account_id][key] = val;
+        state_.account_details.put(account_id, std::move(updated));
+      }
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertAsset(const model::Asset &asset) {
+      if (state_.assets.find(asset.asset_id)
+          or not state_.domains.find(asset.domain_id)) {
+        return false;
+      }
+      state_.assets.put(asset.asset_id, asset);
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      if (not state_.accounts.find(asset.account_id)
+          or not state_.assets.find(asset.asset_id)) {
+        return false;
+      }
+      state_.account_assets.put(std::make_pair(asset.account_id, asset.asset_id),
+                                asset);
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertSignatory(const pubkey_t &signatory) {
+      // signatories are kept with accounts only
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertAccountSignatory(
+        const std::string &account_id, const pubkey_t &signatory) {
+      if (not state_.accounts.find(account_id)) {
+        return false;
+      }
+      auto current = state_.account_signatories.find(account_id);
+      auto updated = current ? *current : std::vector<pubkey_t>{};
+      if (std::find(updated.begin(), updated.end(), signatory)
+          != updated.end()) {
+        return false;
+      }
+      updated.push_back(signatory);
+      state_.account_signatories.put(account_id, std::move(updated));
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::deleteAccountSignatory(
+        const std::string &account_id, const pubkey_t &signatory) {
+      if (auto current = state_.account_signatories.find(account_id)) {
+        auto updated = *current;
+        updated.erase(std::remove(updated.begin(), updated.end(), signatory),
+                      updated.end());
+        state_.account_signatories.put(account_id, std::move(updated));
+      }
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::deleteSignatory(const pubkey_t &signatory) {
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertPeer(const model::Peer &peer) {
+      const auto &peers = *state_.peers;
+      if (std::any_of(peers.begin(), peers.end(), [&peer](const auto &other) {
+            return other.pubkey == peer.pubkey or other.address == peer.address;
+          })) {
+        return false;
+      }
+      auto updated = std::make_shared<std::vector<model::Peer>>(peers);
+      updated->push_back(peer);
+      state_.peers = std::move(updated);
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::deletePeer(const model::Peer &peer) {
+      auto updated = std::make_shared<std::vector<model::Peer>>(*state_.peers);
+      updated->erase(std::remove(updated->begin(), updated->end(), peer),
+                     updated->end());
+      state_.peers = std::move(updated);
+      return true;
+    }
+
+    bool EmbeddedWsvCommand::insertDomain(const model::Domain &domain) {
+      if (state_.domains.find(domain.domain_id)
+          or not state_.roles.find(domain.default_role)) {
+        return false;
+      }
+      state_.domains.put(domain.domain_id, domain);
+      return true;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,199 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      /**
+       * Order of object keys in output of PostgreSQL jsonb: shorter keys
+       * first, then bytewise
+       */
+      struct JsonbKeyOrder {
+        bool operator()(const std::string *lhs, const std::string *rhs) const {
+          return lhs->size() != rhs->size() ? lhs->size() < rhs->size()
+                                            : *lhs < *rhs;
+        }
+      };
+
+      /**
+       * Render details of account like json data of PostgreSQL account
+       */
+      std::string renderDetails(
+          const std::map<std::string, std::map<std::string, std::string>>
+              &details) {
+        auto render = [](const auto &object, auto &&render_value) {
+          std::map<const std::string *,
+                   const typename std::decay_t<decltype(object)>::mapped_type *,
+                   JsonbKeyOrder>
+              ordered;
+          for (const auto &entry : object) {
+            ordered.emplace(&entry.first, &entry.second);
+          }
+          std::string json = "{";
+          for (const auto &entry : ordered) {
+            if (json.size() > 1) {
+              json += ", ";
+            }
+            json += "\"" + *entry.first + "\": " + render_value(*entry.second);
+          }
+          return json + "}";
+        };
+        return render(details, [&render](const auto &values) {
+          return render(values, [](const std::string &value) {
+            return "\"" + value + "\"";
+          });
+        });
+      }
+    }  // namespace
+
+    EmbeddedWsvQuery::EmbeddedWsvQuery(
+        std::shared_ptr<const EmbeddedWsvState> state)
+        : snapshot_([state = std::move(state)] { return state; }) {}
+
+    EmbeddedWsvQuery::EmbeddedWsvQuery(const EmbeddedWsv &wsv)
+        : snapshot_([&wsv] { return wsv.snapshot(); }) {}
+
+    nonstd::optional<std::vector<std::string>>
+    EmbeddedWsvQuery::getAccountRoles(const std::string &account_id) {
+      auto state = snapshot_();
+      auto roles = state->account_roles.find(account_id);
+      return roles ? *roles : std::vector<std::string>{};
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    EmbeddedWsvQuery::getRolePermissions(const std::string &role_name) {
+      auto state = snapshot_();
+      auto permissions = state->roles.find(role_name);
+      if (not permissions) {
+        return std::vector<std::string>{};
+      }
+      return std::vector<std::string>(permissions->begin(),
+                                      permissions->end());
+    }
+
+    nonstd::optional<model::PermissionSet>
+    EmbeddedWsvQuery::getAccountPermissions(const std::string &account_id) {
+      auto state = snapshot_();
+      model::PermissionSet permissions;
+      if (auto roles = state->account_roles.find(account_id)) {
+        for (const auto &role : *roles) {
+          if (auto role_permissions = state->roles.find(role)) {
+            permissions |= model::makePermissionSet(*role_permissions);
+          }
+        }
+      }
+      return permissions;
+    }
+
+    nonstd::optional<model::Account> EmbeddedWsvQuery::getAccount(
+        const std::string &account_id) {
+      auto state = snapshot_();
+      auto account = state->accounts.find(account_id);
+      if (not account) {
+        return nonstd::nullopt;
+      }
+      auto result = *account;
+      if (auto details = state->account_details.find(account_id)) {
+        result.json_data = renderDetails(*details);
+      }
+      return result;
+    }
+
+    nonstd::optional<std::string> EmbeddedWsvQuery::getAccountDetail(
+        const std::string &account_id,
+        const std::string &creator_account_id,
+        const std::string &detail) {
+      auto state = snapshot_();
+      auto details = state->account_details.find(account_id);
+      if (not details) {
+        return nonstd::nullopt;
+      }
+      auto creator = details->find(creator_account_id);
+      if (creator == details->end()) {
+        return nonstd::nullopt;
+      }
+      auto value = creator->second.find(detail);
+      if (value == creator->second.end()) {
+        return nonstd::nullopt;
+      }
+      return value->second;
+    }
+
+    nonstd::optional<std::vector<pubkey_t>> EmbeddedWsvQuery::getSignatories(
+        const std::string &account_id) {
+      auto state = snapshot_();
+      auto signatories = state->account_signatories.find(account_id);
+      return signatories ? *signatories : std::vector<pubkey_t>{};
+    }
+
+    nonstd::optional<model::Asset> EmbeddedWsvQuery::getAsset(
+        const std::string &asset_id) {
+      auto state = snapshot_();
+      auto asset = state->assets.find(asset_id);
+      if (not asset) {
+        return nonstd::nullopt;
+      }
+      return *asset;
+    }
+
+    nonstd::optional<model::AccountAsset> EmbeddedWsvQuery::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      auto state = snapshot_();
+      auto balance = state->account_assets.find(
+          std::make_pair(account_id, asset_id));
+      if (not balance) {
+        return nonstd::nullopt;
+      }
+      return *balance;
+    }
+
+    nonstd::optional<std::vector<model::Peer>> EmbeddedWsvQuery::getPeers() {
+      return *snapshot_()->peers;
+    }
+
+    nonstd::optional<std::vector<std::string>> EmbeddedWsvQuery::getRoles() {
+      std::vector<std::string> roles;
+      snapshot_()->roles.forEach(
+          [&roles](const auto &role, const auto &) { roles.push_back(role); });
+      return roles;
+    }
+
+    nonstd::optional<model::Domain> EmbeddedWsvQuery::getDomain(
+        const std::string &domain_id) {
+      auto state = snapshot_();
+      auto domain = state->domains.find(domain_id);
+      if (not domain) {
+        return nonstd::nullopt;
+      }
+      return *domain;
+    }
+
+    bool EmbeddedWsvQuery::hasAccountGrantablePermission(
+        const std::string &permitee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      auto state = snapshot_();
+      auto permissions = state->grantable_permissions.find(permitee_account_id);
+      return permissions
+          and permissions->count(std::make_pair(account_id, permission_id))
+          != 0;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -107,10 +107,10 @@ std::unique_ptr<FlatFile> FlatFile::create(const std::string &path) {
   return std::unique_ptr<FlatFile>(new FlatFile(*res, path));
 }
 
-void FlatFile::add(Identifier id, const std::vector<uint8_t> &block) {
+bool FlatFile::add(Identifier id, const std::vector<uint8_t> &block) {
   if (id != current_id_ + 1) {
     log_->warn("Cannot append non-consecutive block");
-    return;
+    return false;
   }
 
   auto next_id = id;
@@ -120,13 +120,13 @@ void FlatFile::add(Identifier id, const std::vector<uint8_t> &block) {
   if (boost::filesystem::exists(file_name)) {
     // File already exist
     log_->warn("insertion for {} failed, because file already exists", id);
-    return;
+    return false;
   }
   // New file will be created
   boost::filesystem::ofstream file(file_name.native(), std::ofstream::binary);
   if (not file.is_open()) {
     log_->warn("Cannot open file by index {} for writing", id);
-    return;
+    return false;
   }
 
   auto val_size =
@@ -134,9 +134,16 @@ void FlatFile::add(Identifier id, const std::vector<uint8_t> &block) {
 
   file.write(reinterpret_cast<const char *>(block.data()),
              block.size() * val_size);
+  file.close();
+  if (not file) {
+    log_->warn("insertion for {} failed, cannot write file", id);
+    boost::filesystem::remove(file_name);
+    return false;
+  }
 
   // Update internals, release lock
   current_id_ = next_id;
+  return true;
 }
 
 nonstd::optional<std::vector<uint8_t>> FlatFile::get(Identifier id) const {
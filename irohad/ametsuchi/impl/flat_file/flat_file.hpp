@@ -24,20 +24,16 @@
 #include <vector>
 #include <atomic>
 
+#include "ametsuchi/key_value_storage.hpp"
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
-    /**
-     * Type of storage key
-     */
-    using Identifier = uint32_t;
-
     /**
      * Solid storage based on raw files
      */
-    class FlatFile {
+    class FlatFile : public KeyValueStorage {
      public:
       // ----------| public API |----------
 
@@ -52,27 +48,29 @@ namespace iroha {
        * Add entity with binary data
        * @param id - reference key
        * @param blob - data associated with key
+       * @return true if entity is written, false otherwise
        */
-      void add(Identifier id, const std::vector<uint8_t> &blob);
+      bool add(Identifier id, const std::vector<uint8_t> &blob) override;
 
       /**
        * Get data associated with
        * @param id - reference key
        * @return - blob, if exists
        */
-      nonstd::optional<std::vector<uint8_t>> get(Identifier id) const;
+      nonstd::optional<std::vector<uint8_t>> get(
+          Identifier id) const override;
 
       /**
        * @return folder of storage
        */
-      std::string directory() const;
+      std::string directory() const override;
 
       /**
        * @return maximal not null key
        */
-      Identifier last_id() const;
+      Identifier last_id() const override;
 
-      void dropAll();
+      void dropAll() override;
 
       // ----------| modify operations |----------
 
@@ -109,7 +107,7 @@ namespace iroha {
       logger::Logger log_;
 
      public:
-      ~FlatFile() = default;
+      ~FlatFile() override = default;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -18,9 +18,10 @@
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
 #include <model/commands/transfer_asset.hpp>
 
+#include "ametsuchi/impl/cached_wsv_command.hpp"
+#include "ametsuchi/impl/cached_wsv_query.hpp"
 #include "ametsuchi/impl/postgres_wsv_command.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
-#include "ametsuchi/impl/redis_block_index.hpp"
 
 #include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
 
@@ -28,20 +29,26 @@ namespace iroha {
   namespace ametsuchi {
     MutableStorageImpl::MutableStorageImpl(
         hash256_t top_hash,
-        std::unique_ptr<cpp_redis::client> index,
-        std::unique_ptr<pqxx::lazyconnection> connection,
+        std::unique_ptr<BlockIndex> block_index,
+        PooledConnection<pqxx::lazyconnection> connection,
         std::unique_ptr<pqxx::nontransaction> transaction,
-        std::shared_ptr<model::CommandExecutorFactory> command_executors)
+        std::shared_ptr<model::CommandExecutorFactory> command_executors,
+        std::shared_ptr<WsvCache> wsv_cache)
         : top_hash_(top_hash),
-          index_(std::move(index)),
           connection_(std::move(connection)),
           transaction_(std::move(transaction)),
-          wsv_(std::make_unique<PostgresWsvQuery>(*transaction_)),
-          executor_(std::make_unique<PostgresWsvCommand>(*transaction_)),
-          block_index_(std::make_unique<RedisBlockIndex>(*index_)),
+          batch_(std::make_shared<PostgresWsvBatch>(*transaction_)),
+          written_(std::make_shared<WsvCache::Keys>()),
+          wsv_(std::make_unique<CachedWsvQuery>(
+              std::make_unique<PostgresWsvQuery>(*transaction_, batch_),
+              std::move(wsv_cache),
+              written_)),
+          executor_(std::make_unique<CachedWsvCommand>(
+              std::make_unique<PostgresWsvCommand>(*transaction_, batch_),
+              written_)),
+          block_index_(std::move(block_index)),
           command_executors_(std::move(command_executors)),
           committed(false) {
-      index_->multi();
       transaction_->exec("BEGIN;");
     }
 
@@ -63,7 +70,8 @@ namespace iroha {
       auto result = function(block, *wsv_, top_hash_)
           and std::all_of(block.transactions.begin(),
                           block.transactions.end(),
-                          execute_transaction);
+                          execute_transaction)
+          and batch_->flush();
 
       if (result) {
         block_store_.insert(std::make_pair(block.height, block));
@@ -72,6 +80,7 @@ namespace iroha {
         top_hash_ = block.hash;
         transaction_->exec("RELEASE SAVEPOINT savepoint_;");
       } else {
+        batch_->discard();
         transaction_->exec("ROLLBACK TO SAVEPOINT savepoint_;");
       }
       return result;
@@ -79,7 +88,7 @@ namespace iroha {
 
     MutableStorageImpl::~MutableStorageImpl() {
       if (not committed) {
-        index_->discard();
+        block_index_->discard();
         transaction_->exec("ROLLBACK;");
       }
     }
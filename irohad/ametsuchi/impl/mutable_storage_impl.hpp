@@ -21,12 +21,14 @@
 #include "ametsuchi/mutable_storage.hpp"
 
 #include <unordered_map>
-#include <cpp_redis/cpp_redis>
 #include <pqxx/connection>
 #include <pqxx/nontransaction>
 
 #include "model/execution/command_executor_factory.hpp"
 #include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "ametsuchi/impl/postgres_wsv_batch.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -35,10 +37,11 @@ namespace iroha {
 
      public:
       MutableStorageImpl(
-          hash256_t top_hash, std::unique_ptr<cpp_redis::client> index,
-          std::unique_ptr<pqxx::lazyconnection> connection,
+          hash256_t top_hash, std::unique_ptr<BlockIndex> block_index,
+          PooledConnection<pqxx::lazyconnection> connection,
           std::unique_ptr<pqxx::nontransaction> transaction,
-          std::shared_ptr<model::CommandExecutorFactory> command_executors);
+          std::shared_ptr<model::CommandExecutorFactory> command_executors,
+          std::shared_ptr<WsvCache> wsv_cache);
 
       bool apply(const model::Block &block,
                  std::function<bool(const model::Block &,
@@ -52,10 +55,13 @@ namespace iroha {
       // ordered collection is used to enforce block insertion order in
       // StorageImpl::commit
       std::map<uint32_t, model::Block> block_store_;
-      std::unique_ptr<cpp_redis::client> index_;
 
-      std::unique_ptr<pqxx::lazyconnection> connection_;
+      PooledConnection<pqxx::lazyconnection> connection_;
       std::unique_ptr<pqxx::nontransaction> transaction_;
+      // balances written by commands of the block being applied
+      std::shared_ptr<PostgresWsvBatch> batch_;
+      // keys of cached entities to invalidate in StorageImpl::commit
+      std::shared_ptr<WsvCache::Keys> written_;
       std::unique_ptr<WsvQuery> wsv_;
       std::unique_ptr<WsvCommand> executor_;
       std::unique_ptr<BlockIndex> block_index_;
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/overlay_temporary_wsv.hpp"
+
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+    OverlayTemporaryWsv::OverlayTemporaryWsv(
+        PooledConnection<pqxx::lazyconnection> connection,
+        std::unique_ptr<pqxx::nontransaction> transaction,
+        std::shared_ptr<model::CommandExecutorFactory> command_executors,
+        std::shared_ptr<WsvCache> wsv_cache)
+        : connection_(std::move(connection)),
+          transaction_(std::move(transaction)),
+          committed_(std::make_unique<CachedWsvQuery>(
+              std::make_unique<PostgresWsvQuery>(*transaction_),
+              std::move(wsv_cache),
+              std::make_shared<WsvCache::Keys>())),
+          overlay_(*committed_),
+          command_executors_(std::move(command_executors)) {}
+
+    bool OverlayTemporaryWsv::apply(
+        const model::Transaction &transaction,
+        std::function<bool(const model::Transaction &, WsvQuery &)>
+            apply_function) {
+      const auto &tx_creator = transaction.creator_account_id;
+      auto execute_command = [this, &tx_creator](auto command) {
+        auto executor = command_executors_->getCommandExecutor(command);
+        return executor->validate(*command, overlay_, tx_creator)
+            && executor->execute(*command, overlay_, overlay_, tx_creator);
+      };
+
+      auto result = apply_function(transaction, overlay_)
+          && std::all_of(transaction.commands.begin(),
+                         transaction.commands.end(),
+                         execute_command);
+      if (result) {
+        overlay_.release();
+      } else {
+        overlay_.rollback();
+      }
+      return result;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
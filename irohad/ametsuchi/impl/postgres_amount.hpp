@@ -0,0 +1,66 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_AMOUNT_HPP
+#define IROHA_POSTGRES_AMOUNT_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "amount/amount.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Balance as stored in account_has_asset: four limbs of the value, most
+     * significant first as in Amount::to_uint64s, and precision.
+     * Limbs are unsigned, PostgreSQL bigint keeps the same bits.
+     */
+    struct AmountColumns {
+      std::array<int64_t, 4> limbs;
+      int precision;
+    };
+
+    /**
+     * Names of balance columns in order of AmountColumns
+     */
+    const std::string AMOUNT_COLUMNS =
+        "amount_0, amount_1, amount_2, amount_3, amount_precision";
+
+    inline AmountColumns toAmountColumns(Amount amount) {
+      AmountColumns columns;
+      auto limbs = amount.to_uint64s();
+      for (size_t i = 0; i < columns.limbs.size(); ++i) {
+        columns.limbs[i] = static_cast<int64_t>(limbs[i]);
+      }
+      columns.precision = amount.getPrecision();
+      return columns;
+    }
+
+    inline Amount fromAmountColumns(const AmountColumns &columns) {
+      return Amount(static_cast<uint64_t>(columns.limbs[0]),
+                    static_cast<uint64_t>(columns.limbs[1]),
+                    static_cast<uint64_t>(columns.limbs[2]),
+                    static_cast<uint64_t>(columns.limbs[3]),
+                    static_cast<uint8_t>(columns.precision));
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_AMOUNT_HPP
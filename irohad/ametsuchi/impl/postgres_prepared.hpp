@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_PREPARED_HPP
+#define IROHA_POSTGRES_PREPARED_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pqxx/connection_base>
+#include <pqxx/result>
+#include <pqxx/transaction_base>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Pairs of name and SQL of prepared statements
+     */
+    using PreparedStatements = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Register statements on connection. Statements are parsed by
+     * PostgreSQL on first execution, and reused until connection is closed.
+     * Registering the same statement again is no-op
+     * @param connection - connection to register statements on
+     * @param statements - statements to be registered
+     */
+    inline void prepareStatements(pqxx::connection_base &connection,
+                                  const PreparedStatements &statements) {
+      for (const auto &statement : statements) {
+        connection.prepare(statement.first, statement.second);
+      }
+    }
+
+    /**
+     * Execute prepared statement with bound parameters
+     * @param transaction - transaction to execute statement in
+     * @param name - name of registered statement
+     * @param args - values of statement parameters in order
+     * @return result of execution
+     */
+    template <typename... Args>
+    pqxx::result execPrepared(pqxx::transaction_base &transaction,
+                              const std::string &name,
+                              const Args &... args) {
+      auto invocation = transaction.prepared(name);
+      using expand = int[];
+      (void)expand{0, ((void)invocation(args), 0)...};
+      return invocation.exec();
+    }
+
+    /**
+     * Format values as PostgreSQL array literal, so that a collection can be
+     * bound to a single statement parameter, e.g. unnest($1::text[])
+     * @param values - values of array elements
+     * @return array literal with quoted elements
+     */
+    template <typename Values>
+    std::string toArrayLiteral(const Values &values) {
+      std::string literal = "{";
+      for (const auto &value : values) {
+        if (literal.size() > 1) {
+          literal += ',';
+        }
+        literal += '"';
+        for (auto c : value) {
+          if (c == '"' or c == '\\') {
+            literal += '\\';
+          }
+          literal += c;
+        }
+        literal += '"';
+      }
+      literal += '}';
+      return literal;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_PREPARED_HPP
@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/postgres_wsv_batch.hpp"
+
+#include <array>
+#include <vector>
+
+#include "ametsuchi/impl/postgres_amount.hpp"
+#include "ametsuchi/impl/postgres_prepared.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const PreparedStatements STATEMENTS = {
+          {"wsv_upsert_account_assets",
+           "INSERT INTO account_has_asset(account_id, asset_id, "
+           + AMOUNT_COLUMNS
+           + ") SELECT * FROM unnest($1::text[], $2::text[], $3::bigint[], "
+             "$4::bigint[], $5::bigint[], $6::bigint[], $7::smallint[]) "
+             "ON CONFLICT (account_id, asset_id) DO UPDATE SET ("
+           + AMOUNT_COLUMNS + ") = (EXCLUDED.amount_0, EXCLUDED.amount_1, "
+                              "EXCLUDED.amount_2, EXCLUDED.amount_3, "
+                              "EXCLUDED.amount_precision)"}};
+    }  // namespace
+
+    PostgresWsvBatch::PostgresWsvBatch(pqxx::nontransaction &transaction)
+        : transaction_(transaction), log_(logger::log("PostgresWsvBatch")) {
+      prepareStatements(transaction_.conn(), STATEMENTS);
+    }
+
+    void PostgresWsvBatch::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      account_assets_[std::make_pair(asset.account_id, asset.asset_id)] =
+          asset;
+    }
+
+    nonstd::optional<model::AccountAsset> PostgresWsvBatch::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) const {
+      auto it = account_assets_.find(std::make_pair(account_id, asset_id));
+      if (it == account_assets_.end()) {
+        return nonstd::nullopt;
+      }
+      return it->second;
+    }
+
+    bool PostgresWsvBatch::flush() {
+      if (account_assets_.empty()) {
+        return true;
+      }
+      std::vector<std::string> account_ids, asset_ids, precisions;
+      std::array<std::vector<std::string>, 4> limbs;
+      account_ids.reserve(account_assets_.size());
+      asset_ids.reserve(account_assets_.size());
+      precisions.reserve(account_assets_.size());
+      for (auto &limb : limbs) {
+        limb.reserve(account_assets_.size());
+      }
+      for (const auto &entry : account_assets_) {
+        account_ids.push_back(entry.second.account_id);
+        asset_ids.push_back(entry.second.asset_id);
+        auto balance = toAmountColumns(entry.second.balance);
+        for (size_t i = 0; i < limbs.size(); ++i) {
+          limbs[i].push_back(std::to_string(balance.limbs[i]));
+        }
+        precisions.push_back(std::to_string(balance.precision));
+      }
+      account_assets_.clear();
+      try {
+        execPrepared(transaction_,
+                     "wsv_upsert_account_assets",
+                     toArrayLiteral(account_ids),
+                     toArrayLiteral(asset_ids),
+                     toArrayLiteral(limbs[0]),
+                     toArrayLiteral(limbs[1]),
+                     toArrayLiteral(limbs[2]),
+                     toArrayLiteral(limbs[3]),
+                     toArrayLiteral(precisions));
+      } catch (const std::exception &e) {
+        log_->error(e.what());
+        return false;
+      }
+      return true;
+    }
+
+    void PostgresWsvBatch::discard() {
+      account_assets_.clear();
+    }
+
+    size_t PostgresWsvBatch::size() const {
+      return account_assets_.size();
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
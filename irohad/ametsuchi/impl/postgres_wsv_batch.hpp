@@ -0,0 +1,87 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_WSV_BATCH_HPP
+#define IROHA_POSTGRES_WSV_BATCH_HPP
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <nonstd/optional.hpp>
+#include <pqxx/nontransaction>
+
+#include "logger/logger.hpp"
+#include "model/account_asset.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Balances written by commands of a block, which are kept in memory
+     * and written to PostgreSQL by a single statement on flush instead of
+     * a round trip per command.
+     * Only the last balance of each account asset is written, since the
+     * upsert overwrites the amount anyway.
+     */
+    class PostgresWsvBatch {
+     public:
+      explicit PostgresWsvBatch(pqxx::nontransaction &transaction);
+
+      /**
+       * Remember balance to be written on flush
+       * @param asset - account asset with new balance
+       */
+      void upsertAccountAsset(const model::AccountAsset &asset);
+
+      /**
+       * @param account_id - id of account
+       * @param asset_id - id of asset
+       * @return pending balance, nullopt if it was not written since flush
+       */
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) const;
+
+      /**
+       * Write all pending balances in the transaction
+       * @return true if balances are written or there are none
+       */
+      bool flush();
+
+      /**
+       * Forget pending balances, e.g. when a block is rolled back
+       */
+      void discard();
+
+      /**
+       * @return number of pending balances
+       */
+      size_t size() const;
+
+     private:
+      pqxx::nontransaction &transaction_;
+
+      // ordered to write rows in deterministic order
+      std::map<std::pair<std::string, std::string>, model::AccountAsset>
+          account_assets_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_WSV_BATCH_HPP
@@ -17,20 +17,86 @@
 
 #include "ametsuchi/impl/postgres_wsv_command.hpp"
 
-#include <iterator>
-#include <numeric>
+#include "ametsuchi/impl/postgres_amount.hpp"
+#include "ametsuchi/impl/postgres_prepared.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
-    PostgresWsvCommand::PostgresWsvCommand(pqxx::nontransaction &transaction)
-        : transaction_(transaction), log_(logger::log("PostgresWsvCommand")) {}
+    namespace {
+      const PreparedStatements STATEMENTS = {
+          {"wsv_insert_role", "INSERT INTO role(role_id) VALUES ($1)"},
+          {"wsv_insert_account_role",
+           "INSERT INTO account_has_roles(account_id, role_id) VALUES ($1, "
+           "$2)"},
+          {"wsv_delete_account_role",
+           "DELETE FROM account_has_roles WHERE account_id = $1 AND role_id = "
+           "$2"},
+          {"wsv_insert_role_permissions",
+           "INSERT INTO role_has_permissions(role_id, permission_id) "
+           "SELECT $1::text, unnest($2::text[])"},
+          {"wsv_insert_grantable_permission",
+           "INSERT INTO account_has_grantable_permissions("
+           "permittee_account_id, account_id, permission_id) VALUES ($1, $2, "
+           "$3)"},
+          {"wsv_delete_grantable_permission",
+           "DELETE FROM account_has_grantable_permissions WHERE "
+           "permittee_account_id = $1 AND account_id = $2 AND "
+           "permission_id = $3"},
+          {"wsv_insert_account",
+           "INSERT INTO account(account_id, domain_id, quorum, "
+           "transaction_count, data) VALUES ($1, $2, $3, $4, $5)"},
+          {"wsv_insert_asset",
+           "INSERT INTO asset(asset_id, domain_id, \"precision\", data) "
+           "VALUES ($1, $2, $3, NULL)"},
+          {"wsv_upsert_account_asset",
+           "INSERT INTO account_has_asset(account_id, asset_id, "
+           + AMOUNT_COLUMNS
+           + ") VALUES ($1, $2, $3, $4, $5, $6, $7) ON CONFLICT (account_id, "
+             "asset_id) DO UPDATE SET ("
+           + AMOUNT_COLUMNS + ") = (EXCLUDED.amount_0, EXCLUDED.amount_1, "
+                              "EXCLUDED.amount_2, EXCLUDED.amount_3, "
+                              "EXCLUDED.amount_precision)"},
+          {"wsv_insert_signatory",
+           "INSERT INTO signatory(public_key) VALUES ($1) ON CONFLICT DO "
+           "NOTHING"},
+          {"wsv_insert_account_signatory",
+           "INSERT INTO account_has_signatory(account_id, public_key) VALUES "
+           "($1, $2)"},
+          {"wsv_delete_account_signatory",
+           "DELETE FROM account_has_signatory WHERE account_id = $1 AND "
+           "public_key = $2"},
+          {"wsv_delete_signatory",
+           "DELETE FROM signatory WHERE public_key = $1 AND NOT EXISTS "
+           "(SELECT 1 FROM account_has_signatory WHERE public_key = $1) AND "
+           "NOT EXISTS (SELECT 1 FROM peer WHERE public_key = $1)"},
+          {"wsv_insert_peer",
+           "INSERT INTO peer(public_key, address) VALUES ($1, $2)"},
+          {"wsv_delete_peer",
+           "DELETE FROM peer WHERE public_key = $1 AND address = $2"},
+          {"wsv_insert_domain",
+           "INSERT INTO domain(domain_id, default_role) VALUES ($1, $2)"},
+          {"wsv_update_account",
+           "UPDATE account SET quorum = $1, transaction_count = $2 WHERE "
+           "account_id = $3"},
+          {"wsv_set_account_kv",
+           "UPDATE account SET data = jsonb_set(CASE WHEN data ? $1 THEN data "
+           "ELSE jsonb_set(data, $2::text[], '{}'::jsonb) END, $3::text[], "
+           "$4::jsonb) WHERE account_id = $5"}};
+    }  // namespace
+
+    PostgresWsvCommand::PostgresWsvCommand(
+        pqxx::nontransaction &transaction,
+        std::shared_ptr<PostgresWsvBatch> batch)
+        : transaction_(transaction),
+          batch_(std::move(batch)),
+          log_(logger::log("PostgresWsvCommand")) {
+      prepareStatements(transaction_.conn(), STATEMENTS);
+    }
 
     bool PostgresWsvCommand::insertRole(const std::string &role_name) {
       try {
-        transaction_.exec("INSERT INTO role(role_id) VALUES ("
-                          + transaction_.quote(role_name)
-                          + ");");
+        execPrepared(transaction_, "wsv_insert_role", role_name);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -41,12 +107,8 @@ namespace iroha {
     bool PostgresWsvCommand::insertAccountRole(const std::string &account_id,
                                                const std::string &role_name) {
       try {
-        transaction_.exec(
-            "INSERT INTO account_has_roles(account_id, role_id) VALUES ("
-            + transaction_.quote(account_id)
-            + ", "
-            + transaction_.quote(role_name)
-            + ");");
+        execPrepared(
+            transaction_, "wsv_insert_account_role", account_id, role_name);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -57,11 +119,8 @@ namespace iroha {
     bool PostgresWsvCommand::deleteAccountRole(const std::string &account_id,
                                                const std::string &role_name) {
       try {
-        transaction_.exec("DELETE FROM account_has_roles WHERE account_id="
-                          + transaction_.quote(account_id)
-                          + "AND role_id="
-                          + transaction_.quote(role_name)
-                          + ";");
+        execPrepared(
+            transaction_, "wsv_delete_account_role", account_id, role_name);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -71,19 +130,11 @@ namespace iroha {
 
     bool PostgresWsvCommand::insertRolePermissions(
         const std::string &role_id, const std::set<std::string> &permissions) {
-      auto entry = [this, &role_id](auto permission) {
-        return "(" + transaction_.quote(role_id) + ", "
-            + transaction_.quote(permission) + ")";
-      };
       try {
-        transaction_.exec(
-            "INSERT INTO role_has_permissions(role_id, permission_id) VALUES "
-            + std::accumulate(
-                  std::next(permissions.begin()),
-                  permissions.end(),
-                  entry(*permissions.begin()),
-                  [&entry](auto acc, auto x) { return acc + ", " + entry(x); })
-            + ";");
+        execPrepared(transaction_,
+                     "wsv_insert_role_permissions",
+                     role_id,
+                     toArrayLiteral(permissions));
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -96,16 +147,11 @@ namespace iroha {
         const std::string &account_id,
         const std::string &permission_id) {
       try {
-        transaction_.exec(
-            "INSERT INTO "
-            "account_has_grantable_permissions(permittee_account_id, "
-            "account_id, permission_id) VALUES ("
-            + transaction_.quote(permittee_account_id)
-            + ", "
-            + transaction_.quote(account_id)
-            + ", "
-            + transaction_.quote(permission_id)
-            + ");");
+        execPrepared(transaction_,
+                     "wsv_insert_grantable_permission",
+                     permittee_account_id,
+                     account_id,
+                     permission_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -118,15 +164,11 @@ namespace iroha {
         const std::string &account_id,
         const std::string &permission_id) {
       try {
-        transaction_.exec(
-            "DELETE FROM public.account_has_grantable_permissions WHERE "
-            "permittee_account_id="
-            + transaction_.quote(permittee_account_id)
-            + " AND account_id="
-            + transaction_.quote(account_id)
-            + " AND permission_id="
-            + transaction_.quote(permission_id)
-            + " ;");
+        execPrepared(transaction_,
+                     "wsv_delete_grantable_permission",
+                     permittee_account_id,
+                     account_id,
+                     permission_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -136,20 +178,14 @@ namespace iroha {
 
     bool PostgresWsvCommand::insertAccount(const model::Account &account) {
       try {
-        transaction_.exec(
-            "INSERT INTO account(account_id, domain_id, quorum, "
-            "transaction_count, data) VALUES ("
-            + transaction_.quote(account.account_id)
-            + ", "
-            + transaction_.quote(account.domain_id)
-            + ", "
-            + transaction_.quote(account.quorum)
-            + ", "
-            // Transaction counter
-            + transaction_.quote(default_tx_counter)
-            + ", "
-            + transaction_.quote(account.json_data)
-            + ");");
+        execPrepared(transaction_,
+                     "wsv_insert_account",
+                     account.account_id,
+                     account.domain_id,
+                     account.quorum,
+                     // Transaction counter
+                     default_tx_counter,
+                     account.json_data);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -160,17 +196,11 @@ namespace iroha {
     bool PostgresWsvCommand::insertAsset(const model::Asset &asset) {
       uint32_t precision = asset.precision;
       try {
-        transaction_.exec(
-            "INSERT INTO asset(asset_id, domain_id, \"precision\", data) "
-            "VALUES ("
-            + transaction_.quote(asset.asset_id)
-            + ", "
-            + transaction_.quote(asset.domain_id)
-            + ", "
-            + transaction_.quote(precision)
-            + ", "
-            + /*asset.data*/ "NULL"
-            + ");");
+        execPrepared(transaction_,
+                     "wsv_insert_asset",
+                     asset.asset_id,
+                     asset.domain_id,
+                     precision);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -180,15 +210,21 @@ namespace iroha {
 
     bool PostgresWsvCommand::upsertAccountAsset(
         const model::AccountAsset &asset) {
+      if (batch_) {
+        batch_->upsertAccountAsset(asset);
+        return true;
+      }
       try {
-        transaction_.exec(
-            "INSERT INTO account_has_asset(account_id, asset_id, amount) "
-            "VALUES ("
-            + transaction_.quote(asset.account_id) + ", "
-            + transaction_.quote(asset.asset_id) + ", "
-            + transaction_.quote(asset.balance.to_string())
-            + ") ON CONFLICT (account_id, asset_id) DO UPDATE SET "
-            "amount = EXCLUDED.amount;");
+        auto balance = toAmountColumns(asset.balance);
+        execPrepared(transaction_,
+                     "wsv_upsert_account_asset",
+                     asset.account_id,
+                     asset.asset_id,
+                     balance.limbs[0],
+                     balance.limbs[1],
+                     balance.limbs[2],
+                     balance.limbs[3],
+                     balance.precision);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -199,9 +235,7 @@ namespace iroha {
     bool PostgresWsvCommand::insertSignatory(const pubkey_t &signatory) {
       try {
         pqxx::binarystring public_key(signatory.data(), signatory.size());
-        transaction_.exec("INSERT INTO signatory(public_key) VALUES ("
-                          + transaction_.quote(public_key)
-                          + ") ON CONFLICT DO NOTHING;");
+        execPrepared(transaction_, "wsv_insert_signatory", public_key);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -213,12 +247,10 @@ namespace iroha {
         const std::string &account_id, const pubkey_t &signatory) {
       pqxx::binarystring public_key(signatory.data(), signatory.size());
       try {
-        transaction_.exec(
-            "INSERT INTO account_has_signatory(account_id, public_key) VALUES ("
-            + transaction_.quote(account_id)
-            + ", "
-            + transaction_.quote(public_key)
-            + ");");
+        execPrepared(transaction_,
+                     "wsv_insert_account_signatory",
+                     account_id,
+                     public_key);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -230,12 +262,10 @@ namespace iroha {
         const std::string &account_id, const pubkey_t &signatory) {
       pqxx::binarystring public_key(signatory.data(), signatory.size());
       try {
-        transaction_.exec(
-            "DELETE FROM account_has_signatory WHERE account_id = "
-            + transaction_.quote(account_id)
-            + " AND public_key = "
-            + transaction_.quote(public_key)
-            + ";");
+        execPrepared(transaction_,
+                     "wsv_delete_account_signatory",
+                     account_id,
+                     public_key);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -246,13 +276,7 @@ namespace iroha {
     bool PostgresWsvCommand::deleteSignatory(const pubkey_t &signatory) {
       pqxx::binarystring public_key(signatory.data(), signatory.size());
       try {
-        transaction_.exec("DELETE FROM signatory WHERE public_key = "
-            + transaction_.quote(public_key)
-            + " AND NOT EXISTS (SELECT 1 FROM account_has_signatory "
-            "WHERE public_key = "
-            + transaction_.quote(public_key)
-            + ") AND NOT EXISTS (SELECT 1 FROM peer WHERE public_key = "
-            + transaction_.quote(public_key) + ");");
+        execPrepared(transaction_, "wsv_delete_signatory", public_key);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -263,11 +287,8 @@ namespace iroha {
     bool PostgresWsvCommand::insertPeer(const model::Peer &peer) {
       pqxx::binarystring public_key(peer.pubkey.data(), peer.pubkey.size());
       try {
-        transaction_.exec("INSERT INTO peer(public_key, address) VALUES ("
-                          + transaction_.quote(public_key)
-                          + ", "
-                          + transaction_.quote(peer.address)
-                          + ");");
+        execPrepared(
+            transaction_, "wsv_insert_peer", public_key, peer.address);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -278,11 +299,8 @@ namespace iroha {
     bool PostgresWsvCommand::deletePeer(const model::Peer &peer) {
       pqxx::binarystring public_key(peer.pubkey.data(), peer.pubkey.size());
       try {
-        transaction_.exec("DELETE FROM peer WHERE public_key = "
-                          + transaction_.quote(public_key)
-                          + " AND address = "
-                          + transaction_.quote(peer.address)
-                          + ";");
+        execPrepared(
+            transaction_, "wsv_delete_peer", public_key, peer.address);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -292,11 +310,10 @@ namespace iroha {
 
     bool PostgresWsvCommand::insertDomain(const model::Domain &domain) {
       try {
-        transaction_.exec("INSERT INTO domain(domain_id, default_role) VALUES ("
-                          + transaction_.quote(domain.domain_id)
-                          + ", "
-                          + transaction_.quote(domain.default_role)
-                          + ");");
+        execPrepared(transaction_,
+                     "wsv_insert_domain",
+                     domain.domain_id,
+                     domain.default_role);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -306,15 +323,11 @@ namespace iroha {
 
     bool PostgresWsvCommand::updateAccount(const model::Account &account) {
       try {
-        transaction_.exec(
-            "UPDATE account\n"
-            "   SET quorum=" +
-            transaction_.quote(account.quorum) +
-            ", transaction_count=" +
-            /*account.transaction_count*/ transaction_.quote(default_tx_counter) +
-            "\n"
-            " WHERE account_id=" +
-            transaction_.quote(account.account_id) + ";");
+        execPrepared(transaction_,
+                     "wsv_update_account",
+                     account.quorum,
+                     /*account.transaction_count*/ default_tx_counter,
+                     account.account_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -327,20 +340,13 @@ namespace iroha {
                                           const std::string &key,
                                           const std::string &val) {
       try {
-        transaction_.exec(
-            "UPDATE account SET data = jsonb_set(CASE WHEN data ?"
-            + transaction_.quote(creator_account_id)
-            + " THEN data ELSE jsonb_set(data, "
-            + transaction_.quote("{" + creator_account_id + "}")
-            + ","
-            + transaction_.quote("{}")
-            + ") END,"
-            + transaction_.quote("{" + creator_account_id + ", " + key + "}")
-            + ","
-            + transaction_.quote("\"" + val + "\"")
-            + ") WHERE account_id="
-            + transaction_.quote(account_id)
-            + ";");
+        execPrepared(transaction_,
+                     "wsv_set_account_kv",
+                     creator_account_id,
+                     "{" + creator_account_id + "}",
+                     "{" + creator_account_id + ", " + key + "}",
+                     "\"" + val + "\"",
+                     account_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -20,15 +20,25 @@
 
 #include "ametsuchi/wsv_command.hpp"
 
+#include <memory>
+
 #include <pqxx/nontransaction>
 
+#include "ametsuchi/impl/postgres_wsv_batch.hpp"
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
     class PostgresWsvCommand : public WsvCommand {
      public:
-      explicit PostgresWsvCommand(pqxx::nontransaction &transaction);
+      /**
+       * @param transaction - transaction to write in
+       * @param batch - if present, balances are written to it instead of
+       * the database, and are flushed by owner of the transaction
+       */
+      explicit PostgresWsvCommand(
+          pqxx::nontransaction &transaction,
+          std::shared_ptr<PostgresWsvBatch> batch = nullptr);
       bool insertRole(const std::string &role_name) override;
 
       bool insertAccountRole(const std::string &account_id,
@@ -71,6 +81,7 @@ namespace iroha {
       const size_t default_tx_counter = 0;
 
       pqxx::nontransaction &transaction_;
+      std::shared_ptr<PostgresWsvBatch> batch_;
 
       logger::Logger log_;
     };
@@ -17,9 +17,40 @@
 
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 
+#include "ametsuchi/impl/postgres_amount.hpp"
+#include "ametsuchi/impl/postgres_prepared.hpp"
+
 namespace iroha {
   namespace ametsuchi {
 
+    namespace {
+      const PreparedStatements STATEMENTS = {
+          {"wsv_has_grantable_permission",
+           "SELECT * FROM account_has_grantable_permissions WHERE "
+           "permittee_account_id = $1 AND account_id = $2 AND "
+           "permission_id = $3"},
+          {"wsv_get_account_roles",
+           "SELECT role_id FROM account_has_roles WHERE account_id = $1"},
+          {"wsv_get_role_permissions",
+           "SELECT permission_id FROM role_has_permissions WHERE role_id = $1"},
+          {"wsv_get_account_permissions",
+           "SELECT DISTINCT permission_id FROM account_has_roles JOIN "
+           "role_has_permissions USING (role_id) WHERE account_id = $1"},
+          {"wsv_get_roles", "SELECT role_id FROM role"},
+          {"wsv_get_account", "SELECT * FROM account WHERE account_id = $1"},
+          {"wsv_get_account_detail",
+           "SELECT data#>>$1::text[] FROM account WHERE account_id = $2"},
+          {"wsv_get_signatories",
+           "SELECT public_key FROM account_has_signatory WHERE account_id = "
+           "$1"},
+          {"wsv_get_asset", "SELECT * FROM asset WHERE asset_id = $1"},
+          {"wsv_get_account_asset",
+           "SELECT * FROM account_has_asset WHERE account_id = $1 AND "
+           "asset_id = $2"},
+          {"wsv_get_domain", "SELECT * FROM domain WHERE domain_id = $1"},
+          {"wsv_get_peers", "SELECT * FROM peer"}};
+    }  // namespace
+
     using std::string;
 
     using nonstd::optional;
@@ -30,8 +61,14 @@ namespace iroha {
     using model::Peer;
     using model::Domain;
 
-    PostgresWsvQuery::PostgresWsvQuery(pqxx::nontransaction &transaction)
-        : transaction_(transaction), log_(logger::log("PostgresWsvQuery")) {}
+    PostgresWsvQuery::PostgresWsvQuery(
+        pqxx::nontransaction &transaction,
+        std::shared_ptr<const PostgresWsvBatch> batch)
+        : transaction_(transaction),
+          batch_(std::move(batch)),
+          log_(logger::log("PostgresWsvQuery")) {
+      prepareStatements(transaction_.conn(), STATEMENTS);
+    }
 
     bool PostgresWsvQuery::hasAccountGrantablePermission(
         const std::string &permitee_account_id,
@@ -39,15 +76,11 @@ namespace iroha {
         const std::string &permission_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT * FROM account_has_grantable_permissions WHERE "
-            "permittee_account_id = "
-            + transaction_.quote(permitee_account_id)
-            + " AND account_id = "
-            + transaction_.quote(account_id)
-            + " AND permission_id = "
-            + transaction_.quote(permission_id)
-            + ";");
+        result = execPrepared(transaction_,
+                              "wsv_has_grantable_permission",
+                              permitee_account_id,
+                              account_id,
+                              permission_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return false;
@@ -59,10 +92,8 @@ namespace iroha {
     PostgresWsvQuery::getAccountRoles(const std::string &account_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT role_id FROM account_has_roles WHERE account_id = "
-            + transaction_.quote(account_id)
-            + ";");
+        result =
+            execPrepared(transaction_, "wsv_get_account_roles", account_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -78,10 +109,8 @@ namespace iroha {
     PostgresWsvQuery::getRolePermissions(const std::string &role_name) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT permission_id FROM role_has_permissions WHERE role_id = "
-            + transaction_.quote(role_name)
-            + ";");
+        result =
+            execPrepared(transaction_, "wsv_get_role_permissions", role_name);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -93,10 +122,30 @@ namespace iroha {
       return permissions;
     }
 
+    nonstd::optional<model::PermissionSet>
+    PostgresWsvQuery::getAccountPermissions(const std::string &account_id) {
+      pqxx::result result;
+      try {
+        result = execPrepared(
+            transaction_, "wsv_get_account_permissions", account_id);
+      } catch (const std::exception &e) {
+        log_->error(e.what());
+        return nullopt;
+      }
+      model::PermissionSet permissions;
+      for (const auto &row : result) {
+        if (auto permission =
+                model::permissionOf(row.at("permission_id").c_str())) {
+          permissions.set(static_cast<size_t>(*permission));
+        }
+      }
+      return permissions;
+    }
+
     nonstd::optional<std::vector<std::string>> PostgresWsvQuery::getRoles() {
       pqxx::result result;
       try {
-        result = transaction_.exec("SELECT role_id FROM role;");
+        result = execPrepared(transaction_, "wsv_get_roles");
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -111,9 +160,7 @@ namespace iroha {
     optional<Account> PostgresWsvQuery::getAccount(const string &account_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec("SELECT * FROM account WHERE account_id = "
-                                   + transaction_.quote(account_id)
-                                   + ";");
+        result = execPrepared(transaction_, "wsv_get_account", account_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -138,12 +185,10 @@ namespace iroha {
         const std::string &detail) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT data#>>"
-            + transaction_.quote("{" + creator_account_id + ", " + detail + "}")
-            + " FROM account WHERE account_id = "
-            + transaction_.quote(account_id)
-            + ";");
+        result = execPrepared(transaction_,
+                              "wsv_get_account_detail",
+                              "{" + creator_account_id + ", " + detail + "}",
+                              account_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -167,10 +212,7 @@ namespace iroha {
         const string &account_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT public_key FROM account_has_signatory WHERE account_id = "
-            + transaction_.quote(account_id)
-            + ";");
+        result = execPrepared(transaction_, "wsv_get_signatories", account_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -188,9 +230,7 @@ namespace iroha {
     optional<Asset> PostgresWsvQuery::getAsset(const string &asset_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec("SELECT * FROM asset WHERE asset_id = "
-                                   + transaction_.quote(asset_id)
-                                   + ";");
+        result = execPrepared(transaction_, "wsv_get_asset", asset_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -212,14 +252,15 @@ namespace iroha {
 
     optional<AccountAsset> PostgresWsvQuery::getAccountAsset(
         const std::string &account_id, const std::string &asset_id) {
+      if (batch_) {
+        if (auto pending = batch_->getAccountAsset(account_id, asset_id)) {
+          return pending;
+        }
+      }
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT * FROM account_has_asset WHERE account_id = "
-            + transaction_.quote(account_id)
-            + " AND asset_id = "
-            + transaction_.quote(asset_id)
-            + ";");
+        result = execPrepared(
+            transaction_, "wsv_get_account_asset", account_id, asset_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -232,9 +273,13 @@ namespace iroha {
       auto row = result.at(0);
       row.at("account_id") >> asset.account_id;
       row.at("asset_id") >> asset.asset_id;
-      std::string amount_str;
-      row.at("amount") >> amount_str;
-      asset.balance = Amount::createFromString(amount_str).value();
+      AmountColumns balance;
+      row.at("amount_0") >> balance.limbs[0];
+      row.at("amount_1") >> balance.limbs[1];
+      row.at("amount_2") >> balance.limbs[2];
+      row.at("amount_3") >> balance.limbs[3];
+      row.at("amount_precision") >> balance.precision;
+      asset.balance = fromAmountColumns(balance);
       return asset;
     }
 
@@ -242,9 +287,7 @@ namespace iroha {
         const std::string &domain_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec("SELECT * FROM domain WHERE domain_id = "
-                                   + transaction_.quote(domain_id)
-                                   + ";");
+        result = execPrepared(transaction_, "wsv_get_domain", domain_id);
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -263,7 +306,7 @@ namespace iroha {
     nonstd::optional<std::vector<model::Peer>> PostgresWsvQuery::getPeers() {
       pqxx::result result;
       try {
-        result = transaction_.exec("SELECT * FROM peer;");
+        result = execPrepared(transaction_, "wsv_get_peers");
       } catch (const std::exception &e) {
         log_->error(e.what());
         return nullopt;
@@ -20,21 +20,34 @@
 
 #include "ametsuchi/wsv_query.hpp"
 
+#include <memory>
+
 #include <pqxx/nontransaction>
 
+#include "ametsuchi/impl/postgres_wsv_batch.hpp"
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
     class PostgresWsvQuery : public WsvQuery {
      public:
-      explicit PostgresWsvQuery(pqxx::nontransaction &transaction);
+      /**
+       * @param transaction - transaction to read in
+       * @param batch - if present, balances written to it are read before
+       * the database
+       */
+      explicit PostgresWsvQuery(
+          pqxx::nontransaction &transaction,
+          std::shared_ptr<const PostgresWsvBatch> batch = nullptr);
       nonstd::optional<std::vector<std::string>> getAccountRoles(
           const std::string &account_id) override;
 
       nonstd::optional<std::vector<std::string>> getRolePermissions(
           const std::string &role_name) override;
 
+      nonstd::optional<model::PermissionSet> getAccountPermissions(
+          const std::string &account_id) override;
+
       nonstd::optional<model::Account> getAccount(
           const std::string &account_id) override;
       nonstd::optional<std::string> getAccountDetail(
@@ -58,6 +71,7 @@ namespace iroha {
 
      private:
       pqxx::nontransaction &transaction_;
+      std::shared_ptr<const PostgresWsvBatch> batch_;
 
       logger::Logger log_;
     };
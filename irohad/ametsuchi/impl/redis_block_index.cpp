@@ -36,8 +36,29 @@ namespace iroha {
           account_id_height_("%s:%s"),
           account_id_height_asset_id_("%s:%s:%s") {}
 
+    RedisBlockIndex::RedisBlockIndex(
+        PooledConnection<cpp_redis::client> client)
+        : owned_client_(std::move(client)),
+          client_(*owned_client_),
+          account_id_height_("%s:%s"),
+          account_id_height_asset_id_("%s:%s:%s") {}
+
+    void RedisBlockIndex::commit() {
+      client_.exec();
+      client_.sync_commit();
+    }
+
+    void RedisBlockIndex::discard() {
+      client_.discard();
+      client_.sync_commit();
+    }
+
     void RedisBlockIndex::index(const model::Block &block) {
       const auto &height = std::to_string(block.height);
+
+      // block hash -> block height
+      client_.set("block:" + block.hash.to_string(), height);
+
       boost::for_each(
           block.transactions | boost::adaptors::indexed(0),
           [&](const auto &tx) {
@@ -45,8 +66,8 @@ namespace iroha {
             const auto &hash = iroha::hash(tx.value()).to_string();
             const auto &index = std::to_string(tx.index());
 
-            // tx hash -> block where hash is stored
-            client_.set(hash, height);
+            // tx hash -> block where hash is stored and tx index in it
+            client_.set(hash, height + ":" + index);
 
             this->indexAccountIdHeight(creator_id, height);
 
@@ -19,6 +19,7 @@
 #define IROHA_REDIS_BLOCK_INDEX_HPP
 
 #include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/connection_pool.hpp"
 
 #include <boost/format.hpp>
 #include <cpp_redis/cpp_redis>
@@ -29,8 +30,18 @@ namespace iroha {
      public:
       explicit RedisBlockIndex(cpp_redis::client &client);
 
+      /**
+       * Create index which owns its Redis connection
+       * @param client - connection, usually with started MULTI transaction
+       */
+      explicit RedisBlockIndex(PooledConnection<cpp_redis::client> client);
+
       void index(const model::Block &block) override;
 
+      void commit() override;
+
+      void discard() override;
+
      private:
       /**
        * Make index account_id -> list of blocks where his txs exist
@@ -54,6 +65,7 @@ namespace iroha {
                              const std::string &index,
                              const model::Transaction::CommandsType &commands);
 
+      PooledConnection<cpp_redis::client> owned_client_;
       cpp_redis::client &client_;
       /// format strings for index keys
       boost::format account_id_height_, account_id_height_asset_id_;
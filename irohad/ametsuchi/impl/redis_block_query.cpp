@@ -16,58 +16,15 @@
  */
 
 #include "ametsuchi/impl/redis_block_query.hpp"
-#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
     RedisBlockQuery::RedisBlockQuery(cpp_redis::client &client,
-                                     FlatFile &file_store)
-        : block_store_(file_store), client_(client) {}
-
-    rxcpp::observable<model::Block> RedisBlockQuery::getBlocks(uint32_t height,
-                                                               uint32_t count) {
-      auto to = height + count;
-      auto last_id = block_store_.last_id();
-      to = std::min(to, last_id);
-      if (height > to) {
-        return rxcpp::observable<>::empty<model::Block>();
-      }
-      return rxcpp::observable<>::range(height, to).flat_map([this](auto i) {
-        auto bytes = block_store_.get(i);
-        return rxcpp::observable<>::create<model::Block>([this, bytes](auto s) {
-          if (not bytes.has_value()) {
-            s.on_completed();
-            return;
-          }
-          auto document =
-              model::converters::stringToJson(bytesToString(bytes.value()));
-          if (not document.has_value()) {
-            s.on_completed();
-            return;
-          }
-          auto block = serializer_.deserialize(document.value());
-          if (not block.has_value()) {
-            s.on_completed();
-            return;
-          }
-          s.on_next(block.value());
-          s.on_completed();
-        });
-      });
-    }
-
-    rxcpp::observable<model::Block> RedisBlockQuery::getBlocksFrom(
-        uint32_t height) {
-      return getBlocks(height, block_store_.last_id());
-    }
-
-    rxcpp::observable<model::Block> RedisBlockQuery::getTopBlocks(
-        uint32_t count) {
-      auto last_id = block_store_.last_id();
-      count = std::min(count, last_id);
-      return getBlocks(last_id - count + 1, count);
-    }
+                                     KeyValueStorage &file_store,
+                                     std::shared_ptr<BlockCache> block_cache)
+        : BlockStoreQuery(file_store, std::move(block_cache)),
+          client_(client) {}
 
     std::vector<iroha::model::Block::BlockHeightType>
     RedisBlockQuery::getBlockIds(const std::string &account_id) {
@@ -86,19 +43,38 @@ namespace iroha {
       return block_ids;
     }
 
-    boost::optional<iroha::model::Block::BlockHeightType>
-    RedisBlockQuery::getBlockId(const std::string &hash) {
-      boost::optional<uint64_t> blockId;
-      client_.get(hash, [&blockId](cpp_redis::reply &reply) {
+    boost::optional<RedisBlockQuery::TxPosition>
+    RedisBlockQuery::getTxPosition(const std::string &hash) {
+      boost::optional<TxPosition> position;
+      client_.get(hash, [&position](cpp_redis::reply &reply) {
         if (reply.is_null()) {
-          blockId = boost::none;
-        } else {
-          blockId = std::stoul(reply.as_string());
+          return;
+        }
+        // height:index, or just height for entries of older index
+        const auto &value = reply.as_string();
+        auto separator = value.find(':');
+        position = TxPosition{std::stoul(value.substr(0, separator)),
+                              boost::none};
+        if (separator != std::string::npos) {
+          position->index = std::stoul(value.substr(separator + 1));
+        }
+      });
+      client_.sync_commit();
+
+      return position;
+    }
+
+    boost::optional<model::Block::BlockHeightType>
+    RedisBlockQuery::getBlockHeight(const std::string &hash) {
+      boost::optional<model::Block::BlockHeightType> height;
+      client_.get("block:" + hash, [&height](cpp_redis::reply &reply) {
+        if (not reply.is_null()) {
+          height = std::stoul(reply.as_string());
         }
       });
       client_.sync_commit();
 
-      return blockId;
+      return height;
     }
 
     std::function<void(cpp_redis::reply &)> RedisBlockQuery::callbackToLrange(
@@ -106,17 +82,15 @@ namespace iroha {
       return [this, &s, block_id](cpp_redis::reply &reply) {
         auto tx_ids_reply = reply.as_array();
 
-        block_store_.get(block_id) | [](auto bytes) {
-          return model::converters::stringToJson(bytesToString(bytes));
-        } | [this](const auto &json) {
-          return serializer_.deserialize(json);
-        } | [&](const auto &block) {
-          for (const auto &tx_reply : tx_ids_reply) {
-            auto tx_id = std::stoul(tx_reply.as_string());
-            auto &&tx = block.transactions.at(tx_id);
-            s.on_next(tx);
-          }
-        };
+        auto block = this->getBlock(block_id);
+        if (not block) {
+          return;
+        }
+        for (const auto &tx_reply : tx_ids_reply) {
+          auto tx_id = std::stoul(tx_reply.as_string());
+          auto &&tx = block->transactions.at(tx_id);
+          s.on_next(tx);
+        }
       };
     }
 
@@ -169,40 +143,5 @@ namespace iroha {
             subscriber.on_completed();
           });
     }
-
-    rxcpp::observable<boost::optional<model::Transaction>>
-    RedisBlockQuery::getTransactions(
-        const std::vector<iroha::hash256_t> &tx_hashes) {
-      return rxcpp::observable<>::create<boost::optional<model::Transaction>>(
-          [this, tx_hashes](auto subscriber) {
-            std::for_each(tx_hashes.begin(),
-                          tx_hashes.end(),
-                          [ that = this, &subscriber ](auto tx_hash) {
-                            subscriber.on_next(
-                                that->getTxByHashSync(tx_hash.to_string()));
-                          });
-            subscriber.on_completed();
-          });
-    }
-
-    boost::optional<model::Transaction> RedisBlockQuery::getTxByHashSync(
-        const std::string &hash) {
-      return getBlockId(hash) |
-          [this](auto blockId) { return block_store_.get(blockId); } |
-          [](auto bytes) {
-            return model::converters::stringToJson(bytesToString(bytes));
-          }
-      | [this](const auto &json) { return serializer_.deserialize(json); }
-      | [&](const auto &block) {
-          auto it = std::find_if(
-              block.transactions.begin(),
-              block.transactions.end(),
-              [&hash](auto tx) { return iroha::hash(tx).to_string() == hash; });
-          return (it == block.transactions.end())
-              ? boost::none
-              : boost::optional<model::Transaction>(*it);
-        };
-    }
-
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -19,21 +19,19 @@
 #define IROHA_REDIS_FLAT_BLOCK_QUERY_HPP
 
 #include <cpp_redis/cpp_redis>
-#include "ametsuchi/block_query.hpp"
-#include "ametsuchi/impl/flat_file/flat_file.hpp"
-
-#include "model/converters/json_block_factory.hpp"
-
-#include <boost/optional.hpp>
+#include "ametsuchi/impl/block_store_query.hpp"
 
 namespace iroha {
   namespace ametsuchi {
     /**
      * Class which implements BlockQuery with a Redis backend.
      */
-    class RedisBlockQuery : public BlockQuery {
+    class RedisBlockQuery : public BlockStoreQuery {
      public:
-      RedisBlockQuery(cpp_redis::client &client, FlatFile &file_store);
+      RedisBlockQuery(cpp_redis::client &client,
+                      KeyValueStorage &file_store,
+                      std::shared_ptr<BlockCache> block_cache =
+                          std::make_shared<BlockCache>());
 
       rxcpp::observable<model::Transaction> getAccountTransactions(
           const std::string &account_id) override;
@@ -41,18 +39,12 @@ namespace iroha {
       rxcpp::observable<model::Transaction> getAccountAssetTransactions(
           const std::string &account_id, const std::string &asset_id) override;
 
-      rxcpp::observable<boost::optional<model::Transaction>> getTransactions(
-          const std::vector<iroha::hash256_t> &tx_hashes) override;
-
-      boost::optional<model::Transaction> getTxByHashSync(
+     protected:
+      boost::optional<TxPosition> getTxPosition(
           const std::string &hash) override;
 
-      rxcpp::observable<model::Block> getBlocks(uint32_t height,
-                                                uint32_t count) override;
-
-      rxcpp::observable<model::Block> getBlocksFrom(uint32_t height) override;
-
-      rxcpp::observable<model::Block> getTopBlocks(uint32_t count) override;
+      boost::optional<model::Block::BlockHeightType> getBlockHeight(
+          const std::string &hash) override;
 
      private:
       /**
@@ -63,14 +55,6 @@ namespace iroha {
       std::vector<iroha::model::Block::BlockHeightType> getBlockIds(
           const std::string &account_id);
 
-      /**
-       * Returns block id which contains transaction with a given hash
-       * @param hash - hash of transaction
-       * @return block id or boost::none
-       */
-      boost::optional<iroha::model::Block::BlockHeightType> getBlockId(
-          const std::string &hash);
-
       /**
        * creates callback to lrange query to redis to supply result to
        * subscriber s
@@ -81,9 +65,7 @@ namespace iroha {
       std::function<void(cpp_redis::reply &)> callbackToLrange(
           const rxcpp::subscriber<model::Transaction> &s, uint64_t block_id);
 
-      FlatFile &block_store_;
       cpp_redis::client &client_;
-      model::converters::JsonBlockFactory serializer_;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -0,0 +1,895 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using namespace iroha::ametsuchi;
+
+constexpr uint64_t SegmentedFile::DEFAULT_SEGMENT_SIZE;
+constexpr uint64_t SegmentedFile::RECORD_HEADER_SIZE;
+constexpr Identifier SegmentedFile::CHECKPOINT_INTERVAL;
+constexpr size_t SegmentedFile::CHECKPOINT_TAIL;
+
+namespace {
+  const uint32_t DIGIT_CAPACITY = 16;
+  const std::string SEGMENT_EXTENSION = ".seg";
+  const std::string INDEX_EXTENSION = ".idx";
+  const size_t INDEX_ENTRY_SIZE = sizeof(uint64_t);
+  const std::string MANIFEST_NAME = "MANIFEST";
+  const uint32_t MANIFEST_VERSION = 1;
+  // version, first id, last id, end, tail, tail crc, crc of previous fields
+  const size_t MANIFEST_SIZE = 36;
+
+  /**
+   * Convert id to a DIGIT_CAPACITY-character width string, filled with
+   * leading zeros
+   * @param id - for conversion
+   * @return string repr of identifier
+   */
+  std::string id_to_name(Identifier id) {
+    std::ostringstream os;
+    os << std::setw(DIGIT_CAPACITY) << std::setfill('0') << id;
+    return os.str();
+  }
+
+  /**
+   * Parse identifier from the name produced by id_to_name
+   * @param name - file name without extension
+   * @return identifier, if name is well-formed
+   */
+  nonstd::optional<Identifier> name_to_id(const std::string &name) {
+    if (name.size() != DIGIT_CAPACITY
+        or not std::all_of(name.begin(), name.end(), ::isdigit)) {
+      return nonstd::nullopt;
+    }
+    auto id = std::stoull(name);
+    if (id > std::numeric_limits<Identifier>::max()) {
+      return nonstd::nullopt;
+    }
+    return static_cast<Identifier>(id);
+  }
+
+  // on-disk integers are little-endian regardless of the host
+
+  void encode32(uint8_t *dst, uint32_t value) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      dst[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+  }
+
+  uint32_t decode32(const uint8_t *src) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      value |= static_cast<uint32_t>(src[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  void encode64(uint8_t *dst, uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      dst[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+  }
+
+  uint64_t decode64(const uint8_t *src) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      value |= static_cast<uint64_t>(src[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  uint32_t checksum(const uint8_t *data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+  }
+
+  /**
+   * Write whole buffer at given position, retrying on partial writes
+   * @return true if all bytes were written
+   */
+  bool write_all(int fd, const uint8_t *data, size_t size, uint64_t offset) {
+    while (size > 0) {
+      auto written = ::pwrite(fd, data, size, offset);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += written;
+      size -= written;
+      offset += written;
+    }
+    return true;
+  }
+
+  /**
+   * Read whole buffer from given position, retrying on partial reads
+   * @return true if all bytes were read
+   */
+  bool read_all(int fd, uint8_t *data, size_t size, uint64_t offset) {
+    while (size > 0) {
+      auto read = ::pread(fd, data, size, offset);
+      if (read < 0 and errno == EINTR) {
+        continue;
+      }
+      if (read <= 0) {
+        return false;
+      }
+      data += read;
+      size -= read;
+      offset += read;
+    }
+    return true;
+  }
+
+  /**
+   * Calculate crc32 of file data in range [from, to)
+   * @return true if the range was read
+   */
+  bool checksum_range(int fd, uint64_t from, uint64_t to, uint32_t &crc) {
+    boost::crc_32_type crc32;
+    std::vector<uint8_t> buf(std::min<uint64_t>(to - from, 1024 * 1024));
+    while (from < to) {
+      auto size = std::min<uint64_t>(buf.size(), to - from);
+      if (not read_all(fd, buf.data(), size, from)) {
+        return false;
+      }
+      crc32.process_bytes(buf.data(), size);
+      from += size;
+    }
+    crc = crc32.checksum();
+    return true;
+  }
+}  // namespace
+
+// ----------| public API |----------
+
+std::unique_ptr<SegmentedFile> SegmentedFile::create(const std::string &path,
+                                                     uint64_t segment_size,
+                                                     RecoveryMode mode,
+                                                     SyncPolicy sync_policy) {
+  auto log_ = logger::log("SegmentedFile::create()");
+
+  boost::system::error_code error;
+  boost::filesystem::create_directory(path, error);
+  if (not boost::filesystem::is_directory(path)) {
+    log_->error("Cannot create storage dir: {}", path);
+    return nullptr;
+  }
+
+  std::unique_ptr<SegmentedFile> storage(
+      new SegmentedFile(path, segment_size, sync_policy));
+  if (not storage->recover(mode)) {
+    log_->error("Recovery of {} - failed", path);
+    return nullptr;
+  }
+  return storage;
+}
+
+bool SegmentedFile::add(Identifier id, const std::vector<uint8_t> &blob) {
+  std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+  if (id != current_id_ + 1) {
+    log_->warn("Cannot append non-consecutive block");
+    return false;
+  }
+  if (blob.size() > std::numeric_limits<uint32_t>::max()) {
+    log_->warn("insertion for {} failed, block is too large", id);
+    return false;
+  }
+
+  if (segments_.empty()
+      or (segments_.back().size > 0
+          and segments_.back().size + RECORD_HEADER_SIZE + blob.size()
+              > segment_size_)) {
+    // pending blocks of the previous segment are synced before switching
+    if (sync_policy_.mode == SyncMode::GROUP) {
+      syncPending();
+    }
+    if (not openSegment(id)) {
+      return false;
+    }
+  }
+  auto &segment = segments_.back();
+  const auto offset = segment.size;
+
+  uint8_t header[RECORD_HEADER_SIZE];
+  encode32(header, id);
+  encode32(header + 4, blob.size());
+  encode32(header + 8, checksum(blob.data(), blob.size()));
+
+  uint8_t index_entry[INDEX_ENTRY_SIZE];
+  encode64(index_entry, offset);
+
+  if (not write_all(segment.fd, header, RECORD_HEADER_SIZE, offset)
+      or not write_all(segment.fd,
+                       blob.data(),
+                       blob.size(),
+                       offset + RECORD_HEADER_SIZE)
+      or not write_all(index_fd_,
+                       index_entry,
+                       INDEX_ENTRY_SIZE,
+                       segment.offsets.size() * INDEX_ENTRY_SIZE)) {
+    log_->error("insertion for {} failed: {}", id, std::strerror(errno));
+    // drop partially written record, it will be overwritten by next insertion
+    if (::ftruncate(segment.fd, offset) != 0) {
+      log_->error("cannot truncate segment {}", segment.first_id);
+    }
+    return false;
+  }
+
+  segment.offsets.push_back(offset);
+  segment.size = offset + RECORD_HEADER_SIZE + blob.size();
+  current_id_ = id;
+
+  if (id - checkpoint_id_ >= CHECKPOINT_INTERVAL) {
+    writeManifest();
+  } else if (sync_policy_.mode == SyncMode::EACH_BLOCK) {
+    syncActive();
+  } else if (sync_policy_.mode == SyncMode::GROUP) {
+    bool group_is_full;
+    {
+      std::lock_guard<std::mutex> lock(flush_lock_);
+      if (unsynced_++ == 0) {
+        first_unsynced_ = std::chrono::steady_clock::now();
+      }
+      group_is_full = unsynced_ >= sync_policy_.group_size;
+    }
+    if (group_is_full) {
+      syncActive();
+    } else {
+      flush_cv_.notify_one();
+    }
+  }
+  return true;
+}
+
+nonstd::optional<std::vector<uint8_t>> SegmentedFile::get(Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  uint64_t offset, size;
+  auto segment = locate(id, offset, size);
+  if (not segment) {
+    log_->info("get({}) block not found", id);
+    return nonstd::nullopt;
+  }
+
+  std::vector<uint8_t> buf(size);
+  if (not read_all(segment->fd, buf.data(), buf.size(), offset)) {
+    log_->info("get({}) problem with reading segment", id);
+    return nonstd::nullopt;
+  }
+  return buf;
+}
+
+nonstd::optional<BlobView> SegmentedFile::view(Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+  uint64_t offset, size;
+  auto segment = locate(id, offset, size);
+  if (not segment) {
+    log_->info("view({}) block not found", id);
+    return nonstd::nullopt;
+  }
+
+  std::shared_ptr<const Mapping> mapping;
+  {
+    std::lock_guard<std::mutex> lock(mapping_lock_);
+    if (not segment->mapping or segment->mapping->size < offset + size) {
+      auto data =
+          ::mmap(nullptr, segment->size, PROT_READ, MAP_SHARED, segment->fd, 0);
+      if (data == MAP_FAILED) {
+        log_->error("view({}) cannot map segment {}: {}",
+                    id,
+                    segment->first_id,
+                    std::strerror(errno));
+        return nonstd::nullopt;
+      }
+      // views of the previous mapping keep it alive until they are released
+      const_cast<Segment *>(segment)->mapping = std::make_shared<Mapping>(
+          static_cast<const uint8_t *>(data), segment->size);
+    }
+    mapping = segment->mapping;
+  }
+  return BlobView(mapping, mapping->data + offset, size);
+}
+
+std::string SegmentedFile::directory() const {
+  return dump_dir_;
+}
+
+Identifier SegmentedFile::last_id() const {
+  return current_id_.load();
+}
+
+void SegmentedFile::dropAll() {
+  std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+  std::vector<Identifier> first_ids;
+  for (const auto &segment : segments_) {
+    first_ids.push_back(segment.first_id);
+  }
+  closeSegments();
+  // only own files are removed, folder may be shared with other storages
+  for (auto id : first_ids) {
+    boost::filesystem::remove(segmentPath(id));
+    boost::filesystem::remove(indexPath(id));
+  }
+  boost::filesystem::remove(manifestPath());
+  current_id_.store(0);
+  checkpoint_id_ = 0;
+  std::lock_guard<std::mutex> lock(flush_lock_);
+  unsynced_ = 0;
+}
+
+bool SegmentedFile::checkpoint() {
+  std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+  return writeManifest();
+}
+
+size_t SegmentedFile::syncs() const {
+  return syncs_.load();
+}
+
+std::chrono::microseconds SegmentedFile::syncTime() const {
+  return std::chrono::microseconds(sync_time_us_.load());
+}
+
+std::chrono::microseconds SegmentedFile::maxSyncTime() const {
+  return std::chrono::microseconds(max_sync_time_us_.load());
+}
+
+SegmentedFile::~SegmentedFile() {
+  if (flusher_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(flush_lock_);
+      stopping_ = true;
+    }
+    flush_cv_.notify_one();
+    flusher_.join();
+  }
+  // checkpoint also syncs pending blocks
+  if (current_id_ != checkpoint_id_) {
+    writeManifest();
+  }
+  closeSegments();
+}
+
+// ----------| private API |----------
+
+SegmentedFile::Mapping::Mapping(const uint8_t *data, size_t size)
+    : data(data), size(size) {}
+
+SegmentedFile::Mapping::~Mapping() {
+  ::munmap(const_cast<uint8_t *>(data), size);
+}
+
+SegmentedFile::SegmentedFile(const std::string &path,
+                             uint64_t segment_size,
+                             SyncPolicy sync_policy)
+    : dump_dir_(path),
+      segment_size_(segment_size),
+      index_fd_(-1),
+      current_id_(0),
+      checkpoint_id_(0),
+      sync_policy_(sync_policy),
+      unsynced_(0),
+      stopping_(false),
+      syncs_(0),
+      sync_time_us_(0),
+      max_sync_time_us_(0),
+      log_(logger::log("SegmentedFile")) {
+  if (sync_policy_.mode == SyncMode::GROUP) {
+    flusher_ = std::thread(&SegmentedFile::flushLoop, this);
+  }
+}
+
+bool SegmentedFile::recover(RecoveryMode mode) {
+  std::vector<Identifier> ids;
+  for (const auto &entry : boost::filesystem::directory_iterator{dump_dir_}) {
+    const auto &path = entry.path();
+    if (path.extension() != SEGMENT_EXTENSION) {
+      continue;
+    }
+    if (auto id = name_to_id(path.stem().string())) {
+      ids.push_back(*id);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+
+  if (ids.empty()) {
+    boost::filesystem::remove(manifestPath());
+    importFlatFiles();
+    return true;
+  }
+
+  const auto trusted = mode == RecoveryMode::CHECKPOINT;
+  nonstd::optional<Manifest> manifest;
+  if (trusted) {
+    manifest = readManifest();
+  }
+  auto restored = false;
+  Identifier expected = 1;
+  for (auto it = ids.begin(); it != ids.end(); ++it) {
+    if (*it != expected) {
+      log_->warn("segment {} does not follow block {}, dropping the rest",
+                 *it,
+                 expected - 1);
+      std::for_each(it, ids.end(), [this](auto id) {
+        boost::filesystem::remove(this->segmentPath(id));
+        boost::filesystem::remove(this->indexPath(id));
+      });
+      break;
+    }
+
+    auto fd = ::open(segmentPath(*it).c_str(), O_RDWR);
+    if (fd < 0) {
+      log_->error("Cannot open segment {}: {}", *it, std::strerror(errno));
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      log_->error("Cannot stat segment {}: {}", *it, std::strerror(errno));
+      return false;
+    }
+    segments_.push_back(Segment{*it, fd, static_cast<uint64_t>(st.st_size), {}});
+
+    auto &segment = segments_.back();
+    // only the last segment may contain a torn write, it is verified
+    // starting from the checkpoint
+    auto is_last = std::next(it) == ids.end();
+    if (is_last or not trusted or not loadIndex(segment)) {
+      restored = is_last and manifest
+          and restoreFromManifest(segment, *manifest);
+      if (not rescan(segment, restored ? manifest->end : 0)) {
+        return false;
+      }
+    }
+    expected = segment.first_id + segment.offsets.size();
+  }
+
+  if (restored) {
+    checkpoint_id_ = manifest->last_id;
+  } else {
+    // stale checkpoint is replaced by the next one
+    boost::filesystem::remove(manifestPath());
+  }
+
+  if (not segments_.empty()) {
+    index_fd_ = ::open(indexPath(segments_.back().first_id).c_str(),
+                       O_WRONLY | O_CREAT,
+                       0644);
+    if (index_fd_ < 0) {
+      log_->error("Cannot open index of segment {}: {}",
+                  segments_.back().first_id,
+                  std::strerror(errno));
+      return false;
+    }
+  }
+  current_id_.store(expected - 1);
+  return true;
+}
+
+bool SegmentedFile::rescan(Segment &segment, uint64_t from) {
+  auto offsets = std::move(segment.offsets);
+  std::vector<uint8_t> payload;
+  uint8_t header[RECORD_HEADER_SIZE];
+  uint64_t offset = from;
+  while (offset + RECORD_HEADER_SIZE <= segment.size
+         and read_all(segment.fd, header, RECORD_HEADER_SIZE, offset)) {
+    auto id = decode32(header);
+    auto size = decode32(header + 4);
+    if (id != segment.first_id + offsets.size()
+        or offset + RECORD_HEADER_SIZE + size > segment.size) {
+      break;
+    }
+    payload.resize(size);
+    if (not read_all(segment.fd, payload.data(), size, offset + RECORD_HEADER_SIZE)
+        or checksum(payload.data(), size) != decode32(header + 8)) {
+      break;
+    }
+    offsets.push_back(offset);
+    offset += RECORD_HEADER_SIZE + size;
+  }
+
+  if (offset != segment.size) {
+    log_->warn("segment {}: truncating torn tail of {} bytes",
+               segment.first_id,
+               segment.size - offset);
+    if (::ftruncate(segment.fd, offset) != 0) {
+      log_->error("Cannot truncate segment {}: {}",
+                  segment.first_id,
+                  std::strerror(errno));
+      return false;
+    }
+    segment.size = offset;
+  }
+
+  std::vector<uint8_t> raw(offsets.size() * INDEX_ENTRY_SIZE);
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    encode64(raw.data() + i * INDEX_ENTRY_SIZE, offsets[i]);
+  }
+  segment.offsets = std::move(offsets);
+
+  auto fd = ::open(
+      indexPath(segment.first_id).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    log_->error("Cannot rewrite index of segment {}: {}",
+                segment.first_id,
+                std::strerror(errno));
+    return false;
+  }
+  auto written = write_all(fd, raw.data(), raw.size(), 0);
+  ::close(fd);
+  return written;
+}
+
+bool SegmentedFile::loadIndex(Segment &segment) {
+  auto index = readIndex(segment.first_id);
+  if (not index) {
+    return false;
+  }
+  auto &offsets = *index;
+  if (offsets.empty()) {
+    return segment.size == 0;
+  }
+
+  // the last indexed record has to end exactly at the end of segment
+  uint8_t header[RECORD_HEADER_SIZE];
+  if (offsets.back() + RECORD_HEADER_SIZE > segment.size
+      or not read_all(segment.fd, header, RECORD_HEADER_SIZE, offsets.back())
+      or decode32(header) != segment.first_id + offsets.size() - 1
+      or offsets.back() + RECORD_HEADER_SIZE + decode32(header + 4)
+          != segment.size) {
+    return false;
+  }
+  segment.offsets = std::move(offsets);
+  return true;
+}
+
+nonstd::optional<std::vector<uint64_t>> SegmentedFile::readIndex(
+    Identifier first_id, nonstd::optional<size_t> count) const {
+  auto fd = ::open(indexPath(first_id).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nonstd::nullopt;
+  }
+  struct stat st;
+  std::vector<uint8_t> raw;
+  auto loaded = ::fstat(fd, &st) == 0;
+  if (loaded) {
+    const auto size = static_cast<uint64_t>(st.st_size);
+    // torn entry after the requested ones does not matter
+    loaded = count ? size >= *count * INDEX_ENTRY_SIZE
+                   : size % INDEX_ENTRY_SIZE == 0;
+    raw.resize(count ? *count * INDEX_ENTRY_SIZE : size);
+  }
+  if (loaded) {
+    loaded = read_all(fd, raw.data(), raw.size(), 0);
+  }
+  ::close(fd);
+  if (not loaded) {
+    return nonstd::nullopt;
+  }
+
+  std::vector<uint64_t> offsets(raw.size() / INDEX_ENTRY_SIZE);
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    offsets[i] = decode64(raw.data() + i * INDEX_ENTRY_SIZE);
+    auto previous_end = i == 0 ? 0 : offsets[i - 1] + RECORD_HEADER_SIZE;
+    if (offsets[i] < previous_end or (i == 0 and offsets[i] != 0)) {
+      return nonstd::nullopt;
+    }
+  }
+  return offsets;
+}
+
+nonstd::optional<SegmentedFile::Manifest> SegmentedFile::readManifest()
+    const {
+  auto fd = ::open(manifestPath().c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nonstd::nullopt;
+  }
+  uint8_t raw[MANIFEST_SIZE];
+  struct stat st;
+  auto loaded = ::fstat(fd, &st) == 0
+      and static_cast<uint64_t>(st.st_size) == MANIFEST_SIZE
+      and read_all(fd, raw, MANIFEST_SIZE, 0);
+  ::close(fd);
+  if (not loaded or decode32(raw) != MANIFEST_VERSION
+      or decode32(raw + 32) != checksum(raw, 32)) {
+    log_->warn("manifest is damaged, ignoring it");
+    return nonstd::nullopt;
+  }
+  return Manifest{decode32(raw + 4),
+                  decode32(raw + 8),
+                  decode64(raw + 12),
+                  decode64(raw + 20),
+                  decode32(raw + 28)};
+}
+
+bool SegmentedFile::restoreFromManifest(Segment &segment,
+                                        const Manifest &manifest) {
+  if (manifest.first_id != segment.first_id
+      or manifest.last_id < manifest.first_id
+      or manifest.end > segment.size) {
+    return false;
+  }
+  const size_t count = manifest.last_id - manifest.first_id + 1;
+  auto index = readIndex(segment.first_id, count);
+  if (not index) {
+    return false;
+  }
+  auto &offsets = *index;
+
+  uint8_t header[RECORD_HEADER_SIZE];
+  uint32_t tail_crc;
+  if (offsets[count - std::min(count, CHECKPOINT_TAIL)] != manifest.tail
+      or offsets.back() + RECORD_HEADER_SIZE > manifest.end
+      or not read_all(segment.fd, header, RECORD_HEADER_SIZE, offsets.back())
+      or decode32(header) != manifest.last_id
+      or offsets.back() + RECORD_HEADER_SIZE + decode32(header + 4)
+          != manifest.end
+      or not checksum_range(segment.fd, manifest.tail, manifest.end, tail_crc)
+      or tail_crc != manifest.tail_crc) {
+    log_->warn("segment {} does not match manifest", segment.first_id);
+    return false;
+  }
+  segment.offsets = std::move(offsets);
+  log_->info("blocks up to {} restored from manifest", manifest.last_id);
+  return true;
+}
+
+bool SegmentedFile::writeManifest() {
+  if (segments_.empty() or segments_.back().offsets.empty()) {
+    return true;
+  }
+  const auto &segment = segments_.back();
+  // checkpoint may cover only data which is already on disk
+  if (not syncActive()) {
+    return false;
+  }
+
+  const auto count = segment.offsets.size();
+  const auto last_id = segment.first_id + count - 1;
+  const auto tail = segment.offsets[count - std::min(count, CHECKPOINT_TAIL)];
+  uint32_t tail_crc;
+  if (not checksum_range(segment.fd, tail, segment.size, tail_crc)) {
+    log_->error("Cannot read tail of segment {}", segment.first_id);
+    return false;
+  }
+
+  uint8_t raw[MANIFEST_SIZE];
+  encode32(raw, MANIFEST_VERSION);
+  encode32(raw + 4, segment.first_id);
+  encode32(raw + 8, last_id);
+  encode64(raw + 12, segment.size);
+  encode64(raw + 20, tail);
+  encode32(raw + 28, tail_crc);
+  encode32(raw + 32, checksum(raw, 32));
+
+  // manifest is replaced atomically, so a crash leaves the previous one
+  const auto temp_path = manifestPath() + ".tmp";
+  auto fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    log_->error("Cannot create manifest: {}", std::strerror(errno));
+    return false;
+  }
+  auto written = write_all(fd, raw, MANIFEST_SIZE, 0) and ::fsync(fd) == 0;
+  ::close(fd);
+  if (not written
+      or ::rename(temp_path.c_str(), manifestPath().c_str()) != 0) {
+    log_->error("Cannot write manifest: {}", std::strerror(errno));
+    return false;
+  }
+  checkpoint_id_ = last_id;
+  return true;
+}
+
+bool SegmentedFile::syncActive() {
+  {
+    std::lock_guard<std::mutex> lock(flush_lock_);
+    unsynced_ = 0;
+  }
+  if (segments_.empty()) {
+    return true;
+  }
+  const auto &segment = segments_.back();
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto synced = ::fsync(segment.fd) == 0 and ::fsync(index_fd_) == 0;
+  const uint64_t elapsed =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  ++syncs_;
+  sync_time_us_ += elapsed;
+  auto max = max_sync_time_us_.load();
+  while (elapsed > max
+         and not max_sync_time_us_.compare_exchange_weak(max, elapsed)) {
+  }
+
+  if (not synced) {
+    log_->error("Cannot sync segment {}: {}",
+                segment.first_id,
+                std::strerror(errno));
+  }
+  return synced;
+}
+
+bool SegmentedFile::syncPending() {
+  {
+    std::lock_guard<std::mutex> lock(flush_lock_);
+    if (unsynced_ == 0) {
+      return true;
+    }
+  }
+  return syncActive();
+}
+
+void SegmentedFile::flushLoop() {
+  std::unique_lock<std::mutex> lock(flush_lock_);
+  while (not stopping_) {
+    if (unsynced_ == 0) {
+      flush_cv_.wait(lock);
+      continue;
+    }
+    const auto deadline = first_unsynced_ + sync_policy_.group_delay;
+    if (std::chrono::steady_clock::now() < deadline) {
+      flush_cv_.wait_until(lock, deadline);
+      continue;
+    }
+    lock.unlock();
+    {
+      // appends wait until the sync is finished, readers do not
+      std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+      syncPending();
+    }
+    lock.lock();
+  }
+}
+
+void SegmentedFile::importFlatFiles() {
+  Identifier id = 1;
+  for (;; ++id) {
+    const auto file_name = boost::filesystem::path{dump_dir_} / id_to_name(id);
+    if (not boost::filesystem::is_regular_file(file_name)) {
+      break;
+    }
+    std::vector<uint8_t> blob(boost::filesystem::file_size(file_name));
+    boost::filesystem::ifstream file(file_name, std::ifstream::binary);
+    file.read(reinterpret_cast<char *>(blob.data()), blob.size());
+    if (not file) {
+      log_->error("Cannot read legacy block {}", id);
+      break;
+    }
+    add(id, blob);
+    if (last_id() != id) {
+      break;
+    }
+  }
+  if (id == 1) {
+    return;
+  }
+
+  // imported blocks have to reach the disk before legacy files are removed
+  for (const auto &segment : segments_) {
+    ::fsync(segment.fd);
+  }
+  ::fsync(index_fd_);
+
+  log_->info("{} blocks imported from legacy layout", last_id());
+  std::vector<boost::filesystem::path> legacy;
+  std::copy_if(boost::filesystem::directory_iterator{dump_dir_},
+               boost::filesystem::directory_iterator{},
+               std::back_inserter(legacy),
+               [](const boost::filesystem::path &p) {
+                 return bool(name_to_id(p.filename().string()));
+               });
+  std::for_each(legacy.begin(),
+                legacy.end(),
+                [](const boost::filesystem::path &p) {
+                  boost::filesystem::remove(p);
+                });
+}
+
+bool SegmentedFile::openSegment(Identifier first_id) {
+  auto fd = ::open(
+      segmentPath(first_id).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    log_->error("Cannot create segment {}: {}", first_id, std::strerror(errno));
+    return false;
+  }
+  auto index_fd = ::open(
+      indexPath(first_id).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (index_fd < 0) {
+    log_->error("Cannot create index of segment {}: {}",
+                first_id,
+                std::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+  if (index_fd_ >= 0) {
+    ::close(index_fd_);
+  }
+  index_fd_ = index_fd;
+  segments_.push_back(Segment{first_id, fd, 0, {}});
+  return true;
+}
+
+const SegmentedFile::Segment *SegmentedFile::locate(Identifier id,
+                                                    uint64_t &offset,
+                                                    uint64_t &size) const {
+  if (id == 0 or id > current_id_) {
+    return nullptr;
+  }
+
+  // segments are sorted by first key, and the first one starts with key 1
+  auto segment = std::prev(std::upper_bound(
+      segments_.begin(),
+      segments_.end(),
+      id,
+      [](Identifier id, const Segment &s) { return id < s.first_id; }));
+  const auto index = id - segment->first_id;
+  const auto end = index + 1 < segment->offsets.size()
+      ? segment->offsets[index + 1]
+      : segment->size;
+  offset = segment->offsets.at(index) + RECORD_HEADER_SIZE;
+  size = end - offset;
+  return &*segment;
+}
+
+void SegmentedFile::closeSegments() {
+  for (const auto &segment : segments_) {
+    ::close(segment.fd);
+  }
+  segments_.clear();
+  if (index_fd_ >= 0) {
+    ::close(index_fd_);
+    index_fd_ = -1;
+  }
+}
+
+std::string SegmentedFile::segmentPath(Identifier first_id) const {
+  return (boost::filesystem::path{dump_dir_}
+          / (id_to_name(first_id) + SEGMENT_EXTENSION))
+      .string();
+}
+
+std::string SegmentedFile::indexPath(Identifier first_id) const {
+  return (boost::filesystem::path{dump_dir_}
+          / (id_to_name(first_id) + INDEX_EXTENSION))
+      .string();
+}
+
+std::string SegmentedFile::manifestPath() const {
+  return (boost::filesystem::path{dump_dir_} / MANIFEST_NAME).string();
+}
@@ -0,0 +1,387 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SEGMENTED_FILE_HPP
+#define IROHA_SEGMENTED_FILE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "ametsuchi/key_value_storage.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * When appended blocks are synced to disk
+     */
+    enum class SyncMode {
+      NONE,        // rely on page cache, segments are synced by checkpoints
+      EACH_BLOCK,  // fsync every block before add returns
+      GROUP        // fsync once per group of blocks or time interval
+    };
+
+    /**
+     * Durability settings of block store
+     */
+    struct SyncPolicy {
+      SyncMode mode = SyncMode::NONE;
+      /// maximal number of blocks synced together in group mode
+      uint32_t group_size = 64;
+      /// maximal time a block stays unsynced in group mode
+      std::chrono::milliseconds group_delay{100};
+    };
+
+    /**
+     * Append-only block log, which keeps many blocks in one segment file.
+     *
+     * Each segment consists of two files named by the first key stored in
+     * the segment:
+     *  - "<first id>.seg" - sequence of records, every record is a header
+     *    (key, payload size, crc32 of payload) followed by the payload;
+     *  - "<first id>.idx" - offsets of records in the segment, 8 bytes each.
+     * New segment is started when the current one exceeds segment size.
+     * Views of blocks point directly into read-only memory mappings of
+     * segments, so reading them does not copy the data.
+     *
+     * Storage folder also contains "MANIFEST" - checkpoint with the last
+     * block synced to disk and checksum of records before it. On startup
+     * only blocks appended after the checkpoint are verified.
+     */
+    class SegmentedFile : public KeyValueStorage {
+     public:
+      // ----------| public API |----------
+
+      /**
+       * Default maximal size of one segment in bytes
+       */
+      static constexpr uint64_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+      /**
+       * Size of record header in segment file
+       */
+      static constexpr uint64_t RECORD_HEADER_SIZE = 12;
+
+      /**
+       * Number of appended blocks after which checkpoint is persisted
+       */
+      static constexpr Identifier CHECKPOINT_INTERVAL = 1024;
+
+      /**
+       * Number of the last records covered by checksum in checkpoint
+       */
+      static constexpr size_t CHECKPOINT_TAIL = 16;
+
+      /**
+       * Way of restoring state of storage on startup
+       */
+      enum class RecoveryMode {
+        /// trust blocks covered by checkpoint, verify only the rest
+        CHECKPOINT,
+        /// verify checksums of all blocks in all segments, used for repair
+        FULL_SCAN
+      };
+
+      /**
+       * Create storage in path, recovering state from existing segments.
+       * Torn tail of the last segment is truncated, blocks stored in the
+       * legacy one-file-per-block layout are imported
+       * @param path - target path for creating
+       * @param segment_size - maximal size of one segment in bytes
+       * @param mode - how much of existing segments is verified
+       * @param sync_policy - when appended blocks are synced to disk
+       * @return created storage, nullptr on failure
+       */
+      static std::unique_ptr<SegmentedFile> create(
+          const std::string &path,
+          uint64_t segment_size = DEFAULT_SEGMENT_SIZE,
+          RecoveryMode mode = RecoveryMode::CHECKPOINT,
+          SyncPolicy sync_policy = SyncPolicy());
+
+      bool add(Identifier id, const std::vector<uint8_t> &blob) override;
+
+      nonstd::optional<std::vector<uint8_t>> get(
+          Identifier id) const override;
+
+      nonstd::optional<BlobView> view(Identifier id) const override;
+
+      std::string directory() const override;
+
+      Identifier last_id() const override;
+
+      void dropAll() override;
+
+      /**
+       * Sync segments to disk and persist checkpoint with the last block.
+       * Called periodically by add and on destruction
+       * @return true on success
+       */
+      bool checkpoint();
+
+      /**
+       * @return number of fsync calls on segments
+       */
+      size_t syncs() const;
+
+      /**
+       * @return total time spent in syncing segments
+       */
+      std::chrono::microseconds syncTime() const;
+
+      /**
+       * @return the longest time of one segment sync
+       */
+      std::chrono::microseconds maxSyncTime() const;
+
+      SegmentedFile(const SegmentedFile &rhs) = delete;
+
+      SegmentedFile(SegmentedFile &&rhs) = delete;
+
+      SegmentedFile &operator=(const SegmentedFile &rhs) = delete;
+
+      SegmentedFile &operator=(SegmentedFile &&rhs) = delete;
+
+      ~SegmentedFile() override;
+
+     private:
+      /**
+       * Read-only memory mapping of segment file, unmapped on destruction
+       */
+      struct Mapping {
+        Mapping(const uint8_t *data, size_t size);
+
+        ~Mapping();
+
+        const uint8_t *data;
+        size_t size;
+      };
+
+      /**
+       * Opened segment with its offset index
+       */
+      struct Segment {
+        /// key of the first record in segment
+        Identifier first_id;
+        /// descriptor of segment file
+        int fd;
+        /// size of valid data in segment file
+        uint64_t size;
+        /// offsets of records in segment file
+        std::vector<uint64_t> offsets;
+        /// mapping of the segment, shared with views; the active segment is
+        /// remapped when a record beyond the mapping is requested
+        std::shared_ptr<const Mapping> mapping;
+      };
+
+      /**
+       * Persisted checkpoint of the last segment
+       */
+      struct Manifest {
+        /// key of the first record in segment
+        Identifier first_id;
+        /// key of the last record synced to disk
+        Identifier last_id;
+        /// size of segment file with the last record
+        uint64_t end;
+        /// offset of the first record covered by checksum
+        uint64_t tail;
+        /// crc32 of segment data from tail to end
+        uint32_t tail_crc;
+      };
+
+      SegmentedFile(const std::string &path,
+                    uint64_t segment_size,
+                    SyncPolicy sync_policy);
+
+      /**
+       * Open all segments from storage folder, validate them and drop
+       * inconsistent ones
+       * @param mode - how much of existing segments is verified
+       * @return true if storage folder is usable
+       */
+      bool recover(RecoveryMode mode);
+
+      /**
+       * Rebuild offsets of the segment by reading records from it.
+       * Segment is truncated after the last valid record
+       * @param segment - segment to be scanned, its offsets contain already
+       * verified records
+       * @param from - end of verified records, where scanning starts
+       * @return true if index file was rewritten successfully
+       */
+      bool rescan(Segment &segment, uint64_t from = 0);
+
+      /**
+       * Load offsets of the segment from its index file
+       * @param segment - segment to be filled
+       * @return true if index file is consistent with segment file
+       */
+      bool loadIndex(Segment &segment);
+
+      /**
+       * Read ordered offsets of records from index file of the segment
+       * @param first_id - key of the first record in segment
+       * @param count - number of leading entries, all entries if not set
+       * @return offsets, if index file contains them
+       */
+      nonstd::optional<std::vector<uint64_t>> readIndex(
+          Identifier first_id,
+          nonstd::optional<size_t> count = nonstd::nullopt) const;
+
+      /**
+       * Read checkpoint from storage folder
+       * @return checkpoint, if it is present and intact
+       */
+      nonstd::optional<Manifest> readManifest() const;
+
+      /**
+       * Load offsets of records covered by checkpoint
+       * @param segment - the last segment to be filled
+       * @param manifest - checkpoint of the segment
+       * @return true if segment still matches checkpoint
+       */
+      bool restoreFromManifest(Segment &segment, const Manifest &manifest);
+
+      /**
+       * Sync the last segment and replace checkpoint with it.
+       * Write lock has to be held by caller
+       * @return true on success
+       */
+      bool writeManifest();
+
+      /**
+       * Sync the last segment and its index to disk, recording latency.
+       * Lock has to be held by caller
+       * @return true on success
+       */
+      bool syncActive();
+
+      /**
+       * Sync the last segment, if it has unsynced blocks.
+       * Lock has to be held by caller
+       * @return true on success
+       */
+      bool syncPending();
+
+      /**
+       * Sync groups of blocks which are not filled in time, runs in
+       * a separate thread in group mode
+       */
+      void flushLoop();
+
+      /**
+       * Move blocks from legacy one-file-per-block layout to segments
+       */
+      void importFlatFiles();
+
+      /**
+       * Create empty segment starting with given key and make it active
+       * @param first_id - key of the first record in segment
+       * @return true on success
+       */
+      bool openSegment(Identifier first_id);
+
+      /**
+       * Find location of the record in segments
+       * @param id - key of the record
+       * @param[out] offset - offset of payload in segment file
+       * @param[out] size - size of payload
+       * @return segment with the record, nullptr if there is no such record
+       */
+      const Segment *locate(Identifier id,
+                            uint64_t &offset,
+                            uint64_t &size) const;
+
+      /**
+       * Close all descriptors and forget about segments
+       */
+      void closeSegments();
+
+      std::string segmentPath(Identifier first_id) const;
+
+      std::string indexPath(Identifier first_id) const;
+
+      std::string manifestPath() const;
+
+      // ----------| private fields |----------
+
+      /**
+       * Folder of storage
+       */
+      const std::string dump_dir_;
+
+      /**
+       * Maximal size of one segment in bytes
+       */
+      const uint64_t segment_size_;
+
+      /**
+       * Segments ordered by first key, the last one is active for writing
+       */
+      std::vector<Segment> segments_;
+
+      /**
+       * Descriptor of index file of the active segment
+       */
+      int index_fd_;
+
+      /**
+       * Last written key
+       */
+      std::atomic<Identifier> current_id_;
+
+      /**
+       * Last key covered by persisted checkpoint
+       */
+      Identifier checkpoint_id_;
+
+      const SyncPolicy sync_policy_;
+
+      // state of group commit, guarded by flush_lock_
+      uint32_t unsynced_;
+      std::chrono::steady_clock::time_point first_unsynced_;
+      bool stopping_;
+      std::mutex flush_lock_;
+      std::condition_variable flush_cv_;
+      std::thread flusher_;
+
+      std::atomic<size_t> syncs_;
+      std::atomic<uint64_t> sync_time_us_;
+      std::atomic<uint64_t> max_sync_time_us_;
+
+      // Allows multiple readers and a single writer
+      mutable std::shared_timed_mutex rw_lock_;
+
+      // Serializes creation of mappings by concurrent readers
+      mutable std::mutex mapping_lock_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_SEGMENTED_FILE_HPP
@@ -17,11 +17,18 @@
 
 #include "ametsuchi/impl/storage_impl.hpp"
 
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+#include "ametsuchi/impl/embedded_block_index.hpp"
+#include "ametsuchi/impl/embedded_block_query.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_mutable_storage.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_temporary_wsv.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_query.hpp"
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
+#include "ametsuchi/impl/overlay_temporary_wsv.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "ametsuchi/impl/redis_block_index.hpp"
 #include "ametsuchi/impl/redis_block_query.hpp"
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
-#include "model/converters/json_common.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -31,90 +38,171 @@ namespace iroha {
         std::string redis_host,
         std::size_t redis_port,
         std::string postgres_options,
-        std::unique_ptr<FlatFile> block_store,
+        std::unique_ptr<KeyValueStorage> block_store,
         std::unique_ptr<cpp_redis::client> index,
+        std::unique_ptr<EmbeddedIndex> embedded_index,
         std::unique_ptr<pqxx::lazyconnection> wsv_connection,
-        std::unique_ptr<pqxx::nontransaction> wsv_transaction)
+        std::unique_ptr<pqxx::nontransaction> wsv_transaction,
+        std::shared_ptr<model::CommandExecutorFactory> command_executors,
+        const StorageOptions &options)
         : block_store_dir_(std::move(block_store_dir)),
           redis_host_(std::move(redis_host)),
           redis_port_(redis_port),
           postgres_options_(std::move(postgres_options)),
           block_store_(std::move(block_store)),
           index_(std::move(index)),
+          embedded_index_(std::move(embedded_index)),
           wsv_connection_(std::move(wsv_connection)),
           wsv_transaction_(std::move(wsv_transaction)),
-          wsv_(std::make_shared<PostgresWsvQuery>(*wsv_transaction_)),
-          blocks_(std::make_shared<RedisBlockQuery>(*index_, *block_store_)) {
+          wsv_cache_(std::make_shared<WsvCache>(options.wsv_cache_entries)),
+          embedded_wsv_(options.wsv == WsvType::EMBEDDED
+                            ? std::make_shared<EmbeddedWsv>()
+                            : nullptr),
+          command_executors_(std::move(command_executors)),
+          block_cache_(
+              std::make_shared<BlockCache>(options.block_cache_budget)),
+          temporary_wsv_type_(options.temporary_wsv) {
       log_ = logger::log("StorageImpl");
 
-      wsv_transaction_->exec(init_);
-      wsv_transaction_->exec(
-          "SET SESSION CHARACTERISTICS AS TRANSACTION READ ONLY;");
+      if (embedded_wsv_) {
+        wsv_ = std::make_shared<EmbeddedWsvQuery>(*embedded_wsv_);
+      } else {
+        wsv_ = std::make_shared<CachedWsvQuery>(
+            std::make_unique<PostgresWsvQuery>(*wsv_transaction_),
+            wsv_cache_,
+            std::make_shared<WsvCache::Keys>());
+        pg_pool_ = ConnectionPool<pqxx::lazyconnection>::create(
+            [postgres_options = postgres_options_,
+             log = log_]() -> std::unique_ptr<pqxx::lazyconnection> {
+              auto connection =
+                  std::make_unique<pqxx::lazyconnection>(postgres_options);
+              try {
+                connection->activate();
+              } catch (const pqxx::broken_connection &e) {
+                log->error("Connection to PostgreSQL broken: {}", e.what());
+                return nullptr;
+              }
+              return connection;
+            },
+            [](pqxx::lazyconnection &connection) {
+              return connection.is_open();
+            },
+            [log = log_](pqxx::lazyconnection &connection) {
+              // transactions are finished by storages, only session is reset
+              try {
+                pqxx::nontransaction reset(connection, "Reset");
+                reset.exec("RESET ALL;");
+              } catch (const std::exception &e) {
+                log->warn("Dropping PostgreSQL connection: {}", e.what());
+                return false;
+              }
+              return true;
+            },
+            options.connection_pool_size);
+      }
+
+      if (not embedded_index_) {
+        redis_pool_ = ConnectionPool<cpp_redis::client>::create(
+            [redis_host = redis_host_,
+             redis_port = redis_port_,
+             log = log_]() -> std::unique_ptr<cpp_redis::client> {
+              auto client = std::make_unique<cpp_redis::client>();
+              try {
+                client->connect(redis_host, redis_port);
+              } catch (const cpp_redis::redis_error &e) {
+                log->error("Connection to Redis broken: {}", e.what());
+                return nullptr;
+              }
+              return client;
+            },
+            [](cpp_redis::client &client) { return client.is_connected(); },
+            // MULTI is finished by block index on commit or discard
+            [](cpp_redis::client &client) { return client.is_connected(); },
+            options.connection_pool_size);
+      }
+
+      if (embedded_index_) {
+        reindexTail();
+        blocks_ = std::make_shared<EmbeddedBlockQuery>(
+            *embedded_index_, *block_store_, block_cache_);
+      } else {
+        backfillBlockHashes();
+        blocks_ = std::make_shared<RedisBlockQuery>(
+            *index_, *block_store_, block_cache_);
+      }
+
+      if (embedded_wsv_) {
+        restoreEmbeddedWsv();
+      } else {
+        wsv_transaction_->exec(init_);
+        wsv_transaction_->exec(
+            "SET SESSION CHARACTERISTICS AS TRANSACTION READ ONLY;");
+      }
     }
 
     std::unique_ptr<TemporaryWsv> StorageImpl::createTemporaryWsv() {
-      auto command_executors = model::CommandExecutorFactory::create();
-      if (not command_executors.has_value()) {
-        log_->error("Cannot create CommandExecutorFactory");
-        return nullptr;
+      if (embedded_wsv_) {
+        return std::make_unique<EmbeddedTemporaryWsv>(embedded_wsv_->snapshot(),
+                                                      command_executors_);
       }
 
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        log_->error("Connection to PostgreSQL broken: {}", e.what());
+      auto postgres_connection = pg_pool_->acquire();
+      if (not postgres_connection) {
+        log_->error("Cannot get connection to PostgreSQL");
         return nullptr;
       }
       auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
           *postgres_connection, "TemporaryWsv");
 
-      return std::make_unique<TemporaryWsvImpl>(
-          std::move(postgres_connection),
-          std::move(wsv_transaction),
-          std::move(command_executors.value()));
+      if (temporary_wsv_type_ == TemporaryWsvType::OVERLAY) {
+        return std::make_unique<OverlayTemporaryWsv>(
+            std::move(postgres_connection),
+            std::move(wsv_transaction),
+            command_executors_,
+            wsv_cache_);
+      }
+      return std::make_unique<TemporaryWsvImpl>(std::move(postgres_connection),
+                                                std::move(wsv_transaction),
+                                                command_executors_,
+                                                wsv_cache_);
     }
 
     std::unique_ptr<MutableStorage> StorageImpl::createMutableStorage() {
-      auto command_executors = model::CommandExecutorFactory::create();
-      if (not command_executors.has_value()) {
-        log_->error("Cannot create CommandExecutorFactory");
-        return nullptr;
+      if (embedded_wsv_) {
+        auto block_index = createBlockIndex();
+        if (not block_index) {
+          return nullptr;
+        }
+        auto top_block = blocks_->getTopBlock();
+        return std::make_unique<EmbeddedMutableStorage>(
+            top_block ? top_block->hash : hash256_t{},
+            std::move(block_index),
+            embedded_wsv_->snapshot(),
+            command_executors_);
       }
 
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        log_->error("Connection to PostgreSQL broken: {}", e.what());
+      auto postgres_connection = pg_pool_->acquire();
+      if (not postgres_connection) {
+        log_->error("Cannot get connection to PostgreSQL");
         return nullptr;
       }
       auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
           *postgres_connection, "TemporaryWsv");
 
-      auto index = std::make_unique<cpp_redis::client>();
-      try {
-        index->connect(redis_host_, redis_port_);
-      } catch (const cpp_redis::redis_error &e) {
-        log_->error("Connection to Redis broken: {}", e.what());
+      auto block_index = createBlockIndex();
+      if (not block_index) {
         return nullptr;
       }
 
-      nonstd::optional<hash256_t> top_hash;
-
-      blocks_->getTopBlocks(1)
-          .subscribe_on(rxcpp::observe_on_new_thread())
-          .as_blocking()
-          .subscribe([&top_hash](auto block) { top_hash = block.hash; });
+      auto top_block = blocks_->getTopBlock();
 
       return std::make_unique<MutableStorageImpl>(
-          top_hash.value_or(hash256_t{}),
-          std::move(index),
+          top_block ? top_block->hash : hash256_t{},
+          std::move(block_index),
           std::move(postgres_connection),
           std::move(wsv_transaction),
-          std::move(command_executors.value()));
+          command_executors_,
+          wsv_cache_);
     }
 
     bool StorageImpl::insertBlock(model::Block block) {
@@ -147,70 +235,106 @@ DROP TABLE IF EXISTS role;
 )";
 
       // erase db
-      log_->info("drop dp");
-      pqxx::connection connection(postgres_options_);
-      pqxx::work txn(connection);
-      txn.exec(drop);
-      txn.commit();
-
-      pqxx::work init_txn(connection);
-      init_txn.exec(init_);
-      init_txn.commit();
+      if (embedded_wsv_) {
+        log_->info("drop embedded wsv");
+        embedded_wsv_->clear();
+      } else {
+        log_->info("drop dp");
+        pqxx::connection connection(postgres_options_);
+        pqxx::work txn(connection);
+        txn.exec(drop);
+        txn.commit();
+
+        pqxx::work init_txn(connection);
+        init_txn.exec(init_);
+        init_txn.commit();
+      }
 
       // erase tx index
-      log_->info("drop redis");
-      cpp_redis::client client;
-      client.connect(redis_host_, redis_port_);
-      client.flushall();
-      client.sync_commit();
+      if (embedded_index_) {
+        log_->info("drop embedded index");
+        embedded_index_->dropAll();
+      } else {
+        log_->info("drop redis");
+        cpp_redis::client client;
+        client.connect(redis_host_, redis_port_);
+        client.flushall();
+        client.sync_commit();
+      }
 
       // erase blocks
       log_->info("drop block store");
       block_store_->dropAll();
+      block_cache_->clear();
+      wsv_cache_->clear();
     }
 
     nonstd::optional<ConnectionContext> StorageImpl::initConnections(
         std::string block_store_dir,
         std::string redis_host,
         std::size_t redis_port,
-        std::string postgres_options) {
+        std::string postgres_options,
+        const StorageOptions &options) {
       auto log_ = logger::log("StorageImpl:initConnection");
       log_->info("Start storage creation");
 
-      auto block_store = FlatFile::create(block_store_dir);
+      auto block_store = SegmentedFile::create(
+          block_store_dir,
+          SegmentedFile::DEFAULT_SEGMENT_SIZE,
+          options.repair_block_store
+              ? SegmentedFile::RecoveryMode::FULL_SCAN
+              : SegmentedFile::RecoveryMode::CHECKPOINT,
+          options.block_store_sync);
       if (!block_store) {
         log_->error("Cannot create block store in {}", block_store_dir);
         return nonstd::nullopt;
       }
       log_->info("block store created");
 
-      auto index = std::make_unique<cpp_redis::client>();
-      try {
-        index->connect(redis_host, redis_port);
-      } catch (const cpp_redis::redis_error &e) {
-        log_->error(
-            "Connection {}:{} with Redis broken", redis_host, redis_port);
-        return nonstd::nullopt;
-      }
-      log_->info("connection to Redis completed");
-
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        log_->error("Cannot with PostgreSQL broken: {}", e.what());
-        return nonstd::nullopt;
+      std::unique_ptr<cpp_redis::client> index;
+      std::unique_ptr<EmbeddedIndex> embedded_index;
+      if (options.block_index == BlockIndexType::EMBEDDED) {
+        embedded_index = EmbeddedIndex::create(block_store->directory() + "/"
+                                               + EmbeddedIndex::JOURNAL_DIR);
+        if (not embedded_index) {
+          log_->error("Cannot open embedded index in {}", block_store_dir);
+          return nonstd::nullopt;
+        }
+        log_->info("embedded index opened");
+      } else {
+        index = std::make_unique<cpp_redis::client>();
+        try {
+          index->connect(redis_host, redis_port);
+        } catch (const cpp_redis::redis_error &e) {
+          log_->error(
+              "Connection {}:{} with Redis broken", redis_host, redis_port);
+          return nonstd::nullopt;
+        }
+        log_->info("connection to Redis completed");
       }
-      log_->info("connection to PostgreSQL completed");
 
-      auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
-          *postgres_connection, "Storage");
-      log_->info("transaction to PostgreSQL initialized");
+      std::unique_ptr<pqxx::lazyconnection> postgres_connection;
+      std::unique_ptr<pqxx::nontransaction> wsv_transaction;
+      if (options.wsv == WsvType::POSTGRES) {
+        postgres_connection =
+            std::make_unique<pqxx::lazyconnection>(postgres_options);
+        try {
+          postgres_connection->activate();
+        } catch (const pqxx::broken_connection &e) {
+          log_->error("Cannot with PostgreSQL broken: {}", e.what());
+          return nonstd::nullopt;
+        }
+        log_->info("connection to PostgreSQL completed");
+
+        wsv_transaction = std::make_unique<pqxx::nontransaction>(
+            *postgres_connection, "Storage");
+        log_->info("transaction to PostgreSQL initialized");
+      }
 
       return nonstd::make_optional<ConnectionContext>(
           std::move(block_store),
           std::move(index),
+          std::move(embedded_index),
           std::move(postgres_connection),
           std::move(wsv_transaction));
     }
@@ -219,9 +343,20 @@ DROP TABLE IF EXISTS role;
         std::string block_store_dir,
         std::string redis_host,
         std::size_t redis_port,
-        std::string postgres_options) {
-      auto ctx = initConnections(
-          block_store_dir, redis_host, redis_port, postgres_options);
+        std::string postgres_options,
+        StorageOptions options) {
+      auto command_executors = model::CommandExecutorFactory::create();
+      if (not command_executors.has_value()) {
+        logger::log("StorageImpl::create")
+            ->error("Cannot create CommandExecutorFactory");
+        return nullptr;
+      }
+
+      auto ctx = initConnections(block_store_dir,
+                                 redis_host,
+                                 redis_port,
+                                 postgres_options,
+                                 options);
       if (not ctx.has_value()) {
         return nullptr;
       }
@@ -233,24 +368,160 @@ DROP TABLE IF EXISTS role;
                           postgres_options,
                           std::move(ctx->block_store),
                           std::move(ctx->index),
+                          std::move(ctx->embedded_index),
                           std::move(ctx->pg_lazy),
-                          std::move(ctx->pg_nontx)));
+                          std::move(ctx->pg_nontx),
+                          std::move(command_executors.value()),
+                          options));
     }
 
     void StorageImpl::commit(std::unique_ptr<MutableStorage> mutableStorage) {
       std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
       auto storage_ptr = std::move(mutableStorage);  // get ownership of storage
+      if (embedded_wsv_) {
+        auto storage = static_cast<EmbeddedMutableStorage *>(storage_ptr.get());
+        auto state = storage->state();
+        if (not state) {
+          log_->error("Cannot write changes of blocks to embedded wsv");
+          return;
+        }
+        if (not storeBlocks(storage->block_store_)) {
+          return;
+        }
+        storage->block_index_->commit();
+
+        embedded_wsv_->commit(std::move(state));
+        storage->committed = true;
+        return;
+      }
+
       auto storage = static_cast<MutableStorageImpl *>(storage_ptr.get());
-      for (const auto &block : storage->block_store_) {
-        block_store_->add(block.first,
-                          stringToBytes(model::converters::jsonToString(
-                              serializer_.serialize(block.second))));
+      if (not storeBlocks(storage->block_store_)) {
+        return;
       }
-      storage->index_->exec();
-      storage->index_->sync_commit();
+      storage->block_index_->commit();
 
       storage->transaction_->exec("COMMIT;");
       storage->committed = true;
+      wsv_cache_->invalidate(*storage->written_);
+    }
+
+    bool StorageImpl::storeBlocks(
+        const std::map<uint32_t, model::Block> &blocks) {
+      for (const auto &block : blocks) {
+        auto bytes = serializer_.serialize(block.second);
+        if (not block_store_->add(block.first, bytes)) {
+          log_->error("Cannot write block {} to block store, changes of "
+                      "the storage are discarded",
+                      block.first);
+          return false;
+        }
+        auto committed = std::make_shared<const model::Block>(block.second);
+        block_cache_->put(committed, bytes.size());
+        blocks_->setTopBlock(std::move(committed));
+      }
+      return true;
+    }
+
+    std::unique_ptr<BlockIndex> StorageImpl::createBlockIndex() {
+      if (embedded_index_) {
+        return std::make_unique<EmbeddedBlockIndex>(*embedded_index_);
+      }
+
+      auto index = redis_pool_->acquire();
+      if (not index) {
+        log_->error("Cannot get connection to Redis");
+        return nullptr;
+      }
+      index->multi();
+      return std::make_unique<RedisBlockIndex>(std::move(index));
+    }
+
+    void StorageImpl::reindexTail() {
+      const auto last_id = block_store_->last_id();
+      if (embedded_index_->lastHeight() > last_id) {
+        log_->warn("Index is ahead of block store, rebuilding it");
+        embedded_index_->dropAll();
+      }
+      for (auto height = embedded_index_->lastHeight() + 1; height <= last_id;
+           ++height) {
+        auto view = block_store_->view(height);
+        auto block = view
+            ? serializer_.deserialize(view->data(), view->size())
+            : nonstd::nullopt;
+        if (not block) {
+          log_->error("Cannot read block {} to index it", height);
+          return;
+        }
+        if (not embedded_index_->add(height, EmbeddedIndex::encode(*block))) {
+          log_->error("Cannot index block {}", height);
+          return;
+        }
+      }
+    }
+
+    void StorageImpl::backfillBlockHashes() {
+      const std::string backfilled_key = "block:backfilled";
+      // blocks per round trip to Redis
+      const auto batch_size = 1000u;
+      bool backfilled = false;
+      index_->get(backfilled_key, [&backfilled](cpp_redis::reply &reply) {
+        backfilled = not reply.is_null();
+      });
+      index_->sync_commit();
+      if (backfilled) {
+        return;
+      }
+
+      const auto last_id = block_store_->last_id();
+      log_->info("Index hashes of {} blocks", last_id);
+      for (auto height = 1u; height <= last_id; ++height) {
+        auto view = block_store_->view(height);
+        auto block = view
+            ? serializer_.deserialize(view->data(), view->size())
+            : nonstd::nullopt;
+        if (not block) {
+          log_->error("Cannot read block {} to index its hash", height);
+          index_->sync_commit();
+          return;
+        }
+        index_->set("block:" + block->hash.to_string(),
+                    std::to_string(height));
+        if (height % batch_size == 0) {
+          index_->sync_commit();
+        }
+      }
+      index_->set(backfilled_key, "1");
+      index_->sync_commit();
+    }
+
+    void StorageImpl::restoreEmbeddedWsv() {
+      const auto last_id = block_store_->last_id();
+      log_->info("Restore embedded wsv from {} blocks", last_id);
+      EmbeddedMutableStorage storage(
+          hash256_t{}, nullptr, embedded_wsv_->snapshot(), command_executors_);
+      for (auto height = 1u; height <= last_id; ++height) {
+        auto view = block_store_->view(height);
+        auto block = view
+            ? serializer_.deserialize(view->data(), view->size())
+            : nonstd::nullopt;
+        if (not block) {
+          log_->error("Cannot read block {} to restore wsv", height);
+          break;
+        }
+        auto applied = storage.apply(
+            *block, [](const auto &, auto &, const auto &) { return true; });
+        if (not applied) {
+          log_->error("Cannot apply block {} to restore wsv", height);
+          break;
+        }
+      }
+      auto state = storage.state();
+      if (not state) {
+        log_->error("Cannot write restored state to embedded wsv");
+        return;
+      }
+      embedded_wsv_->commit(std::move(state));
     }
 
     std::shared_ptr<WsvQuery> StorageImpl::getWsvQuery() const { return wsv_; }
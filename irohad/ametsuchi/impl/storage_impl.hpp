@@ -26,26 +26,86 @@
 #include <cpp_redis/cpp_redis>
 #include <nonstd/optional.hpp>
 #include <pqxx/pqxx>
-#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/block_store_query.hpp"
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "ametsuchi/impl/embedded_index/embedded_index.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv.hpp"
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
+#include "ametsuchi/key_value_storage.hpp"
 #include "logger/logger.hpp"
-#include "model/converters/json_block_factory.hpp"
+#include "model/execution/command_executor_factory.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
+    /**
+     * Backend of index on blocks and transactions
+     */
+    enum class BlockIndexType {
+      REDIS,    // external Redis server
+      EMBEDDED  // in-process index with journal in block store folder
+    };
+
+    /**
+     * Backend of world state view
+     */
+    enum class WsvType {
+      POSTGRES,  // external PostgreSQL server
+      EMBEDDED   // in-process state restored from block store on start
+    };
+
+    /**
+     * Implementation of temporary world state view used for validation
+     */
+    enum class TemporaryWsvType {
+      SAVEPOINT,  // database transaction rolled back to savepoints
+      OVERLAY     // in-memory changes over committed state
+    };
+
+    /**
+     * Tunables of storage, which have sensible defaults
+     */
+    struct StorageOptions {
+      BlockIndexType block_index = BlockIndexType::REDIS;
+      /// memory budget of decoded blocks cache in bytes
+      std::size_t block_cache_budget = BlockCache::DEFAULT_BUDGET;
+      /// verify all stored blocks on startup instead of trusting checkpoint
+      bool repair_block_store = false;
+      /// when committed blocks are synced to disk
+      SyncPolicy block_store_sync;
+      /// maximal number of open connections of each database, which are
+      /// used by temporary and mutable storages
+      std::size_t connection_pool_size = 4;
+      /// maximal number of cached accounts, signatories, account roles and
+      /// role permissions each, zero disables the cache
+      std::size_t wsv_cache_entries = WsvCache::DEFAULT_ENTRIES;
+      /// used for PostgreSQL world state view only
+      TemporaryWsvType temporary_wsv = TemporaryWsvType::SAVEPOINT;
+      WsvType wsv = WsvType::POSTGRES;
+    };
+
     struct ConnectionContext {
-      ConnectionContext(std::unique_ptr<FlatFile> block_store,
+      ConnectionContext(std::unique_ptr<KeyValueStorage> block_store,
                         std::unique_ptr<cpp_redis::client> index,
+                        std::unique_ptr<EmbeddedIndex> embedded_index,
                         std::unique_ptr<pqxx::lazyconnection> pg_lazy,
                         std::unique_ptr<pqxx::nontransaction> pg_nontx)
           : block_store(std::move(block_store)),
             index(std::move(index)),
+            embedded_index(std::move(embedded_index)),
             pg_lazy(std::move(pg_lazy)),
             pg_nontx(std::move(pg_nontx)) {
       }
 
-      std::unique_ptr<FlatFile> block_store;
+      std::unique_ptr<KeyValueStorage> block_store;
+      // only one of the index backends is present
       std::unique_ptr<cpp_redis::client> index;
+      std::unique_ptr<EmbeddedIndex> embedded_index;
+      // absent if embedded world state view is used
       std::unique_ptr<pqxx::lazyconnection> pg_lazy;
       std::unique_ptr<pqxx::nontransaction> pg_nontx;
     };
@@ -56,12 +116,24 @@ namespace iroha {
       initConnections(std::string block_store_dir,
                       std::string redis_host,
                       std::size_t redis_port,
-                      std::string postgres_options);
+                      std::string postgres_options,
+                      const StorageOptions &options);
 
      public:
+      /**
+       * Create storage
+       * @param block_store_dir - folder with raw blocks
+       * @param redis_host - host of Redis with block index
+       * @param redis_port - port of Redis with block index
+       * @param postgres_connection - connection options of PostgreSQL with
+       * world state view
+       * @param options - storage tunables
+       * @return storage or nullptr, if connections cannot be established
+       */
       static std::shared_ptr<StorageImpl> create(
           std::string block_store_dir, std::string redis_host,
-          std::size_t redis_port, std::string postgres_connection);
+          std::size_t redis_port, std::string postgres_connection,
+          StorageOptions options = StorageOptions());
 
       std::unique_ptr<TemporaryWsv> createTemporaryWsv() override;
 
@@ -83,10 +155,14 @@ namespace iroha {
                   std::string redis_host,
                   std::size_t redis_port,
                   std::string postgres_options,
-                  std::unique_ptr<FlatFile> block_store,
+                  std::unique_ptr<KeyValueStorage> block_store,
                   std::unique_ptr<cpp_redis::client> index,
+                  std::unique_ptr<EmbeddedIndex> embedded_index,
                   std::unique_ptr<pqxx::lazyconnection> wsv_connection,
-                  std::unique_ptr<pqxx::nontransaction> wsv_transaction);
+                  std::unique_ptr<pqxx::nontransaction> wsv_transaction,
+                  std::shared_ptr<model::CommandExecutorFactory>
+                      command_executors,
+                  const StorageOptions &options);
 
       /**
        * Folder with raw blocks
@@ -99,25 +175,97 @@ namespace iroha {
       const std::string postgres_options_;
 
      private:
-      std::unique_ptr<FlatFile> block_store_;
+      /**
+       * Create index for blocks of new mutable storage
+       * @return index or nullptr, if index backend is unavailable
+       */
+      std::unique_ptr<BlockIndex> createBlockIndex();
 
       /**
-       * Redis connection
+       * Index blocks which are in block store, but not in embedded index,
+       * e.g. after crash between writing a block and its index.
+       * Index which is ahead of block store is rebuilt from scratch
+       */
+      void reindexTail();
+
+      /**
+       * Write block hash -> height entries of Redis index for blocks indexed
+       * before the entries were introduced. Done once, completion is marked
+       * in the index
+       */
+      void backfillBlockHashes();
+
+      /**
+       * Restore embedded world state view by applying all blocks of block
+       * store
+       */
+      void restoreEmbeddedWsv();
+
+      /**
+       * Write blocks of committed mutable storage to block store
+       * @return false if a block cannot be written, blocks following it are
+       * not written then
+       */
+      bool storeBlocks(const std::map<uint32_t, model::Block> &blocks);
+
+      std::unique_ptr<KeyValueStorage> block_store_;
+
+      /**
+       * Redis connection, absent if embedded index is used
        */
       std::unique_ptr<cpp_redis::client> index_;
 
       /**
-       * Pg connection with direct transaction management
+       * In-process index, absent if Redis is used
+       */
+      std::unique_ptr<EmbeddedIndex> embedded_index_;
+
+      /**
+       * Pg connection with direct transaction management, absent if
+       * embedded world state view is used
        */
       std::unique_ptr<pqxx::lazyconnection> wsv_connection_;
 
       std::unique_ptr<pqxx::nontransaction> wsv_transaction_;
 
+      /**
+       * Committed accounts, signatories and roles shared by all world state
+       * queries, invalidated on commit
+       */
+      std::shared_ptr<WsvCache> wsv_cache_;
+
+      /**
+       * In-process world state view, absent if PostgreSQL is used
+       */
+      std::shared_ptr<EmbeddedWsv> embedded_wsv_;
+
       std::shared_ptr<WsvQuery> wsv_;
 
-      std::shared_ptr<BlockQuery> blocks_;
+      /**
+       * Connections of temporary and mutable storages
+       */
+      std::shared_ptr<ConnectionPool<pqxx::lazyconnection>> pg_pool_;
+
+      /**
+       * Connections of Redis block indexes, absent if embedded index is used
+       */
+      std::shared_ptr<ConnectionPool<cpp_redis::client>> redis_pool_;
+
+      /**
+       * Executors shared by all temporary and mutable storages
+       */
+      std::shared_ptr<model::CommandExecutorFactory> command_executors_;
+
+      /**
+       * Decoded blocks shared with block query, filled on commit
+       */
+      std::shared_ptr<BlockCache> block_cache_;
+
+      TemporaryWsvType temporary_wsv_type_;
+
+      std::shared_ptr<BlockStoreQuery> blocks_;
 
-      model::converters::JsonBlockFactory serializer_;
+      BlockSerializer serializer_;
 
       // Allows multiple readers and a single writer
       std::shared_timed_mutex rw_lock_;
@@ -167,9 +315,44 @@ CREATE TABLE IF NOT EXISTS asset (
 CREATE TABLE IF NOT EXISTS account_has_asset (
     account_id character varying(197) NOT NULL REFERENCES account,
     asset_id character varying(197) NOT NULL REFERENCES asset,
-    amount decimal NOT NULL,
+    amount_0 bigint NOT NULL,
+    amount_1 bigint NOT NULL,
+    amount_2 bigint NOT NULL,
+    amount_3 bigint NOT NULL,
+    amount_precision smallint NOT NULL,
     PRIMARY KEY (account_id, asset_id)
 );
+DO $$
+BEGIN
+  -- balances of older schema are decimal, convert them to limbs
+  IF EXISTS (SELECT 1 FROM information_schema.columns
+             WHERE table_name = 'account_has_asset'
+             AND column_name = 'amount') THEN
+    ALTER TABLE account_has_asset
+        ADD COLUMN amount_0 bigint, ADD COLUMN amount_1 bigint,
+        ADD COLUMN amount_2 bigint, ADD COLUMN amount_3 bigint,
+        ADD COLUMN amount_precision smallint;
+    UPDATE account_has_asset AS balance SET
+        amount_0 = l[1], amount_1 = l[2], amount_2 = l[3], amount_3 = l[4],
+        amount_precision = scale(balance.amount)
+    FROM (SELECT account_id, asset_id, ARRAY(
+              SELECT (CASE WHEN x >= 2::numeric ^ 63 THEN x - 2::numeric ^ 64
+                      ELSE x END)::bigint
+              FROM (SELECT k, mod(div(amount * 10::numeric ^ scale(amount),
+                                      2::numeric ^ (64 * k)),
+                                  2::numeric ^ 64) AS x
+                    FROM generate_series(0, 3) AS k) AS limbs
+              ORDER BY k DESC) AS l
+          FROM account_has_asset) AS converted
+    WHERE balance.account_id = converted.account_id
+        AND balance.asset_id = converted.asset_id;
+    ALTER TABLE account_has_asset
+        ALTER COLUMN amount_0 SET NOT NULL, ALTER COLUMN amount_1 SET NOT NULL,
+        ALTER COLUMN amount_2 SET NOT NULL, ALTER COLUMN amount_3 SET NOT NULL,
+        ALTER COLUMN amount_precision SET NOT NULL,
+        DROP COLUMN amount;
+  END IF;
+END $$;
 CREATE TABLE IF NOT EXISTS role_has_permissions (
     role_id character varying(45) NOT NULL REFERENCES role,
     permission_id character varying(45),
@@ -17,19 +17,27 @@
 
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 
+#include "ametsuchi/impl/cached_wsv_command.hpp"
+#include "ametsuchi/impl/cached_wsv_query.hpp"
 #include "ametsuchi/impl/postgres_wsv_command.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 
 namespace iroha {
   namespace ametsuchi {
     TemporaryWsvImpl::TemporaryWsvImpl(
-        std::unique_ptr<pqxx::lazyconnection> connection,
+        PooledConnection<pqxx::lazyconnection> connection,
         std::unique_ptr<pqxx::nontransaction> transaction,
-        std::shared_ptr<model::CommandExecutorFactory> command_executors)
+        std::shared_ptr<model::CommandExecutorFactory> command_executors,
+        std::shared_ptr<WsvCache> wsv_cache)
         : connection_(std::move(connection)),
           transaction_(std::move(transaction)),
-          wsv_(std::make_unique<PostgresWsvQuery>(*transaction_)),
-          executor_(std::make_unique<PostgresWsvCommand>(*transaction_)),
+          written_(std::make_shared<WsvCache::Keys>()),
+          wsv_(std::make_unique<CachedWsvQuery>(
+              std::make_unique<PostgresWsvQuery>(*transaction_),
+              std::move(wsv_cache),
+              written_)),
+          executor_(std::make_unique<CachedWsvCommand>(
+              std::make_unique<PostgresWsvCommand>(*transaction_), written_)),
           command_executors_(std::move(command_executors)) {
       transaction_->exec("BEGIN;");
     }
@@ -21,6 +21,8 @@
 #include <pqxx/connection>
 #include <pqxx/nontransaction>
 
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
 #include "ametsuchi/temporary_wsv.hpp"
 #include "model/execution/command_executor_factory.hpp"
 
@@ -29,9 +31,10 @@ namespace iroha {
     class TemporaryWsvImpl : public TemporaryWsv {
      public:
       TemporaryWsvImpl(
-          std::unique_ptr<pqxx::lazyconnection> connection,
+          PooledConnection<pqxx::lazyconnection> connection,
           std::unique_ptr<pqxx::nontransaction> transaction,
-          std::shared_ptr<model::CommandExecutorFactory> command_executors);
+          std::shared_ptr<model::CommandExecutorFactory> command_executors,
+          std::shared_ptr<WsvCache> wsv_cache);
 
       bool apply(const model::Transaction &transaction,
                  std::function<bool(const model::Transaction &,
@@ -41,8 +44,9 @@ namespace iroha {
       ~TemporaryWsvImpl() override;
 
      private:
-      std::unique_ptr<pqxx::lazyconnection> connection_;
+      PooledConnection<pqxx::lazyconnection> connection_;
       std::unique_ptr<pqxx::nontransaction> transaction_;
+      std::shared_ptr<WsvCache::Keys> written_;
       std::unique_ptr<WsvQuery> wsv_;
       std::unique_ptr<WsvCommand> executor_;
       std::shared_ptr<model::CommandExecutorFactory> command_executors_;
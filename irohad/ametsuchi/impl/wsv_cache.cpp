@@ -0,0 +1,201 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    constexpr size_t WsvCache::DEFAULT_ENTRIES;
+
+    WsvCache::WsvCache(size_t max_entries)
+        : max_entries_(max_entries), generation_(0), hits_(0), misses_(0) {}
+
+    WsvCache::Generation WsvCache::generation() const {
+      std::lock_guard<std::mutex> lock(lock_);
+      return generation_;
+    }
+
+    template <typename T>
+    const T *WsvCache::Table<T>::find(const std::string &key) {
+      auto it = index_.find(key);
+      if (it == index_.end()) {
+        return nullptr;
+      }
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return &it->second->second;
+    }
+
+    template <typename T>
+    void WsvCache::Table<T>::put(const std::string &key,
+                                 const T &value,
+                                 size_t max_entries) {
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        it->second->second = value;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+      }
+      if (index_.size() >= max_entries) {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+      }
+      lru_.emplace_front(key, value);
+      index_.emplace(key, lru_.begin());
+    }
+
+    template <typename T>
+    void WsvCache::Table<T>::erase(const std::string &key) {
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        lru_.erase(it->second);
+        index_.erase(it);
+      }
+    }
+
+    template <typename T>
+    void WsvCache::Table<T>::clear() {
+      index_.clear();
+      lru_.clear();
+    }
+
+    template <typename T>
+    nonstd::optional<T> WsvCache::get(Table<T> &table,
+                                      const std::string &key) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto value = table.find(key);
+      if (not value) {
+        ++misses_;
+        return nonstd::nullopt;
+      }
+      ++hits_;
+      return *value;
+    }
+
+    template <typename T>
+    void WsvCache::put(Table<T> &table,
+                       const std::string &key,
+                       const T &value,
+                       Generation generation) {
+      if (max_entries_ == 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      if (generation != generation_) {
+        // value may be overwritten by a commit which happened after it
+        // was read
+        return;
+      }
+      table.put(key, value, max_entries_);
+    }
+
+    nonstd::optional<model::Account> WsvCache::getAccount(
+        const std::string &account_id) {
+      return get(accounts_, account_id);
+    }
+
+    void WsvCache::putAccount(const model::Account &account,
+                              Generation generation) {
+      put(accounts_, account.account_id, account, generation);
+    }
+
+    nonstd::optional<std::vector<pubkey_t>> WsvCache::getSignatories(
+        const std::string &account_id) {
+      return get(signatories_, account_id);
+    }
+
+    void WsvCache::putSignatories(const std::string &account_id,
+                                  const std::vector<pubkey_t> &signatories,
+                                  Generation generation) {
+      put(signatories_, account_id, signatories, generation);
+    }
+
+    nonstd::optional<std::vector<std::string>> WsvCache::getAccountRoles(
+        const std::string &account_id) {
+      return get(account_roles_, account_id);
+    }
+
+    void WsvCache::putAccountRoles(const std::string &account_id,
+                                   const std::vector<std::string> &roles,
+                                   Generation generation) {
+      put(account_roles_, account_id, roles, generation);
+    }
+
+    nonstd::optional<std::vector<std::string>> WsvCache::getRolePermissions(
+        const std::string &role_name) {
+      return get(role_permissions_, role_name);
+    }
+
+    void WsvCache::putRolePermissions(
+        const std::string &role_name,
+        const std::vector<std::string> &permissions,
+        Generation generation) {
+      put(role_permissions_, role_name, permissions, generation);
+    }
+
+    nonstd::optional<model::PermissionSet> WsvCache::getAccountPermissions(
+        const std::string &account_id) {
+      return get(account_permissions_, account_id);
+    }
+
+    void WsvCache::putAccountPermissions(
+        const std::string &account_id,
+        const model::PermissionSet &permissions,
+        Generation generation) {
+      put(account_permissions_, account_id, permissions, generation);
+    }
+
+    void WsvCache::invalidate(const Keys &keys) {
+      std::lock_guard<std::mutex> lock(lock_);
+      ++generation_;
+      for (const auto &key : keys.accounts) {
+        accounts_.erase(key);
+      }
+      for (const auto &key : keys.signatories) {
+        signatories_.erase(key);
+      }
+      for (const auto &key : keys.account_roles) {
+        account_roles_.erase(key);
+        account_permissions_.erase(key);
+      }
+      for (const auto &key : keys.role_permissions) {
+        role_permissions_.erase(key);
+      }
+      if (not keys.role_permissions.empty()) {
+        account_permissions_.clear();
+      }
+    }
+
+    void WsvCache::clear() {
+      std::lock_guard<std::mutex> lock(lock_);
+      ++generation_;
+      accounts_.clear();
+      signatories_.clear();
+      account_roles_.clear();
+      role_permissions_.clear();
+      account_permissions_.clear();
+    }
+
+    size_t WsvCache::hits() const {
+      return hits_;
+    }
+
+    size_t WsvCache::misses() const {
+      return misses_;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,185 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_CACHE_HPP
+#define IROHA_WSV_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "common/types.hpp"
+#include "model/account.hpp"
+#include "model/permissions.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Cache of committed world state entities which are read on every
+     * transaction validation: accounts, their signatories, roles and
+     * effective permission sets, and permissions of roles.
+     * Entries are filled by readers and invalidated on commit of mutable
+     * storage by keys which were written in it. Each invalidation starts a
+     * new generation, and fills which started in a previous one are
+     * dropped, so a value read before a commit never outlives it.
+     * When a table is full, its least recently used entry is evicted.
+     * Safe to use from multiple threads.
+     */
+    class WsvCache {
+     public:
+      using Generation = uint64_t;
+
+      static constexpr size_t DEFAULT_ENTRIES = 100000;
+
+      /**
+       * Keys of entities which were written in a transaction
+       */
+      struct Keys {
+        std::unordered_set<std::string> accounts;
+        std::unordered_set<std::string> signatories;
+        std::unordered_set<std::string> account_roles;
+        std::unordered_set<std::string> role_permissions;
+      };
+
+      /**
+       * @param max_entries - maximal number of entries of each entity kind,
+       * zero disables the cache
+       */
+      explicit WsvCache(size_t max_entries = DEFAULT_ENTRIES);
+
+      /**
+       * @return current generation, which should be taken before reading
+       * a value from the database and passed to corresponding put
+       */
+      Generation generation() const;
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id);
+      void putAccount(const model::Account &account, Generation generation);
+
+      nonstd::optional<std::vector<pubkey_t>> getSignatories(
+          const std::string &account_id);
+      void putSignatories(const std::string &account_id,
+                          const std::vector<pubkey_t> &signatories,
+                          Generation generation);
+
+      nonstd::optional<std::vector<std::string>> getAccountRoles(
+          const std::string &account_id);
+      void putAccountRoles(const std::string &account_id,
+                           const std::vector<std::string> &roles,
+                           Generation generation);
+
+      nonstd::optional<std::vector<std::string>> getRolePermissions(
+          const std::string &role_name);
+      void putRolePermissions(const std::string &role_name,
+                              const std::vector<std::string> &permissions,
+                              Generation generation);
+
+      nonstd::optional<model::PermissionSet> getAccountPermissions(
+          const std::string &account_id);
+      void putAccountPermissions(const std::string &account_id,
+                                 const model::PermissionSet &permissions,
+                                 Generation generation);
+
+      /**
+       * Remove entries of given keys and start a new generation.
+       * Permission sets of accounts are removed when their roles are
+       * changed, and all of them when permissions of any role are changed
+       * @param keys - keys of committed entities
+       */
+      void invalidate(const Keys &keys);
+
+      /**
+       * Remove all entries and start a new generation
+       */
+      void clear();
+
+      /**
+       * @return number of get calls which found an entry
+       */
+      size_t hits() const;
+
+      /**
+       * @return number of get calls which did not find an entry
+       */
+      size_t misses() const;
+
+     private:
+      /**
+       * Entries of one entity kind ordered from the most recently used
+       */
+      template <typename T>
+      class Table {
+       public:
+        /**
+         * @return value of key marked as the most recently used,
+         * nullptr if there is none
+         */
+        const T *find(const std::string &key);
+
+        /**
+         * Set value of key, evicting the least recently used entry if
+         * table already has max_entries of them
+         */
+        void put(const std::string &key, const T &value, size_t max_entries);
+
+        void erase(const std::string &key);
+
+        void clear();
+
+       private:
+        using Entry = std::pair<std::string, T>;
+
+        std::list<Entry> lru_;
+        std::unordered_map<std::string, typename std::list<Entry>::iterator>
+            index_;
+      };
+
+      template <typename T>
+      nonstd::optional<T> get(Table<T> &table, const std::string &key);
+
+      template <typename T>
+      void put(Table<T> &table,
+               const std::string &key,
+               const T &value,
+               Generation generation);
+
+      const size_t max_entries_;
+      Generation generation_;
+
+      Table<model::Account> accounts_;
+      Table<std::vector<pubkey_t>> signatories_;
+      Table<std::vector<std::string>> account_roles_;
+      Table<std::vector<std::string>> role_permissions_;
+      Table<model::PermissionSet> account_permissions_;
+
+      std::atomic<size_t> hits_;
+      std::atomic<size_t> misses_;
+
+      mutable std::mutex lock_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_CACHE_HPP
@@ -0,0 +1,685 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_overlay.hpp"
+
+#include <algorithm>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      // sizes of keys in world state view schema
+      const size_t ROLE_ID_SIZE = 45;
+      const size_t PERMISSION_ID_SIZE = 45;
+      const size_t DOMAIN_ID_SIZE = 164;
+      const size_t ACCOUNT_ID_SIZE = 197;
+      const size_t ASSET_ID_SIZE = 197;
+      const size_t PEER_ADDRESS_SIZE = 21;
+
+      template <typename Delta, typename T>
+      void addTo(Delta &delta, const T &value) {
+        if (delta.removed.erase(value) == 0) {
+          delta.added.insert(value);
+        }
+      }
+
+      template <typename Delta, typename T>
+      void removeFrom(Delta &delta, const T &value) {
+        if (delta.added.erase(value) == 0) {
+          delta.removed.insert(value);
+        }
+      }
+
+      /**
+       * Apply changes of collection to its committed elements
+       */
+      template <typename Delta, typename T>
+      std::vector<T> applyTo(const Delta &delta, std::vector<T> values) {
+        values.erase(std::remove_if(values.begin(),
+                                    values.end(),
+                                    [&delta](const auto &value) {
+                                      return delta.removed.count(value) != 0;
+                                    }),
+                     values.end());
+        for (const auto &value : delta.added) {
+          if (std::find(values.begin(), values.end(), value) == values.end()) {
+            values.push_back(value);
+          }
+        }
+        return values;
+      }
+
+      /**
+       * @return true if str is well-formed UTF-8, as PostgreSQL requires
+       * from text in UTF8 database
+       */
+      bool isUtf8(const std::string &str) {
+        for (size_t i = 0; i < str.size();) {
+          auto c = static_cast<unsigned char>(str[i]);
+          size_t length;
+          unsigned char min = 0x80, max = 0xbf;
+          if (c < 0x80) {
+            ++i;
+            continue;
+          } else if (c >= 0xc2 and c <= 0xdf) {
+            length = 2;
+          } else if (c >= 0xe0 and c <= 0xef) {
+            length = 3;
+            // overlong forms and surrogates
+            min = c == 0xe0 ? 0xa0 : min;
+            max = c == 0xed ? 0x9f : max;
+          } else if (c >= 0xf0 and c <= 0xf4) {
+            length = 4;
+            // overlong forms and code points above U+10FFFF
+            min = c == 0xf0 ? 0x90 : min;
+            max = c == 0xf4 ? 0x8f : max;
+          } else {
+            return false;
+          }
+          if (i + length > str.size()) {
+            return false;
+          }
+          for (size_t j = 1; j < length; ++j) {
+            auto next = static_cast<unsigned char>(str[i + j]);
+            if (next < (j == 1 ? min : 0x80) or next > (j == 1 ? max : 0xbf)) {
+              return false;
+            }
+          }
+          i += length;
+        }
+        return true;
+      }
+
+      void appendUtf8(std::string &str, uint32_t code) {
+        if (code < 0x80) {
+          str += static_cast<char>(code);
+        } else if (code < 0x800) {
+          str += static_cast<char>(0xc0 | (code >> 6));
+          str += static_cast<char>(0x80 | (code & 0x3f));
+        } else if (code < 0x10000) {
+          str += static_cast<char>(0xe0 | (code >> 12));
+          str += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+          str += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+          str += static_cast<char>(0xf0 | (code >> 18));
+          str += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+          str += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+          str += static_cast<char>(0x80 | (code & 0x3f));
+        }
+      }
+
+      /**
+       * Read four hex digits of \u escape starting at pos
+       */
+      nonstd::optional<uint32_t> readHex4(const std::string &str, size_t pos) {
+        if (pos + 4 > str.size()) {
+          return nonstd::nullopt;
+        }
+        uint32_t code = 0;
+        for (size_t i = pos; i < pos + 4; ++i) {
+          auto c = str[i];
+          code <<= 4;
+          if (c >= '0' and c <= '9') {
+            code |= c - '0';
+          } else if (c >= 'a' and c <= 'f') {
+            code |= c - 'a' + 10;
+          } else if (c >= 'A' and c <= 'F') {
+            code |= c - 'A' + 10;
+          } else {
+            return nonstd::nullopt;
+          }
+        }
+        return code;
+      }
+
+      /**
+       * Decode account detail value the way PostgreSQL does, which stores
+       * it as contents of jsonb string and reads it back as text
+       * @param val - contents of JSON string
+       * @return decoded value, nullopt if PostgreSQL rejects the value
+       */
+      nonstd::optional<std::string> decodeDetail(const std::string &val) {
+        if (not isUtf8(val)) {
+          return nonstd::nullopt;
+        }
+        std::string decoded;
+        decoded.reserve(val.size());
+        for (size_t i = 0; i < val.size(); ++i) {
+          auto c = val[i];
+          if (c == '"' or static_cast<unsigned char>(c) < 0x20) {
+            return nonstd::nullopt;
+          }
+          if (c != '\\') {
+            decoded += c;
+            continue;
+          }
+          if (++i == val.size()) {
+            return nonstd::nullopt;
+          }
+          switch (val[i]) {
+            case '"':
+            case '\\':
+            case '/':
+              decoded += val[i];
+              break;
+            case 'b':
+              decoded += '\b';
+              break;
+            case 'f':
+              decoded += '\f';
+              break;
+            case 'n':
+              decoded += '\n';
+              break;
+            case 'r':
+              decoded += '\r';
+              break;
+            case 't':
+              decoded += '\t';
+              break;
+            case 'u': {
+              auto code = readHex4(val, i + 1);
+              if (not code or *code == 0) {
+                // jsonb cannot hold \u0000 in text
+                return nonstd::nullopt;
+              }
+              i += 4;
+              if (*code >= 0xdc00 and *code <= 0xdfff) {
+                return nonstd::nullopt;
+              }
+              if (*code >= 0xd800 and *code <= 0xdbff) {
+                // high surrogate must be followed by low one
+                if (i + 2 >= val.size() or val[i + 1] != '\\'
+                    or val[i + 2] != 'u') {
+                  return nonstd::nullopt;
+                }
+                auto low = readHex4(val, i + 3);
+                if (not low or *low < 0xdc00 or *low > 0xdfff) {
+                  return nonstd::nullopt;
+                }
+                i += 6;
+                code = 0x10000 + ((*code - 0xd800) << 10) + (*low - 0xdc00);
+              }
+              appendUtf8(decoded, *code);
+              break;
+            }
+            default:
+              return nonstd::nullopt;
+          }
+        }
+        return decoded;
+      }
+
+      template <typename T>
+      bool contains(const nonstd::optional<std::vector<T>> &values,
+                    const T &value) {
+        return values
+            and std::find(values->begin(), values->end(), value)
+            != values->end();
+      }
+    }  // namespace
+
+    WsvOverlay::WsvOverlay(WsvQuery &wsv) : wsv_(wsv) {}
+
+    void WsvOverlay::release() {
+      undo_.clear();
+    }
+
+    void WsvOverlay::rollback() {
+      for (auto it = undo_.rbegin(); it != undo_.rend(); ++it) {
+        (*it)();
+      }
+      undo_.clear();
+    }
+
+    bool WsvOverlay::flush(WsvCommand &command) {
+      auto result = true;
+      auto write = [&result](bool written) { result = result and written; };
+
+      for (const auto &role : roles_) {
+        write(command.insertRole(role));
+      }
+      for (const auto &permissions : role_permissions_) {
+        write(command.insertRolePermissions(permissions.first,
+                                            permissions.second));
+      }
+      for (const auto &domain : domains_) {
+        write(command.insertDomain(domain.second));
+      }
+      for (const auto &account : accounts_) {
+        write(wsv_.getAccount(account.first)
+                  ? command.updateAccount(account.second)
+                  : command.insertAccount(account.second));
+      }
+      for (const auto &asset : assets_) {
+        write(command.insertAsset(asset.second));
+      }
+      for (const auto &roles : account_roles_) {
+        for (const auto &role : roles.second.removed) {
+          write(command.deleteAccountRole(roles.first, role));
+        }
+        for (const auto &role : roles.second.added) {
+          write(command.insertAccountRole(roles.first, role));
+        }
+      }
+      for (const auto &permission : grantable_permissions_) {
+        const auto &permittee = std::get<0>(permission.first);
+        const auto &account = std::get<1>(permission.first);
+        const auto &permission_id = std::get<2>(permission.first);
+        if (not permission.second) {
+          write(command.deleteAccountGrantablePermission(
+              permittee, account, permission_id));
+        } else if (not wsv_.hasAccountGrantablePermission(
+                       permittee, account, permission_id)) {
+          write(command.insertAccountGrantablePermission(
+              permittee, account, permission_id));
+        }
+      }
+      for (const auto &detail : details_) {
+        write(command.setAccountKV(std::get<0>(detail.first),
+                                   std::get<1>(detail.first),
+                                   std::get<2>(detail.first),
+                                   detail.second));
+      }
+      for (const auto &asset : account_assets_) {
+        write(command.upsertAccountAsset(asset.second));
+      }
+      for (const auto &signatories : account_signatories_) {
+        for (const auto &signatory : signatories.second.removed) {
+          write(command.deleteAccountSignatory(signatories.first, signatory));
+          write(command.deleteSignatory(signatory));
+        }
+        for (const auto &signatory : signatories.second.added) {
+          write(command.insertSignatory(signatory));
+          write(command.insertAccountSignatory(signatories.first, signatory));
+        }
+      }
+      if (not peers_.empty()) {
+        // committed peers with changed keys were deleted, and possibly
+        // inserted again
+        auto committed = wsv_.getPeers().value_or(std::vector<model::Peer>{});
+        for (const auto &peer : committed) {
+          if (peers_.count(peer.pubkey) != 0) {
+            write(command.deletePeer(peer));
+          }
+        }
+        for (const auto &peer : peers_) {
+          if (peer.second) {
+            write(command.insertPeer(*peer.second));
+          }
+        }
+      }
+      return result;
+    }
+
+    template <typename Map>
+    void WsvOverlay::remember(Map &map, const typename Map::key_type &key) {
+      auto it = map.find(key);
+      if (it == map.end()) {
+        undo_.emplace_back([&map, key] { map.erase(key); });
+      } else {
+        undo_.emplace_back(
+            [&map, key, value = it->second] { map[key] = value; });
+      }
+    }
+
+    bool WsvOverlay::roleExists(const std::string &role_name) {
+      return roles_.count(role_name) != 0
+          or contains(wsv_.getRoles(), role_name);
+    }
+
+    bool WsvOverlay::accountExists(const std::string &account_id) {
+      return static_cast<bool>(getAccount(account_id));
+    }
+
+    // --------------------------------| Query |--------------------------------
+
+    bool WsvOverlay::hasAccountGrantablePermission(
+        const std::string &permitee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      auto it = grantable_permissions_.find(
+          std::make_tuple(permitee_account_id, account_id, permission_id));
+      if (it != grantable_permissions_.end()) {
+        return it->second;
+      }
+      return wsv_.hasAccountGrantablePermission(
+          permitee_account_id, account_id, permission_id);
+    }
+
+    nonstd::optional<model::Domain> WsvOverlay::getDomain(
+        const std::string &domain_id) {
+      auto it = domains_.find(domain_id);
+      if (it != domains_.end()) {
+        return it->second;
+      }
+      return wsv_.getDomain(domain_id);
+    }
+
+    nonstd::optional<std::vector<std::string>> WsvOverlay::getAccountRoles(
+        const std::string &account_id) {
+      auto roles = wsv_.getAccountRoles(account_id);
+      auto it = account_roles_.find(account_id);
+      if (not roles or it == account_roles_.end()) {
+        return roles;
+      }
+      return applyTo(it->second, *roles);
+    }
+
+    nonstd::optional<std::vector<std::string>> WsvOverlay::getRolePermissions(
+        const std::string &role_name) {
+      auto permissions = wsv_.getRolePermissions(role_name);
+      auto it = role_permissions_.find(role_name);
+      if (not permissions or it == role_permissions_.end()) {
+        return permissions;
+      }
+      permissions->insert(
+          permissions->end(), it->second.begin(), it->second.end());
+      return permissions;
+    }
+
+    nonstd::optional<model::PermissionSet> WsvOverlay::getAccountPermissions(
+        const std::string &account_id) {
+      if (role_permissions_.empty()
+          and account_roles_.find(account_id) == account_roles_.end()) {
+        return wsv_.getAccountPermissions(account_id);
+      }
+      // resolve roles of account and their permissions with changes
+      return WsvQuery::getAccountPermissions(account_id);
+    }
+
+    nonstd::optional<std::vector<std::string>> WsvOverlay::getRoles() {
+      auto roles = wsv_.getRoles();
+      if (roles) {
+        roles->insert(roles->end(), roles_.begin(), roles_.end());
+      }
+      return roles;
+    }
+
+    nonstd::optional<model::Account> WsvOverlay::getAccount(
+        const std::string &account_id) {
+      auto it = accounts_.find(account_id);
+      if (it != accounts_.end()) {
+        return it->second;
+      }
+      return wsv_.getAccount(account_id);
+    }
+
+    nonstd::optional<std::string> WsvOverlay::getAccountDetail(
+        const std::string &account_id,
+        const std::string &creator_account_id,
+        const std::string &detail) {
+      auto it = details_.find(
+          std::make_tuple(account_id, creator_account_id, detail));
+      if (it != details_.end()) {
+        // empty value is read as missing one from the database
+        if (it->second.empty()) {
+          return nonstd::nullopt;
+        }
+        return it->second;
+      }
+      return wsv_.getAccountDetail(account_id, creator_account_id, detail);
+    }
+
+    nonstd::optional<std::vector<pubkey_t>> WsvOverlay::getSignatories(
+        const std::string &account_id) {
+      auto signatories = wsv_.getSignatories(account_id);
+      auto it = account_signatories_.find(account_id);
+      if (not signatories or it == account_signatories_.end()) {
+        return signatories;
+      }
+      return applyTo(it->second, *signatories);
+    }
+
+    nonstd::optional<model::Asset> WsvOverlay::getAsset(
+        const std::string &asset_id) {
+      auto it = assets_.find(asset_id);
+      if (it != assets_.end()) {
+        return it->second;
+      }
+      return wsv_.getAsset(asset_id);
+    }
+
+    nonstd::optional<model::AccountAsset> WsvOverlay::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      auto it = account_assets_.find(std::make_pair(account_id, asset_id));
+      if (it != account_assets_.end()) {
+        return it->second;
+      }
+      return wsv_.getAccountAsset(account_id, asset_id);
+    }
+
+    nonstd::optional<std::vector<model::Peer>> WsvOverlay::getPeers() {
+      auto peers = wsv_.getPeers();
+      if (not peers or peers_.empty()) {
+        return peers;
+      }
+      peers->erase(std::remove_if(peers->begin(),
+                                  peers->end(),
+                                  [this](const auto &peer) {
+                                    return peers_.count(peer.pubkey) != 0;
+                                  }),
+                   peers->end());
+      for (const auto &peer : peers_) {
+        if (peer.second) {
+          peers->push_back(*peer.second);
+        }
+      }
+      return peers;
+    }
+
+    // -------------------------------| Command |-------------------------------
+
+    bool WsvOverlay::insertRole(const std::string &role_name) {
+      if (role_name.size() > ROLE_ID_SIZE or roleExists(role_name)) {
+        return false;
+      }
+      roles_.insert(role_name);
+      undo_.emplace_back([this, role_name] { roles_.erase(role_name); });
+      return true;
+    }
+
+    bool WsvOverlay::insertAccountRole(const std::string &account_id,
+                                       const std::string &role_name) {
+      if (not accountExists(account_id) or not roleExists(role_name)
+          or contains(getAccountRoles(account_id), role_name)) {
+        return false;
+      }
+      remember(account_roles_, account_id);
+      addTo(account_roles_[account_id], role_name);
+      return true;
+    }
+
+    bool WsvOverlay::deleteAccountRole(const std::string &account_id,
+                                       const std::string &role_name) {
+      if (contains(getAccountRoles(account_id), role_name)) {
+        remember(account_roles_, account_id);
+        removeFrom(account_roles_[account_id], role_name);
+      }
+      return true;
+    }
+
+    bool WsvOverlay::insertRolePermissions(
+        const std::string &role_id, const std::set<std::string> &permissions) {
+      if (not roleExists(role_id)) {
+        return false;
+      }
+      auto current = getRolePermissions(role_id);
+      if (not current) {
+        return false;
+      }
+      for (const auto &permission : permissions) {
+        if (permission.size() > PERMISSION_ID_SIZE
+            or contains(current, permission)) {
+          return false;
+        }
+      }
+      remember(role_permissions_, role_id);
+      role_permissions_[role_id].insert(permissions.begin(), permissions.end());
+      return true;
+    }
+
+    bool WsvOverlay::insertAccountGrantablePermission(
+        const std::string &permittee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      if (permission_id.size() > PERMISSION_ID_SIZE
+          or not accountExists(permittee_account_id)
+          or not accountExists(account_id)
+          or hasAccountGrantablePermission(
+                 permittee_account_id, account_id, permission_id)) {
+        return false;
+      }
+      auto key =
+          std::make_tuple(permittee_account_id, account_id, permission_id);
+      remember(grantable_permissions_, key);
+      grantable_permissions_[key] = true;
+      return true;
+    }
+
+    bool WsvOverlay::deleteAccountGrantablePermission(
+        const std::string &permittee_account_id,
+        const std::string &account_id,
+        const std::string &permission_id) {
+      auto key =
+          std::make_tuple(permittee_account_id, account_id, permission_id);
+      remember(grantable_permissions_, key);
+      grantable_permissions_[key] = false;
+      return true;
+    }
+
+    bool WsvOverlay::insertAccount(const model::Account &account) {
+      if (account.account_id.size() > ACCOUNT_ID_SIZE
+          or accountExists(account.account_id)
+          or not getDomain(account.domain_id)) {
+        return false;
+      }
+      remember(accounts_, account.account_id);
+      accounts_[account.account_id] = account;
+      return true;
+    }
+
+    bool WsvOverlay::updateAccount(const model::Account &account) {
+      auto current = getAccount(account.account_id);
+      if (current) {
+        current->quorum = account.quorum;
+        remember(accounts_, account.account_id);
+        accounts_[account.account_id] = *current;
+      }
+      return true;
+    }
+
+    bool WsvOverlay::setAccountKV(const std::string &account_id,
+                                  const std::string &creator_account_id,
+                                  const std::string &key,
+                                  const std::string &val) {
+      auto decoded = decodeDetail(val);
+      if (not decoded) {
+        return false;
+      }
+      if (accountExists(account_id)) {
+        auto detail = std::make_tuple(account_id, creator_account_id, key);
+        remember(details_, detail);
+        details_[detail] = std::move(*decoded);
+      }
+      return true;
+    }
+
+    bool WsvOverlay::insertAsset(const model::Asset &asset) {
+      if (asset.asset_id.size() > ASSET_ID_SIZE or getAsset(asset.asset_id)
+          or not getDomain(asset.domain_id)) {
+        return false;
+      }
+      remember(assets_, asset.asset_id);
+      assets_[asset.asset_id] = asset;
+      return true;
+    }
+
+    bool WsvOverlay::upsertAccountAsset(const model::AccountAsset &asset) {
+      if (not accountExists(asset.account_id) or not getAsset(asset.asset_id)) {
+        return false;
+      }
+      auto key = std::make_pair(asset.account_id, asset.asset_id);
+      remember(account_assets_, key);
+      account_assets_[key] = asset;
+      return true;
+    }
+
+    bool WsvOverlay::insertSignatory(const pubkey_t &signatory) {
+      // signatories are not read separately from accounts and peers
+      return true;
+    }
+
+    bool WsvOverlay::insertAccountSignatory(const std::string &account_id,
+                                            const pubkey_t &signatory) {
+      if (not accountExists(account_id)
+          or contains(getSignatories(account_id), signatory)) {
+        return false;
+      }
+      remember(account_signatories_, account_id);
+      addTo(account_signatories_[account_id], signatory);
+      return true;
+    }
+
+    bool WsvOverlay::deleteAccountSignatory(const std::string &account_id,
+                                            const pubkey_t &signatory) {
+      if (contains(getSignatories(account_id), signatory)) {
+        remember(account_signatories_, account_id);
+        removeFrom(account_signatories_[account_id], signatory);
+      }
+      return true;
+    }
+
+    bool WsvOverlay::deleteSignatory(const pubkey_t &signatory) {
+      return true;
+    }
+
+    bool WsvOverlay::insertPeer(const model::Peer &peer) {
+      auto peers = getPeers();
+      if (peer.address.size() > PEER_ADDRESS_SIZE or not peers
+          or std::any_of(peers->begin(), peers->end(), [&peer](auto &other) {
+               return other.pubkey == peer.pubkey
+                   or other.address == peer.address;
+             })) {
+        return false;
+      }
+      remember(peers_, peer.pubkey);
+      peers_[peer.pubkey] = peer;
+      return true;
+    }
+
+    bool WsvOverlay::deletePeer(const model::Peer &peer) {
+      if (contains(getPeers(), peer)) {
+        remember(peers_, peer.pubkey);
+        peers_[peer.pubkey] = nonstd::nullopt;
+      }
+      return true;
+    }
+
+    bool WsvOverlay::insertDomain(const model::Domain &domain) {
+      if (domain.domain_id.size() > DOMAIN_ID_SIZE
+          or getDomain(domain.domain_id)
+          or not roleExists(domain.default_role)) {
+        return false;
+      }
+      remember(domains_, domain.domain_id);
+      domains_[domain.domain_id] = domain;
+      return true;
+    }
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,180 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_OVERLAY_HPP
+#define IROHA_WSV_OVERLAY_HPP
+
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+
+#include <functional>
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * World state view, which keeps written changes in memory on top of
+     * read-through queries to committed state, so that transactions can be
+     * validated without writes to the database.
+     * Writes check the same key and size constraints as the database
+     * schema, and fail where the database statement would fail.
+     * Changes since last release are undone by rollback, which replaces
+     * savepoints of a database transaction.
+     * Account details are visible through getAccountDetail only, json data
+     * of accounts returned by getAccount is not updated.
+     */
+    class WsvOverlay : public WsvQuery, public WsvCommand {
+     public:
+      /**
+       * @param wsv - query to committed state
+       */
+      explicit WsvOverlay(WsvQuery &wsv);
+
+      /**
+       * Keep changes made since last release or rollback
+       */
+      void release();
+
+      /**
+       * Undo changes made since last release or rollback
+       */
+      void rollback();
+
+      /**
+       * Write all kept changes to another world state view, parents before
+       * rows referencing them
+       * @param command - world state view with the committed state, which
+       * this overlay reads
+       * @return true if all writes succeeded
+       */
+      bool flush(WsvCommand &command);
+
+      // ------------------------------| Query |------------------------------
+
+      bool hasAccountGrantablePermission(
+          const std::string &permitee_account_id,
+          const std::string &account_id,
+          const std::string &permission_id) override;
+      nonstd::optional<model::Domain> getDomain(
+          const std::string &domain_id) override;
+      nonstd::optional<std::vector<std::string>> getAccountRoles(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<std::string>> getRolePermissions(
+          const std::string &role_name) override;
+      nonstd::optional<model::PermissionSet> getAccountPermissions(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<std::string>> getRoles() override;
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::string> getAccountDetail(
+          const std::string &account_id,
+          const std::string &creator_account_id,
+          const std::string &detail) override;
+      nonstd::optional<std::vector<pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+      // -----------------------------| Command |-----------------------------
+
+      bool insertRole(const std::string &role_name) override;
+      bool insertAccountRole(const std::string &account_id,
+                             const std::string &role_name) override;
+      bool deleteAccountRole(const std::string &account_id,
+                             const std::string &role_name) override;
+      bool insertRolePermissions(
+          const std::string &role_id,
+          const std::set<std::string> &permissions) override;
+      bool insertAccountGrantablePermission(
+          const std::string &permittee_account_id,
+          const std::string &account_id,
+          const std::string &permission_id) override;
+      bool deleteAccountGrantablePermission(
+          const std::string &permittee_account_id,
+          const std::string &account_id,
+          const std::string &permission_id) override;
+      bool insertAccount(const model::Account &account) override;
+      bool updateAccount(const model::Account &account) override;
+      bool setAccountKV(const std::string &account_id,
+                        const std::string &creator_account_id,
+                        const std::string &key,
+                        const std::string &val) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool insertSignatory(const pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const pubkey_t &signatory) override;
+      bool deleteSignatory(const pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+
+     private:
+      /**
+       * Elements added to and removed from a committed collection
+       */
+      template <typename T>
+      struct Delta {
+        std::set<T> added;
+        std::set<T> removed;
+      };
+
+      using GrantableKey = std::tuple<std::string, std::string, std::string>;
+      using DetailKey = std::tuple<std::string, std::string, std::string>;
+
+      /**
+       * Record undo of a change of entry with given key
+       */
+      template <typename Map>
+      void remember(Map &map, const typename Map::key_type &key);
+
+      bool roleExists(const std::string &role_name);
+      bool accountExists(const std::string &account_id);
+
+      WsvQuery &wsv_;
+
+      std::set<std::string> roles_;
+      std::map<std::string, std::set<std::string>> role_permissions_;
+      std::map<std::string, Delta<std::string>> account_roles_;
+      std::map<GrantableKey, bool> grantable_permissions_;
+      std::map<std::string, model::Account> accounts_;
+      std::map<DetailKey, std::string> details_;
+      std::map<std::string, model::Asset> assets_;
+      std::map<std::pair<std::string, std::string>, model::AccountAsset>
+          account_assets_;
+      std::map<std::string, Delta<pubkey_t>> account_signatories_;
+      // deleted peers are nullopt
+      std::map<pubkey_t, nonstd::optional<model::Peer>> peers_;
+      std::map<std::string, model::Domain> domains_;
+
+      // changes since last release in order
+      std::vector<std::function<void()>> undo_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_OVERLAY_HPP
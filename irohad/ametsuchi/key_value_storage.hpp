@@ -0,0 +1,126 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_KEY_VALUE_STORAGE_HPP
+#define IROHA_KEY_VALUE_STORAGE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Type of storage key
+     */
+    using Identifier = uint32_t;
+
+    /**
+     * Read-only view of a stored blob. The view shares ownership of the
+     * memory it points to, so it stays valid as long as the view exists,
+     * regardless of the storage lifetime
+     */
+    class BlobView {
+     public:
+      BlobView(std::shared_ptr<const void> holder,
+               const uint8_t *data,
+               size_t size)
+          : holder_(std::move(holder)), data_(data), size_(size) {}
+
+      const uint8_t *data() const {
+        return data_;
+      }
+
+      size_t size() const {
+        return size_;
+      }
+
+      const uint8_t *begin() const {
+        return data_;
+      }
+
+      const uint8_t *end() const {
+        return data_ + size_;
+      }
+
+     private:
+      std::shared_ptr<const void> holder_;
+      const uint8_t *data_;
+      size_t size_;
+    };
+
+    /**
+     * Key-value storage of raw blocks, where keys are consecutive heights
+     */
+    class KeyValueStorage {
+     public:
+      /**
+       * Add entity with binary data
+       * @param id - reference key, must follow last_id()
+       * @param blob - data associated with key
+       * @return true if entity is written, false otherwise
+       */
+      virtual bool add(Identifier id, const std::vector<uint8_t> &blob) = 0;
+
+      /**
+       * Get data associated with
+       * @param id - reference key
+       * @return - blob, if exists
+       */
+      virtual nonstd::optional<std::vector<uint8_t>> get(
+          Identifier id) const = 0;
+
+      /**
+       * Get read-only view of data associated with key. Storages, which are
+       * not able to provide data without copying, return view of a copy
+       * @param id - reference key
+       * @return - view of blob, if exists
+       */
+      virtual nonstd::optional<BlobView> view(Identifier id) const {
+        auto blob = get(id);
+        if (not blob) {
+          return nonstd::nullopt;
+        }
+        auto holder = std::make_shared<std::vector<uint8_t>>(std::move(*blob));
+        return BlobView(holder, holder->data(), holder->size());
+      }
+
+      /**
+       * @return folder of storage
+       */
+      virtual std::string directory() const = 0;
+
+      /**
+       * @return maximal not null key
+       */
+      virtual Identifier last_id() const = 0;
+
+      /**
+       * Remove all entities from storage
+       */
+      virtual void dropAll() = 0;
+
+      virtual ~KeyValueStorage() = default;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_KEY_VALUE_STORAGE_HPP
@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 #include "model/domain.hpp"
+#include "model/permissions.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -73,6 +74,28 @@ namespace iroha {
       virtual nonstd::optional<std::vector<std::string>> getRolePermissions(
           const std::string &role_name) = 0;
 
+      /**
+       * Get permissions of all account's roles. Default implementation
+       * reads each role separately, storages resolve it in a single lookup
+       * @param account_id
+       * @return set of permissions, nullopt if roles cannot be read
+       */
+      virtual nonstd::optional<model::PermissionSet> getAccountPermissions(
+          const std::string &account_id) {
+        auto roles = getAccountRoles(account_id);
+        if (not roles) {
+          return nonstd::nullopt;
+        }
+        model::PermissionSet permissions;
+        for (const auto &role : *roles) {
+          auto role_permissions = getRolePermissions(role);
+          if (role_permissions) {
+            permissions |= model::makePermissionSet(*role_permissions);
+          }
+        }
+        return permissions;
+      }
+
       /**
        * @return All roles currently in the system
        */
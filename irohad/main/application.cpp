@@ -38,7 +38,8 @@ Irohad::Irohad(const std::string &block_store_dir,
                std::chrono::milliseconds proposal_delay,
                std::chrono::milliseconds vote_delay,
                std::chrono::milliseconds load_delay,
-               const keypair_t &keypair)
+               const keypair_t &keypair,
+               const StorageOptions &storage_options)
     : block_store_dir_(block_store_dir),
       redis_host_(redis_host),
       redis_port_(redis_port),
@@ -49,6 +50,7 @@ Irohad::Irohad(const std::string &block_store_dir,
       proposal_delay_(proposal_delay),
       vote_delay_(vote_delay),
       load_delay_(load_delay),
+      storage_options_(storage_options),
       keypair(keypair) {
   log_ = logger::log("IROHAD");
   log_->info("created");
@@ -90,8 +92,8 @@ void Irohad::init() {
 void Irohad::dropStorage() { storage->dropStorage(); }
 
 void Irohad::initStorage() {
-  storage =
-      StorageImpl::create(block_store_dir_, redis_host_, redis_port_, pg_conn_);
+  storage = StorageImpl::create(
+      block_store_dir_, redis_host_, redis_port_, pg_conn_, storage_options_);
 
   log_->info("[Init] => storage", logger::logBool(storage));
 }
@@ -111,7 +113,11 @@ void Irohad::initPeerQuery() {
 }
 
 void Irohad::initCryptoProvider() {
-  crypto_verifier = std::make_shared<ModelCryptoProviderImpl>(keypair);
+  verification_pool =
+      std::make_shared<ThreadPool>(std::thread::hardware_concurrency());
+  signature_cache = std::make_shared<SignatureCache>();
+  crypto_verifier = std::make_shared<ModelCryptoProviderImpl>(
+      keypair, verification_pool, signature_cache);
 
   log_->info("[Init] => crypto provider");
 }
@@ -119,7 +125,15 @@ void Irohad::initCryptoProvider() {
 void Irohad::initValidators() {
   stateless_validator =
       std::make_shared<StatelessValidatorImpl>(crypto_verifier);
-  stateful_validator = std::make_shared<StatefulValidatorImpl>();
+  // each worker beside the simulator thread validates on own temporary wsv,
+  // which holds a database connection; one connection is left for commits
+  auto validation_workers =
+      storage_options_.wsv == ametsuchi::WsvType::EMBEDDED
+      ? std::thread::hardware_concurrency()
+      : std::max<size_t>(storage_options_.connection_pool_size, 2) - 2;
+  validation_pool = std::make_shared<ThreadPool>(validation_workers);
+  stateful_validator =
+      std::make_shared<StatefulValidatorImpl>(storage, validation_pool);
   chain_validator = std::make_shared<ChainValidatorImpl>();
 
   log_->info("[Init] => validators");
@@ -175,15 +189,19 @@ void Irohad::initPeerCommunicationService() {
   pcs->on_proposal().subscribe(
       [this](auto) { log_->info("~~~~~~~~~| PROPOSAL ^_^ |~~~~~~~~~ "); });
 
-  pcs->on_commit().subscribe(
-      [this](auto) { log_->info("~~~~~~~~~| COMMIT =^._.^= |~~~~~~~~~ "); });
+  pcs->on_commit().subscribe([this](auto) {
+    log_->info("~~~~~~~~~| COMMIT =^._.^= |~~~~~~~~~ ");
+    log_->info("signature cache: {} hits, {} misses",
+               signature_cache->hits(),
+               signature_cache->misses());
+  });
 
   log_->info("[Init] => pcs");
 }
 
 void Irohad::initTransactionCommandService() {
-  auto tx_processor =
-      std::make_shared<TransactionProcessorImpl>(pcs, stateless_validator);
+  auto tx_processor = std::make_shared<TransactionProcessorImpl>(
+      pcs, stateless_validator, verification_pool);
 
   command_service = std::make_unique<::torii::CommandService>(
       pb_tx_factory, tx_processor, storage);
@@ -63,6 +63,7 @@ class Irohad {
    * @param load_delay - waiting time before loading committed block from next
    * peer
    * @param keypair - public and private keys for crypto provider
+   * @param storage_options - tunables of storage, e.g. block index backend
    */
   Irohad(const std::string &block_store_dir,
          const std::string &redis_host,
@@ -74,7 +75,9 @@ class Irohad {
          std::chrono::milliseconds proposal_delay,
          std::chrono::milliseconds vote_delay,
          std::chrono::milliseconds load_delay,
-         const iroha::keypair_t &keypair);
+         const iroha::keypair_t &keypair,
+         const iroha::ametsuchi::StorageOptions &storage_options =
+             iroha::ametsuchi::StorageOptions());
 
   /**
    * Initialization of whole objects in system
@@ -133,6 +136,7 @@ class Irohad {
   std::chrono::milliseconds proposal_delay_;
   std::chrono::milliseconds vote_delay_;
   std::chrono::milliseconds load_delay_;
+  iroha::ametsuchi::StorageOptions storage_options_;
 
   // ------------------------| internal dependencies |-------------------------
 
@@ -143,9 +147,12 @@ class Irohad {
       pb_query_response_factory;
 
   // crypto provider
+  std::shared_ptr<iroha::ThreadPool> verification_pool;
+  std::shared_ptr<iroha::model::SignatureCache> signature_cache;
   std::shared_ptr<iroha::model::ModelCryptoProvider> crypto_verifier;
 
   // validators
+  std::shared_ptr<iroha::ThreadPool> validation_pool;
   std::shared_ptr<iroha::validation::StatelessValidator> stateless_validator;
   std::shared_ptr<iroha::validation::StatefulValidator> stateful_validator;
   std::shared_ptr<iroha::validation::ChainValidator> chain_validator;
@@ -36,8 +36,24 @@ namespace config_members {
   const char* ProposalDelay = "proposal_delay";
   const char* VoteDelay = "vote_delay";
   const char* LoadDelay = "load_delay";
+  // optional members
+  const char* BlockIndex = "block_index";
+  const char* BlockStoreSync = "block_store_sync";
+  const char* SyncGroupSize = "sync_group_size";
+  const char* SyncGroupDelay = "sync_group_delay";
+  const char* Wsv = "wsv";
 }  // namespace config_members
 
+namespace config_values {
+  const char* RedisBlockIndex = "redis";
+  const char* EmbeddedBlockIndex = "embedded";
+  const char* SyncNone = "none";
+  const char* SyncEachBlock = "block";
+  const char* SyncGroup = "group";
+  const char* PostgresWsv = "postgres";
+  const char* EmbeddedWsv = "embedded";
+}  // namespace config_values
+
 /**
  * parse and assert trusted peers json in `iroha.conf`
  * @param iroha_conf_path
@@ -91,6 +107,51 @@ inline rapidjson::Document parse_iroha_config(std::string const& iroha_conf_path
   assert_fatal(doc.HasMember(mbr::LoadDelay), no_member_error(mbr::LoadDelay));
   assert_fatal(doc[mbr::LoadDelay].IsUint(),
                type_error(mbr::LoadDelay, "uint"));
+
+  if (doc.HasMember(mbr::BlockIndex)) {
+    assert_fatal(doc[mbr::BlockIndex].IsString(),
+                 type_error(mbr::BlockIndex, "string"));
+    const std::string block_index = doc[mbr::BlockIndex].GetString();
+    assert_fatal(block_index == config_values::RedisBlockIndex
+                     or block_index == config_values::EmbeddedBlockIndex,
+                 type_error(mbr::BlockIndex,
+                            std::string(config_values::RedisBlockIndex)
+                                + " or "
+                                + config_values::EmbeddedBlockIndex));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreSync)) {
+    assert_fatal(doc[mbr::BlockStoreSync].IsString(),
+                 type_error(mbr::BlockStoreSync, "string"));
+    const std::string sync = doc[mbr::BlockStoreSync].GetString();
+    assert_fatal(sync == config_values::SyncNone
+                     or sync == config_values::SyncEachBlock
+                     or sync == config_values::SyncGroup,
+                 type_error(mbr::BlockStoreSync,
+                            std::string(config_values::SyncNone) + ", "
+                                + config_values::SyncEachBlock + " or "
+                                + config_values::SyncGroup));
+  }
+
+  if (doc.HasMember(mbr::SyncGroupSize)) {
+    assert_fatal(doc[mbr::SyncGroupSize].IsUint(),
+                 type_error(mbr::SyncGroupSize, "uint"));
+  }
+
+  if (doc.HasMember(mbr::SyncGroupDelay)) {
+    assert_fatal(doc[mbr::SyncGroupDelay].IsUint(),
+                 type_error(mbr::SyncGroupDelay, "uint"));
+  }
+
+  if (doc.HasMember(mbr::Wsv)) {
+    assert_fatal(doc[mbr::Wsv].IsString(), type_error(mbr::Wsv, "string"));
+    const std::string wsv = doc[mbr::Wsv].GetString();
+    assert_fatal(wsv == config_values::PostgresWsv
+                     or wsv == config_values::EmbeddedWsv,
+                 type_error(mbr::Wsv,
+                            std::string(config_values::PostgresWsv) + " or "
+                                + config_values::EmbeddedWsv));
+  }
   return doc;
 }
 
@@ -43,6 +43,11 @@ DEFINE_string(genesis_block, "", "Specify file with initial block");
 DEFINE_string(keypair_name, "", "Specify name of .pub and .priv files");
 DEFINE_validator(keypair_name, &validate_keypair_name);
 
+DEFINE_bool(repair_block_store,
+            false,
+            "Verify all stored blocks on startup instead of the ones after "
+            "the last checkpoint");
+
 int main(int argc, char *argv[]) {
   auto log = logger::log("MAIN");
   log->info("start");
@@ -70,6 +75,35 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  iroha::ametsuchi::StorageOptions storage_options;
+  if (config.HasMember(mbr::BlockIndex)
+      and config[mbr::BlockIndex].GetString()
+          == std::string(config_values::EmbeddedBlockIndex)) {
+    storage_options.block_index = iroha::ametsuchi::BlockIndexType::EMBEDDED;
+  }
+  if (config.HasMember(mbr::Wsv)
+      and config[mbr::Wsv].GetString()
+          == std::string(config_values::EmbeddedWsv)) {
+    storage_options.wsv = iroha::ametsuchi::WsvType::EMBEDDED;
+  }
+  storage_options.repair_block_store = FLAGS_repair_block_store;
+  if (config.HasMember(mbr::BlockStoreSync)) {
+    const std::string sync = config[mbr::BlockStoreSync].GetString();
+    auto &policy = storage_options.block_store_sync;
+    if (sync == config_values::SyncEachBlock) {
+      policy.mode = iroha::ametsuchi::SyncMode::EACH_BLOCK;
+    } else if (sync == config_values::SyncGroup) {
+      policy.mode = iroha::ametsuchi::SyncMode::GROUP;
+    }
+    if (config.HasMember(mbr::SyncGroupSize)) {
+      policy.group_size = config[mbr::SyncGroupSize].GetUint();
+    }
+    if (config.HasMember(mbr::SyncGroupDelay)) {
+      policy.group_delay =
+          std::chrono::milliseconds(config[mbr::SyncGroupDelay].GetUint());
+    }
+  }
+
   Irohad irohad(config[mbr::BlockStorePath].GetString(),
                 config[mbr::RedisHost].GetString(),
                 config[mbr::RedisPort].GetUint(),
@@ -80,7 +114,8 @@ int main(int argc, char *argv[]) {
                 std::chrono::milliseconds(config[mbr::ProposalDelay].GetUint()),
                 std::chrono::milliseconds(config[mbr::VoteDelay].GetUint()),
                 std::chrono::milliseconds(config[mbr::LoadDelay].GetUint()),
-                keypair);
+                keypair,
+                storage_options);
 
   if (not irohad.storage) {
     log->error("Failed to initialize storage");
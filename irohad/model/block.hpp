@@ -19,6 +19,7 @@
 #define IROHA_BLOCK_HPP
 
 #include <common/types.hpp>
+#include <model/hash_memo.hpp>
 #include <model/proposal.hpp>
 #include <model/signature.hpp>
 #include <model/transaction.hpp>
@@ -84,6 +85,14 @@ namespace iroha {
 
       using TransactionsType = decltype(transactions);
 
+      /**
+       * Hash of this block filled by iroha::hash, unlike the hash field it is
+       * never taken from the sender
+       * NOT a part of payload, kept by copies, must be reset when payload
+       * is modified
+       */
+      HashMemo hash_memo;
+
       bool operator==(const Block& rhs) const;
       bool operator!=(const Block& rhs) const;
     };
@@ -51,6 +51,19 @@ namespace iroha {
 
       model::Block PbBlockFactory::deserialize(
           protocol::Block const& pb_block) const {
+        return deserialize(pb_block, iroha::hash(pb_block));
+      }
+
+      model::Block PbBlockFactory::deserialize(
+          protocol::Block const& pb_block, const hash256_t& hash) const {
+        auto block = deserializePayload(pb_block);
+        block.hash = hash;
+        block.hash_memo.set(block.hash);
+        return block;
+      }
+
+      model::Block PbBlockFactory::deserializePayload(
+          protocol::Block const& pb_block) const {
         model::Block block{};
         const auto& pl = pb_block.payload();
 
@@ -74,11 +87,9 @@ namespace iroha {
 
         for (const auto& pb_tx : pl.transactions()) {
           block.transactions.push_back(
-              *PbTransactionFactory::deserialize(pb_tx));
+              std::move(*PbTransactionFactory::deserialize(pb_tx)));
         }
 
-        block.hash = iroha::hash(pb_block);
-
         return block;
       }
     }  // namespace converters
@@ -157,6 +157,7 @@ namespace iroha {
         val->signature = sign;
         val->created_ts = pl.created_time();
         val->creator_account_id = pl.creator_account_id();
+        val->hash_memo.enable();
         return val;
       }
 
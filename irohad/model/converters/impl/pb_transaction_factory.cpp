@@ -72,7 +72,9 @@ namespace iroha {
               commandFactory.deserializeAbstractCommand(pb_command));
         }
 
-        return std::make_shared<model::Transaction>(tx);
+        auto result = std::make_shared<model::Transaction>(std::move(tx));
+        result->hash_memo.enable();
+        return result;
       }
 
     }  // namespace converters
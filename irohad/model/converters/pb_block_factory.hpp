@@ -45,6 +45,22 @@ namespace iroha {
          * @return model block
          */
          model::Block deserialize(const protocol::Block& pb_block) const;
+
+        /**
+         * Convert proto block with known hash to model block, the hash is not
+         * computed again
+         * @param pb_block - reference to proto block
+         * @param hash - hash of the block payload
+         * @return model block
+         */
+        model::Block deserialize(const protocol::Block& pb_block,
+                                 const hash256_t& hash) const;
+
+       private:
+        /**
+         * Convert proto block to model block without filling its hash
+         */
+        model::Block deserializePayload(const protocol::Block& pb_block) const;
       };
     }  // namespace converters
   }    // namespace model
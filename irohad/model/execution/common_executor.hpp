@@ -18,8 +18,8 @@
 #ifndef IROHA_COMMON_EXECUTOR_HPP
 #define IROHA_COMMON_EXECUTOR_HPP
 
-#include <set>
 #include "ametsuchi/wsv_query.hpp"
+#include "model/permissions.hpp"
 
 namespace iroha {
   namespace model {
@@ -28,9 +28,21 @@ namespace iroha {
      * Check that account has role permission
      * @param account_id - account to check
      * @param queries - WsvQueries
-     * @param permission_id  = permission to check
+     * @param permission  = permission to check
      * @return  True if account has permission, false otherwise
      */
+    bool checkAccountRolePermission(const std::string &account_id,
+                                    iroha::ametsuchi::WsvQuery &queries,
+                                    Permission permission);
+
+    /**
+     * Check that account has role permission given by name
+     * @param account_id - account to check
+     * @param queries - WsvQueries
+     * @param permission_id  = name of permission to check
+     * @return  True if account has permission, false otherwise or if
+     * permission is unknown
+     */
     bool checkAccountRolePermission(const std::string &account_id,
                                     iroha::ametsuchi::WsvQuery &queries,
                                     const std::string &permission_id);
@@ -41,17 +53,17 @@ namespace iroha {
      * @param queries - WSVqueries
      * @return set of account's role permissions
      */
-    nonstd::optional<std::set<std::string>> getAccountPermissions(
+    nonstd::optional<PermissionSet> getAccountPermissions(
         const std::string &account_id, iroha::ametsuchi::WsvQuery &queries);
 
     /**
      * Check if account has specific permission
      * @param perms - a set of account's permissions
-     * @param permission_id - specific permission to check
+     * @param permission - specific permission to check
      * @return true if the set contains permission
      */
-    bool accountHasPermission(const std::set<std::string> &perms,
-                              const std::string &permission_id);
+    bool accountHasPermission(const PermissionSet &perms,
+                              Permission permission);
   }
 }  // namespace iroha
 
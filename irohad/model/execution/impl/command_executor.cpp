@@ -75,7 +75,7 @@ namespace iroha {
         ametsuchi::WsvQuery &queries,
         const std::string &creator_account_id) {
       return checkAccountRolePermission(
-          creator_account_id, queries, can_append_role);
+          creator_account_id, queries, Permission::APPEND_ROLE);
     }
 
     bool AppendRoleExecutor::isValid(const Command &command,
@@ -84,26 +84,17 @@ namespace iroha {
 
       auto cmd_value = static_cast<const AppendRole &>(command);
       auto role_permissions = queries.getRolePermissions(cmd_value.role_name);
-      auto account_roles = queries.getAccountRoles(creator_account_id);
+      auto account_permissions =
+          getAccountPermissions(creator_account_id, queries);
 
-      if (not role_permissions.has_value() or not account_roles.has_value()) {
+      if (not role_permissions.has_value()
+          or not account_permissions.has_value()) {
         return false;
       }
 
-      std::set<std::string> account_permissions;
-      for (const auto &role : *account_roles) {
-        auto permissions = queries.getRolePermissions(role);
-        if (not permissions.has_value())
-          continue;
-        for (const auto &permission : *permissions)
-          account_permissions.insert(permission);
-      }
-
-      return std::none_of((*role_permissions).begin(),
-                          (*role_permissions).end(),
-                          [&account_permissions](const auto &perm) {
-                            return account_permissions.find(perm) == account_permissions.end();
-                          });
+      // all permissions of appended role must be held by creator
+      return (makePermissionSet(*role_permissions) & ~*account_permissions)
+          .none();
     }
 
     // ----------------------------| Detach Role |-----------------------------
@@ -126,7 +117,7 @@ namespace iroha {
         ametsuchi::WsvQuery &queries,
         const std::string &creator_account_id) {
       return checkAccountRolePermission(
-          creator_account_id, queries, can_detach_role);
+          creator_account_id, queries, Permission::DETACH_ROLE);
     }
 
     bool DetachRoleExecutor::isValid(const Command &command,
@@ -157,7 +148,7 @@ namespace iroha {
         ametsuchi::WsvQuery &queries,
         const std::string &creator_account_id) {
       return checkAccountRolePermission(
-          creator_account_id, queries, can_create_role);
+          creator_account_id, queries, Permission::CREATE_ROLE);
     }
 
     bool CreateRoleExecutor::isValid(const Command &command,
@@ -166,13 +157,17 @@ namespace iroha {
       auto cmd_value = static_cast<const CreateRole &>(command);
       cmd_value.role_name.size();
 
-      auto role_is_a_subset =
-          std::all_of(cmd_value.permissions.begin(),
-                      cmd_value.permissions.end(),
-                      [&queries, &creator_account_id](auto perm) {
-                        return checkAccountRolePermission(
-                            creator_account_id, queries, perm);
-                      });
+      auto account_permissions =
+          getAccountPermissions(creator_account_id, queries);
+      auto role_is_a_subset = account_permissions
+          and std::all_of(cmd_value.permissions.begin(),
+                          cmd_value.permissions.end(),
+                          [&account_permissions](const auto &perm) {
+                            auto permission = permissionOf(perm);
+                            return permission
+                                and accountHasPermission(*account_permissions,
+                                                         *permission);
+                          });
 
       return role_is_a_subset and not cmd_value.role_name.empty()
           and cmd_value.role_name.size() < 8 and
@@ -321,7 +316,7 @@ namespace iroha {
       // TODO: In future: Separate money creation for distinct assets
       return creator_account_id == cmd_value.account_id
           and checkAccountRolePermission(
-                  creator_account_id, queries, can_add_asset_qty);
+                  creator_account_id, queries, Permission::ADD_ASSET_QTY);
     }
 
     bool AddAssetQuantityExecutor::isValid(
@@ -383,7 +378,7 @@ namespace iroha {
         auto cmd_value = static_cast<const SubtractAssetQuantity &>(command);
         return creator_account_id == cmd_value.account_id
                and checkAccountRolePermission(
-          creator_account_id, queries, can_subtract_asset_qty);
+          creator_account_id, queries, Permission::SUBTRACT_ASSET_QTY);
       }
 
       bool SubtractAssetQuantityExecutor::isValid(const Command &command,
@@ -416,7 +411,7 @@ namespace iroha {
         ametsuchi::WsvQuery &queries,
         const std::string &creator_account_id) {
       return checkAccountRolePermission(
-          creator_account_id, queries, can_add_peer);
+          creator_account_id, queries, Permission::ADD_PEER);
     }
 
     bool AddPeerExecutor::isValid(const Command &command,
@@ -453,7 +448,7 @@ namespace iroha {
           // account and he has permission CanAddSignatory
           (add_signatory.account_id == creator_account_id
            and checkAccountRolePermission(
-                   creator_account_id, queries, can_add_signatory))
+                   creator_account_id, queries, Permission::ADD_SIGNATORY))
           or
           // Case 2. Creator has granted permission for it
           (queries.hasAccountGrantablePermission(
@@ -504,7 +499,7 @@ namespace iroha {
         const std::string &creator_account_id) {
       // Creator must have permission to create account
       return checkAccountRolePermission(
-          creator_account_id, queries, can_create_account);
+          creator_account_id, queries, Permission::CREATE_ACCOUNT);
     }
 
     bool CreateAccountExecutor::isValid(const Command &command,
@@ -546,7 +541,7 @@ namespace iroha {
         const std::string &creator_account_id) {
       // Creator must have permission to create assets
       return checkAccountRolePermission(
-          creator_account_id, queries, can_create_asset);
+          creator_account_id, queries, Permission::CREATE_ASSET);
     }
 
     bool CreateAssetExecutor::isValid(const Command &command,
@@ -589,7 +584,7 @@ namespace iroha {
         const std::string &creator_account_id) {
       // Creator must have permission to create domains
       return checkAccountRolePermission(
-          creator_account_id, queries, can_create_domain);
+          creator_account_id, queries, Permission::CREATE_DOMAIN);
     }
 
     bool CreateDomainExecutor::isValid(const Command &command,
@@ -638,8 +633,9 @@ namespace iroha {
           // 1. Creator removes signatory from their account, and he must have
           // permission on it
           (creator_account_id == remove_signatory.account_id
-           and checkAccountRolePermission(
-                   creator_account_id, queries, can_remove_signatory))
+           and checkAccountRolePermission(creator_account_id,
+                                          queries,
+                                          Permission::REMOVE_SIGNATORY))
           // 2. Creator has granted permission on removal
           or (queries.hasAccountGrantablePermission(creator_account_id,
                                                     remove_signatory.account_id,
@@ -734,7 +730,7 @@ namespace iroha {
           // 1. Creator set quorum for his account -> must have permission
           (creator_account_id == set_quorum.account_id
            and checkAccountRolePermission(
-                   creator_account_id, queries, can_set_quorum))
+                   creator_account_id, queries, Permission::SET_QUORUM))
           // 2. Creator has granted permission on it
           or (queries.hasAccountGrantablePermission(
                  creator_account_id, set_quorum.account_id, can_set_quorum));
@@ -850,10 +846,11 @@ namespace iroha {
               // 2. Creator transfer from their account
               (creator_account_id == transfer_asset.src_account_id
                and checkAccountRolePermission(
-                       creator_account_id, queries, can_transfer)))
+                       creator_account_id, queries, Permission::TRANSFER)))
           // For both cases, dest_account must have can_receive
-          and checkAccountRolePermission(
-                  transfer_asset.dest_account_id, queries, can_receive);
+          and checkAccountRolePermission(transfer_asset.dest_account_id,
+                                         queries,
+                                         Permission::RECEIVE);
     }
 
     bool TransferAssetExecutor::isValid(const Command &command,
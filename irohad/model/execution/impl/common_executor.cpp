@@ -22,47 +22,29 @@ using namespace iroha::ametsuchi;
 namespace iroha {
   namespace model {
 
-    nonstd::optional<std::set<std::string>> getAccountPermissions(
+    nonstd::optional<PermissionSet> getAccountPermissions(
         const std::string &account_id, iroha::ametsuchi::WsvQuery &queries) {
-      auto roles = queries.getAccountRoles(account_id);
-      if (not roles.has_value()) {
-        return nonstd::nullopt;
-      }
-      std::set<std::string> account_permissions;
-      std::for_each(roles.value().begin(),
-                    roles.value().end(),
-                    [&account_permissions, &queries](auto role) {
-                      auto perms = queries.getRolePermissions(role);
-                      if (perms.has_value()) {
-                        account_permissions.insert(perms.value().begin(),
-                                                   perms.value().end());
-                      }
-                    });
-      return account_permissions;
+      return queries.getAccountPermissions(account_id);
     }
 
-    bool accountHasPermission(const std::set<std::string> &perms,
-                              const std::string &permission_id) {
-      return perms.count(permission_id) == 1;
+    bool accountHasPermission(const PermissionSet &perms,
+                              Permission permission) {
+      return perms.test(static_cast<size_t>(permission));
     }
 
     bool checkAccountRolePermission(const std::string &account_id,
                                     WsvQuery &queries,
-                                    const std::string &permission_id) {
-      auto roleHasPermission = [&permission_id](auto permissions) {
-        return std::any_of(
-            permissions.begin(),
-            permissions.end(),
-            [&permission_id](auto perm) { return permission_id == perm; });
-      };
-
-      auto checkRolesPermission = [&](auto roles) {
-        return std::any_of(roles.begin(), roles.end(), [&](auto role) {
-          return queries.getRolePermissions(role) | roleHasPermission;
-        });
-      };
+                                    Permission permission) {
+      auto permissions = queries.getAccountPermissions(account_id);
+      return permissions and accountHasPermission(*permissions, permission);
+    }
 
-      return queries.getAccountRoles(account_id) | checkRolesPermission;
+    bool checkAccountRolePermission(const std::string &account_id,
+                                    WsvQuery &queries,
+                                    const std::string &permission_id) {
+      auto permission = permissionOf(permission_id);
+      return permission
+          and checkAccountRolePermission(account_id, queries, *permission);
     }
 
   }  // namespace model
@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_HASH_MEMO_HPP
+#define IROHA_HASH_MEMO_HPP
+
+#include <atomic>
+
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Hash of a model object, computed by iroha::hash on first request and
+     * written once.
+     * Only objects with payload fixed on construction, such as deserialized
+     * ones, enable the memo; hashes of objects assembled field by field are
+     * computed on every call.
+     * Copies keep the memo, so that an object passed along the pipeline is
+     * hashed once. An object, or a copy of it, whose payload is modified
+     * after the memo was enabled has to reset it.
+     */
+    class HashMemo {
+     public:
+      HashMemo() = default;
+
+      HashMemo(const HashMemo &other) {
+        copyFrom(other);
+      }
+
+      HashMemo(HashMemo &&other) {
+        copyFrom(other);
+        other.reset();
+      }
+
+      HashMemo &operator=(const HashMemo &other) {
+        if (this != &other) {
+          copyFrom(other);
+        }
+        return *this;
+      }
+
+      HashMemo &operator=(HashMemo &&other) {
+        if (this != &other) {
+          copyFrom(other);
+          other.reset();
+        }
+        return *this;
+      }
+
+      /**
+       * Start memoizing hash, payload must not be modified afterwards
+       */
+      void enable() {
+        auto expected = DISABLED;
+        state_.compare_exchange_strong(expected, EMPTY);
+      }
+
+      /**
+       * @param compute - function computing the hash
+       * @return hash, memoized by the first call if memo is enabled
+       */
+      template <typename Compute>
+      hash256_t get(Compute &&compute) const {
+        auto state = state_.load(std::memory_order_acquire);
+        if (state == FILLED) {
+          return hash_;
+        }
+        hash256_t hash = compute();
+        auto expected = EMPTY;
+        if (state == EMPTY
+            and state_.compare_exchange_strong(expected, WRITING)) {
+          hash_ = hash;
+          state_.store(FILLED, std::memory_order_release);
+        }
+        return hash;
+      }
+
+      /**
+       * Remember hash, which is already known, and enable the memo.
+       * Called before the object is shared
+       */
+      void set(const hash256_t &hash) {
+        hash_ = hash;
+        state_.store(FILLED, std::memory_order_release);
+      }
+
+      /**
+       * Forget hash and stop memoizing it
+       */
+      void reset() {
+        state_.store(DISABLED, std::memory_order_release);
+      }
+
+     private:
+      enum State : uint8_t { DISABLED, EMPTY, WRITING, FILLED };
+
+      void copyFrom(const HashMemo &other) {
+        auto state = other.state_.load(std::memory_order_acquire);
+        if (state == FILLED) {
+          hash_ = other.hash_;
+        } else if (state == WRITING) {
+          state = EMPTY;
+        }
+        state_.store(state, std::memory_order_release);
+      }
+
+      mutable std::atomic<State> state_{DISABLED};
+      mutable hash256_t hash_;
+    };
+
+  }  // namespace model
+}  // namespace iroha
+
+#endif  // IROHA_HASH_MEMO_HPP
@@ -48,15 +48,15 @@ std::string getDomainFromName(const std::string &account_id) {
 bool hasQueryPermission(const std::string &creator,
                         const std::string &target_account,
                         WsvQuery &wsv_query,
-                        const std::string &indiv_permission_id,
-                        const std::string &all_permission_id,
-                        const std::string &domain_permission_id) {
+                        Permission indiv_permission,
+                        Permission all_permission,
+                        Permission domain_permission) {
   auto perms_set = getAccountPermissions(creator, wsv_query);
   return
       // 1. Creator has grant permission from other user
       (creator != target_account
        and wsv_query.hasAccountGrantablePermission(
-               creator, target_account, indiv_permission_id))
+               creator, target_account, permissionName(indiv_permission)))
       or  // ----- Creator has role permission ---------
       (perms_set.has_value()
        and (
@@ -64,34 +64,34 @@ bool hasQueryPermission(const std::string &creator,
                // permission
                (creator == target_account
                 and accountHasPermission(perms_set.value(),
-                                         indiv_permission_id))
+                                         indiv_permission))
                or  // 3. Creator has global permission to get any account
                (accountHasPermission(perms_set.value(),
-                                     all_permission_id))
+                                     all_permission))
                or  // 4. Creator has domain permission
                (getDomainFromName(creator) == getDomainFromName(target_account)
                 and accountHasPermission(perms_set.value(),
-                                         domain_permission_id))));
+                                         domain_permission))));
 }
 
 bool QueryProcessingFactory::validate(
     const model::GetAssetInfo &query) {
   // TODO: check signatures
   return checkAccountRolePermission(
-      query.creator_account_id, *_wsvQuery, can_read_assets);
+      query.creator_account_id, *_wsvQuery, Permission::READ_ASSETS);
 }
 
 bool QueryProcessingFactory::validate(
     const model::GetRoles &query) {
   // TODO: check signatures
   return checkAccountRolePermission(
-      query.creator_account_id, *_wsvQuery, can_get_roles);
+      query.creator_account_id, *_wsvQuery, Permission::GET_ROLES);
 }
 
 bool QueryProcessingFactory::validate(const model::GetRolePermissions &query) {
   // TODO: check signatures
   return checkAccountRolePermission(
-      query.creator_account_id, *_wsvQuery, can_get_roles);
+      query.creator_account_id, *_wsvQuery, Permission::GET_ROLES);
 }
 
 bool QueryProcessingFactory::validate(
@@ -100,9 +100,9 @@ bool QueryProcessingFactory::validate(
   return hasQueryPermission(query.creator_account_id,
                             query.account_id,
                             *_wsvQuery,
-                            can_get_my_account,
-                            can_get_all_accounts,
-                            can_get_domain_accounts);
+                            Permission::GET_MY_ACCOUNT,
+                            Permission::GET_ALL_ACCOUNTS,
+                            Permission::GET_DOMAIN_ACCOUNTS);
 }
 
 bool QueryProcessingFactory::validate(
@@ -111,9 +111,9 @@ bool QueryProcessingFactory::validate(
   return hasQueryPermission(query.creator_account_id,
                             query.account_id,
                             *_wsvQuery,
-                            can_get_my_signatories,
-                            can_get_all_signatories,
-                            can_get_domain_signatories);
+                            Permission::GET_MY_SIGNATORIES,
+                            Permission::GET_ALL_SIGNATORIES,
+                            Permission::GET_DOMAIN_SIGNATORIES);
 }
 
 bool QueryProcessingFactory::validate(
@@ -122,9 +122,9 @@ bool QueryProcessingFactory::validate(
   return hasQueryPermission(query.creator_account_id,
                             query.account_id,
                             *_wsvQuery,
-                            can_get_my_acc_ast,
-                            can_get_all_acc_ast,
-                            can_get_domain_acc_ast);
+                            Permission::GET_MY_ACC_AST,
+                            Permission::GET_ALL_ACC_AST,
+                            Permission::GET_DOMAIN_ACC_AST);
 }
 
 bool QueryProcessingFactory::validate(
@@ -133,9 +133,9 @@ bool QueryProcessingFactory::validate(
   return hasQueryPermission(query.creator_account_id,
                             query.account_id,
                             *_wsvQuery,
-                            can_get_my_acc_detail,
-                            can_get_all_acc_detail,
-                            can_get_domain_acc_detail
+                            Permission::GET_MY_ACC_DETAIL,
+                            Permission::GET_ALL_ACC_DETAIL,
+                            Permission::GET_DOMAIN_ACC_DETAIL
                             );
 }
 
@@ -145,9 +145,9 @@ bool QueryProcessingFactory::validate(
   return hasQueryPermission(query.creator_account_id,
                             query.account_id,
                             *_wsvQuery,
-                            can_get_my_acc_txs,
-                            can_get_all_acc_txs,
-                            can_get_domain_acc_txs);
+                            Permission::GET_MY_ACC_TXS,
+                            Permission::GET_ALL_ACC_TXS,
+                            Permission::GET_DOMAIN_ACC_TXS);
 }
 
 bool QueryProcessingFactory::validate(
@@ -156,9 +156,9 @@ bool QueryProcessingFactory::validate(
   return hasQueryPermission(query.creator_account_id,
                             query.account_id,
                             *_wsvQuery,
-                            can_get_my_acc_ast_txs,
-                            can_get_all_acc_ast_txs,
-                            can_get_domain_acc_ast_txs);
+                            Permission::GET_MY_ACC_AST_TXS,
+                            Permission::GET_ALL_ACC_AST_TXS,
+                            Permission::GET_DOMAIN_ACC_AST_TXS);
 }
 
 std::shared_ptr<QueryResponse>
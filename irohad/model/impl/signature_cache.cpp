@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/signature_cache.hpp"
+
+namespace iroha {
+  namespace model {
+
+    constexpr size_t SignatureCache::DEFAULT_ENTRIES;
+    constexpr size_t SignatureCache::SHARDS;
+
+    namespace {
+      std::string makeKey(const std::string &message,
+                          const pubkey_t &pubkey,
+                          const sig_t &signature) {
+        return message + pubkey.to_string() + signature.to_string();
+      }
+    }  // namespace
+
+    SignatureCache::SignatureCache(size_t max_entries)
+        : shard_entries_((max_entries + SHARDS - 1) / SHARDS),
+          hits_(0),
+          misses_(0) {}
+
+    bool SignatureCache::contains(const std::string &message,
+                                  const pubkey_t &pubkey,
+                                  const sig_t &signature) {
+      if (shard_entries_ == 0) {
+        ++misses_;
+        return false;
+      }
+      auto key = makeKey(message, pubkey, signature);
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.lock);
+      auto it = shard.index.find(key);
+      if (it == shard.index.end()) {
+        ++misses_;
+        return false;
+      }
+      ++hits_;
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      return true;
+    }
+
+    void SignatureCache::put(const std::string &message,
+                             const pubkey_t &pubkey,
+                             const sig_t &signature) {
+      if (shard_entries_ == 0) {
+        return;
+      }
+      auto key = makeKey(message, pubkey, signature);
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.lock);
+      auto inserted = shard.index.emplace(std::move(key), shard.lru.end());
+      if (not inserted.second) {
+        return;
+      }
+      shard.lru.push_front(&inserted.first->first);
+      inserted.first->second = shard.lru.begin();
+      if (shard.index.size() > shard_entries_) {
+        auto victim = shard.index.find(*shard.lru.back());
+        shard.lru.pop_back();
+        shard.index.erase(victim);
+      }
+    }
+
+    size_t SignatureCache::hits() const {
+      return hits_;
+    }
+
+    size_t SignatureCache::misses() const {
+      return misses_;
+    }
+
+    SignatureCache::Shard &SignatureCache::shardOf(const std::string &key) {
+      return shards_[std::hash<std::string>()(key) % SHARDS];
+    }
+  }  // namespace model
+}  // namespace iroha
@@ -18,6 +18,9 @@
 #ifndef IROHA_MODEL_CRYPTO_PROVIDER_HPP
 #define IROHA_MODEL_CRYPTO_PROVIDER_HPP
 
+#include <memory>
+#include <vector>
+
 #include "model/block.hpp"
 #include "model/query.hpp"
 #include "model/transaction.hpp"
@@ -38,6 +41,15 @@ namespace iroha {
        */
       virtual bool verify(const Transaction &tx) const = 0;
 
+      /**
+       * Method for signature verification of a batch of transactions.
+       * @param transactions - transactions for verification
+       * @return verification result of each transaction, in the same order
+       */
+      virtual std::vector<bool> verify(
+          const std::vector<std::shared_ptr<const Transaction>> &transactions)
+          const = 0;
+
       /**
        * Method for signature verification of a query.
        * @param query - query for verification
@@ -31,14 +31,50 @@ namespace iroha {
     ModelCryptoProviderImpl::ModelCryptoProviderImpl(const keypair_t &keypair)
         : keypair_(keypair) {}
 
+    ModelCryptoProviderImpl::ModelCryptoProviderImpl(
+        const keypair_t &keypair,
+        std::shared_ptr<ThreadPool> pool,
+        std::shared_ptr<SignatureCache> signature_cache)
+        : keypair_(keypair),
+          pool_(std::move(pool)),
+          signature_cache_(std::move(signature_cache)) {}
+
     bool ModelCryptoProviderImpl::verify(const Transaction &tx) const {
-      return std::all_of(tx.signatures.begin(),
-                         tx.signatures.end(),
-                         [tx](const Signature &sig) {
-                           return iroha::verify(iroha::hash(tx).to_string(),
-                                                sig.pubkey,
-                                                sig.signature);
-                         });
+      auto tx_hash = iroha::hash(tx).to_string();
+      std::vector<iroha::SignatureCheck> checks;
+      for (const auto &sig : tx.signatures) {
+        checks.push_back({tx_hash, sig.pubkey, sig.signature});
+      }
+      auto valid = verifyBatch(checks);
+      return std::all_of(
+          valid.begin(), valid.end(), [](bool result) { return result; });
+    }
+
+    std::vector<bool> ModelCryptoProviderImpl::verify(
+        const std::vector<std::shared_ptr<const Transaction>> &transactions)
+        const {
+      std::vector<std::string> hashes(transactions.size());
+      forEach(transactions.size(), [&](size_t i) {
+        hashes[i] = iroha::hash(*transactions[i]).to_string();
+      });
+
+      std::vector<size_t> owners;
+      std::vector<iroha::SignatureCheck> checks;
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        for (const auto &sig : transactions[i]->signatures) {
+          owners.push_back(i);
+          checks.push_back({hashes[i], sig.pubkey, sig.signature});
+        }
+      }
+      auto valid = verifyBatch(checks);
+
+      std::vector<bool> result(transactions.size(), true);
+      for (size_t i = 0; i < checks.size(); ++i) {
+        if (not valid[i]) {
+          result[owners[i]] = false;
+        }
+      }
+      return result;
     }
 
     bool ModelCryptoProviderImpl::verify(const Query &query) const {
@@ -48,11 +84,14 @@ namespace iroha {
     }
 
     bool ModelCryptoProviderImpl::verify(const Block &block) const {
+      auto block_hash = iroha::hash(block).to_string();
+      std::vector<iroha::SignatureCheck> checks;
+      for (const auto &sig : block.sigs) {
+        checks.push_back({block_hash, sig.pubkey, sig.signature});
+      }
+      auto valid = verifyBatch(checks);
       return std::all_of(
-          block.sigs.begin(), block.sigs.end(), [block](const Signature &sig) {
-            return iroha::verify(
-                iroha::hash(block).to_string(), sig.pubkey, sig.signature);
-          });
+          valid.begin(), valid.end(), [](bool result) { return result; });
     }
 
     void ModelCryptoProviderImpl::sign(Block &block) const {
@@ -76,5 +115,57 @@ namespace iroha {
 
       query.signature = Signature{signature, keypair_.pubkey};
     }
+
+    std::vector<bool> ModelCryptoProviderImpl::verifyBatch(
+        const std::vector<iroha::SignatureCheck> &checks) const {
+      std::vector<bool> result(checks.size(), true);
+
+      // signatures verified before by any stage are skipped
+      std::vector<size_t> unknown;
+      std::vector<iroha::SignatureCheck> pending;
+      for (size_t i = 0; i < checks.size(); ++i) {
+        const auto &check = checks[i];
+        if (signature_cache_
+            and signature_cache_->contains(check.msg, check.pub, check.sig)) {
+          continue;
+        }
+        unknown.push_back(i);
+        pending.push_back(check);
+      }
+
+      // one batch per thread, the calling one included
+      auto threads = pool_ ? pool_->size() + 1 : 1;
+      auto batch_size =
+          std::max<size_t>(1, (pending.size() + threads - 1) / threads);
+      std::vector<std::vector<bool>> batches(
+          (pending.size() + batch_size - 1) / batch_size);
+      forEach(batches.size(), [&](size_t i) {
+        auto begin = pending.begin() + i * batch_size;
+        auto end = pending.begin()
+            + std::min(pending.size(), (i + 1) * batch_size);
+        batches[i] = iroha::verifyBatch({begin, end});
+      });
+
+      for (size_t i = 0; i < pending.size(); ++i) {
+        const auto &check = pending[i];
+        if (not batches[i / batch_size][i % batch_size]) {
+          result[unknown[i]] = false;
+        } else if (signature_cache_) {
+          signature_cache_->put(check.msg, check.pub, check.sig);
+        }
+      }
+      return result;
+    }
+
+    void ModelCryptoProviderImpl::forEach(
+        size_t count, const std::function<void(size_t)> &function) const {
+      if (pool_) {
+        pool_->parallelFor(count, function);
+        return;
+      }
+      for (size_t i = 0; i < count; ++i) {
+        function(i);
+      }
+    }
   }
 }
@@ -18,7 +18,13 @@
 #ifndef IROHA_MODEL_CRYPTO_PROVIDER_IMPL_HPP
 #define IROHA_MODEL_CRYPTO_PROVIDER_IMPL_HPP
 
+#include <functional>
+#include <memory>
+
+#include "cryptography/ed25519_sha3_impl/internal/ed25519_impl.hpp"
+#include "model/signature_cache.hpp"
 #include "model_crypto_provider.hpp"
+#include "thread_pool/thread_pool.hpp"
 
 namespace iroha {
   namespace model {
@@ -27,8 +33,25 @@ namespace iroha {
      public:
       explicit ModelCryptoProviderImpl(const keypair_t &keypair);
 
+      /**
+       * Create provider verifying signatures of blocks and transaction
+       * batches on the pool
+       * @param keypair - keypair for signing
+       * @param pool - pool for signature verification
+       * @param signature_cache - signatures known to be valid, which are
+       * not verified again; may be shared with other providers
+       */
+      ModelCryptoProviderImpl(
+          const keypair_t &keypair,
+          std::shared_ptr<ThreadPool> pool,
+          std::shared_ptr<SignatureCache> signature_cache);
+
       bool verify(const Transaction &tx) const override;
 
+      std::vector<bool> verify(
+          const std::vector<std::shared_ptr<const Transaction>> &transactions)
+          const override;
+
       bool verify(const Query &query) const override;
 
       bool verify(const Block &block) const override;
@@ -40,7 +63,24 @@ namespace iroha {
       void sign(Query &query) const override;
 
      private:
+      /**
+       * Skip signatures found in the cache, split the rest into a batch per
+       * thread and verify the batches on the pool
+       * @return validity of each signature, in the same order
+       */
+      std::vector<bool> verifyBatch(
+          const std::vector<iroha::SignatureCheck> &checks) const;
+
+      /**
+       * Call function for every index in [0, count), on the pool if there is
+       * one
+       */
+      void forEach(size_t count,
+                   const std::function<void(size_t)> &function) const;
+
       keypair_t keypair_;
+      std::shared_ptr<ThreadPool> pool_;
+      std::shared_ptr<SignatureCache> signature_cache_;
     };
   }
 }
@@ -18,8 +18,13 @@
 #ifndef IROHA_PERMISSIONS_HPP
 #define IROHA_PERMISSIONS_HPP
 
+#include <array>
+#include <bitset>
 #include <set>
 #include <string>
+#include <unordered_map>
+
+#include <nonstd/optional.hpp>
 
 namespace iroha {
   namespace model {
@@ -139,6 +144,155 @@ namespace iroha {
         can_add_peer,
         can_create_domain};
 
+    /**
+     * Role permissions enumerated at compile time, so that a set of them is
+     * a bitset and a check is a single bit test. Names above are used only
+     * at protocol and storage boundaries
+     */
+    enum class Permission : size_t {
+      APPEND_ROLE,
+      CREATE_ROLE,
+      DETACH_ROLE,
+      ADD_ASSET_QTY,
+      SUBTRACT_ASSET_QTY,
+      ADD_PEER,
+      ADD_SIGNATORY,
+      CREATE_ACCOUNT,
+      CREATE_ASSET,
+      CREATE_DOMAIN,
+      REMOVE_SIGNATORY,
+      SET_QUORUM,
+      TRANSFER,
+      RECEIVE,
+      SET_DETAIL,
+      READ_ASSETS,
+      GET_ROLES,
+      GET_MY_ACCOUNT,
+      GET_ALL_ACCOUNTS,
+      GET_DOMAIN_ACCOUNTS,
+      GET_MY_SIGNATORIES,
+      GET_ALL_SIGNATORIES,
+      GET_DOMAIN_SIGNATORIES,
+      GET_MY_ACC_AST,
+      GET_ALL_ACC_AST,
+      GET_DOMAIN_ACC_AST,
+      GET_MY_ACC_DETAIL,
+      GET_ALL_ACC_DETAIL,
+      GET_DOMAIN_ACC_DETAIL,
+      GET_MY_ACC_TXS,
+      GET_ALL_ACC_TXS,
+      GET_DOMAIN_ACC_TXS,
+      GET_MY_ACC_AST_TXS,
+      GET_ALL_ACC_AST_TXS,
+      GET_DOMAIN_ACC_AST_TXS,
+      GRANT_SET_QUORUM,
+      GRANT_ADD_SIGNATORY,
+      GRANT_REMOVE_SIGNATORY,
+      GRANT_TRANSFER,
+      GRANT_SET_DETAIL,
+      COUNT  // number of permissions, not a permission
+    };
+
+    constexpr size_t PERMISSIONS_COUNT =
+        static_cast<size_t>(Permission::COUNT);
+
+    using PermissionSet = std::bitset<PERMISSIONS_COUNT>;
+
+    /**
+     * @return names of permissions indexed by Permission
+     */
+    inline const std::array<std::string, PERMISSIONS_COUNT> &
+    permissionNames() {
+      // built from literals rather than from can_* names, which are
+      // distinct objects in each translation unit and may be not initialized
+      // yet when it is called during static initialization
+      static const std::array<std::string, PERMISSIONS_COUNT> names = {
+          {"CanAppendRole",
+           "CanCreateRole",
+           "CanDetachRole",
+           "CanAddAssetQuantity",
+           "CanSubtractAssetQuantity",
+           "CanAddPeer",
+           "CanAddSignatory",
+           "CanCreateAccount",
+           "CanCreateAsset",
+           "CanCreateDomain",
+           "CanRemoveSignatory",
+           "CanSetQuorum",
+           "CanTransfer",
+           "CanReceive",
+           "CanSetAccountInfo",
+           "CanReadAssets",
+           "CanGetRoles",
+           "CanGetMyAccount",
+           "CanGetAllAccounts",
+           "CanGetDomainAccounts",
+           "CanGetMySignatories",
+           "CanGetAllSignatories",
+           "CanGetDomainSignatories",
+           "CanGetMyAccountAssets",
+           "CanGetAllAccountAssets",
+           "CanGetDomainAccountAssets",
+           "CanGetMyAccountDetail",
+           "CanGetAllAccountDetail",
+           "CanGetDomainAccountDetail",
+           "CanGetMyAccountTransactions",
+           "CanGetAllAccountTransactions",
+           "CanGetDomainAccountTransactions",
+           "CanGetMyAccountAssetsTransactions",
+           "CanGetAllAccountAssetsTransactions",
+           "CanGetDomainAccountAssetsTransactions",
+           "CanGrantCanSetQuorum",
+           "CanGrantCanAddSignatory",
+           "CanGrantCanRemoveSignatory",
+           "CanGrantCanTransfer",
+           "CanGrantCanSetAccountInfo"}};
+      return names;
+    }
+
+    /**
+     * @param permission - enumerated permission
+     * @return name of permission
+     */
+    inline const std::string &permissionName(Permission permission) {
+      return permissionNames().at(static_cast<size_t>(permission));
+    }
+
+    /**
+     * @param name - name of permission
+     * @return enumerated permission, nullopt if name is unknown
+     */
+    inline nonstd::optional<Permission> permissionOf(const std::string &name) {
+      static const auto index = [] {
+        std::unordered_map<std::string, Permission> index;
+        const auto &names = permissionNames();
+        for (size_t i = 0; i < names.size(); ++i) {
+          index.emplace(names[i], static_cast<Permission>(i));
+        }
+        return index;
+      }();
+      auto it = index.find(name);
+      if (it == index.end()) {
+        return nonstd::nullopt;
+      }
+      return it->second;
+    }
+
+    /**
+     * @param names - collection of permission names
+     * @return set of known permissions, unknown names are skipped
+     */
+    template <typename Names>
+    PermissionSet makePermissionSet(const Names &names) {
+      PermissionSet permissions;
+      for (const auto &name : names) {
+        if (auto permission = permissionOf(name)) {
+          permissions.set(static_cast<size_t>(*permission));
+        }
+      }
+      return permissions;
+    }
+
   }  // namespace model
 }  // namespace iroha
 
@@ -20,6 +20,7 @@
 
 #include <string>
 #include "common/types.hpp"
+#include "model/hash_memo.hpp"
 #include "model/signature.hpp"
 
 namespace iroha {
@@ -51,6 +52,13 @@ namespace iroha {
        */
       uint64_t query_counter{};
 
+      /**
+       * Hash of the query, filled by iroha::hash
+       * NOT a part of payload, kept by copies, must be reset when payload
+       * is modified
+       */
+      HashMemo hash_memo;
+
       virtual ~Query() {}
     };
   }  // namespace model
@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SIGNATURE_CACHE_HPP
+#define IROHA_SIGNATURE_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Bounded LRU cache of signatures which were verified to be valid,
+     * keyed by (message hash, public key, signature). Shared by everything
+     * verifying signatures, so a transaction verified at Torii is not
+     * verified again when it comes back in a proposal or a block.
+     * Entries are split into shards with their own locks, so concurrent
+     * verification threads rarely wait for each other. Safe to use from
+     * multiple threads.
+     */
+    class SignatureCache {
+     public:
+      static constexpr size_t DEFAULT_ENTRIES = 100000;
+
+      /**
+       * @param max_entries - maximal number of cached signatures, zero
+       * disables the cache
+       */
+      explicit SignatureCache(size_t max_entries = DEFAULT_ENTRIES);
+
+      /**
+       * Check whether signature is known to be valid, and mark it as
+       * recently used
+       * @param message - signed message
+       * @param pubkey - public key of signatory
+       * @param signature - signature of the message
+       * @return true if the signature was put before and is not evicted
+       */
+      bool contains(const std::string &message,
+                    const pubkey_t &pubkey,
+                    const sig_t &signature);
+
+      /**
+       * Remember valid signature, evicting the least recently used one of
+       * its shard if it is full
+       * @param message - signed message
+       * @param pubkey - public key of signatory
+       * @param signature - valid signature of the message
+       */
+      void put(const std::string &message,
+               const pubkey_t &pubkey,
+               const sig_t &signature);
+
+      /**
+       * @return number of contains calls which found a signature
+       */
+      size_t hits() const;
+
+      /**
+       * @return number of contains calls which did not find a signature
+       */
+      size_t misses() const;
+
+     private:
+      static constexpr size_t SHARDS = 16;
+
+      /**
+       * Keys are stored once, in the index; the recency list points to them
+       */
+      struct Shard {
+        using Lru = std::list<const std::string *>;
+        Lru lru;
+        std::unordered_map<std::string, Lru::iterator> index;
+        std::mutex lock;
+      };
+
+      Shard &shardOf(const std::string &key);
+
+      const size_t shard_entries_;
+      std::array<Shard, SHARDS> shards_;
+
+      std::atomic<size_t> hits_;
+      std::atomic<size_t> misses_;
+    };
+  }  // namespace model
+}  // namespace iroha
+
+#endif  // IROHA_SIGNATURE_CACHE_HPP
@@ -21,6 +21,7 @@
 #include <common/types.hpp>
 #include <memory>
 #include <model/command.hpp>
+#include <model/hash_memo.hpp>
 #include <model/signature.hpp>
 #include <string>
 #include <vector>
@@ -74,6 +75,13 @@ namespace iroha {
 
       using CommandsType = decltype(commands);
 
+      /**
+       * Hash of PAYLOAD fields, filled by iroha::hash
+       * NOT a part of payload, kept by copies, must be reset when payload
+       * is modified
+       */
+      HashMemo hash_memo;
+
       bool operator==(const Transaction& rhs) const;
       bool operator!=(const Transaction& rhs) const;
     };
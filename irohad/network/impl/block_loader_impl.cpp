@@ -36,12 +36,8 @@ rxcpp::observable<Block> BlockLoaderImpl::retrieveBlocks(
     model::Peer::KeyType peer_pubkey) {
   return rxcpp::observable<>::create<Block>(
       [this, peer_pubkey](auto subscriber) {
-        nonstd::optional<Block> top_block;
-        block_query_->getTopBlocks(1)
-            .subscribe_on(rxcpp::observe_on_new_thread())
-            .as_blocking()
-            .subscribe([&top_block](auto block) { top_block = block; });
-        if (not top_block.has_value()) {
+        auto top_block = block_query_->getTopBlock();
+        if (not top_block) {
           log_->error("Failed to retrieve top block");
           subscriber.on_completed();
           return;
@@ -51,18 +51,11 @@ grpc::Status BlockLoaderService::retrieveBlock(
                         "Bad hash provided");
   }
 
-  nonstd::optional<protocol::Block> result;
-  storage_->getBlocksFrom(1)
-      .filter([hash](auto block) {
-        return block.hash == hash.value();
-      })
-      .map([this](auto block) { return factory_.serialize(block); })
-      .as_blocking()
-      .subscribe([&result](auto block) { result = block; });
-  if (not result.has_value()) {
+  auto block = storage_->getBlockByHash(hash.value());
+  if (not block) {
     log_->info("Cannot find block with requested hash");
     return grpc::Status(grpc::StatusCode::NOT_FOUND, "Block not found");
   }
-  response->CopyFrom(result.value());
+  response->CopyFrom(factory_.serialize(*block));
   return grpc::Status::OK;
 }
@@ -47,22 +47,22 @@ namespace iroha {
     void Simulator::process_proposal(model::Proposal proposal) {
       log_->info("process proposal");
       // Get last block from local ledger
-      block_queries_->getTopBlocks(1)
-          .as_blocking()
-          .subscribe([this](auto block) {
-            last_block = block;
-          });
-      if (not last_block.has_value()) {
+      last_block = block_queries_->getTopBlock();
+      if (not last_block) {
         log_->warn("Could not fetch last block");
         return;
       }
-      if (last_block.value().height + 1 != proposal.height) {
+      if (last_block->height + 1 != proposal.height) {
         log_->warn("Last block height: {}, proposal height: {}",
-                   last_block.value().height,
+                   last_block->height,
                    proposal.height);
         return;
       }
       auto temporaryStorage = ametsuchi_factory_->createTemporaryWsv();
+      if (not temporaryStorage) {
+        log_->error("Cannot create temporary storage");
+        return;
+      }
       notifier_.get_subscriber().on_next(
           validator_->validate(proposal, *temporaryStorage));
     }
@@ -71,11 +71,12 @@ namespace iroha {
       log_->info("process verified proposal");
       model::Block new_block;
       new_block.height = proposal.height;
-      new_block.prev_hash = last_block.value().hash;
+      new_block.prev_hash = last_block->hash;
       new_block.transactions = proposal.transactions;
       new_block.txs_number = proposal.transactions.size();
       new_block.created_ts = 0; // TODO 14/08/17 Muratov set timestamp from proposal & for new model IR-501
       new_block.hash = hash(new_block);
+      new_block.hash_memo.set(new_block.hash);
       crypto_provider_->sign(new_block);
 
       block_notifier_.get_subscriber().on_next(new_block);
@@ -32,15 +32,26 @@ namespace iroha {
     TransactionProcessorImpl::TransactionProcessorImpl(
         std::shared_ptr<PeerCommunicationService> pcs,
         std::shared_ptr<StatelessValidator> validator)
-        : pcs_(std::move(pcs)), validator_(std::move(validator)) {
+        : TransactionProcessorImpl(
+              std::move(pcs), std::move(validator), nullptr) {}
+
+    TransactionProcessorImpl::TransactionProcessorImpl(
+        std::shared_ptr<PeerCommunicationService> pcs,
+        std::shared_ptr<StatelessValidator> validator,
+        std::shared_ptr<ThreadPool> pool)
+        : pcs_(std::move(pcs)),
+          validator_(std::move(validator)),
+          pool_(std::move(pool)),
+          validating_(false) {
       log_ = logger::log("TxProcessor");
 
       // insert all txs from proposal to proposal set
       pcs_->on_proposal().subscribe([this](model::Proposal proposal) {
         for (const auto &tx : proposal.transactions) {
-          proposal_set_.insert(hash(tx).to_string());
+          auto tx_hash = hash(tx).to_string();
+          proposal_set_.insert(tx_hash);
           TransactionResponse response;
-          response.tx_hash = hash(tx).to_string();
+          response.tx_hash = tx_hash;
           response.current_status =
               TransactionResponse::STATELESS_VALIDATION_SUCCESS;
           notifier_.get_subscriber().on_next(
@@ -55,11 +66,12 @@ namespace iroha {
             // on next..
             [this](model::Block block) {
               for (const auto &tx : block.transactions) {
-                if (this->proposal_set_.count(hash(tx).to_string())) {
-                  proposal_set_.erase(hash(tx).to_string());
-                  candidate_set_.insert(hash(tx).to_string());
+                auto tx_hash = hash(tx).to_string();
+                if (this->proposal_set_.count(tx_hash)) {
+                  proposal_set_.erase(tx_hash);
+                  candidate_set_.insert(tx_hash);
                   TransactionResponse response;
-                  response.tx_hash = hash(tx).to_string();
+                  response.tx_hash = tx_hash;
                   response.current_status =
                       model::TransactionResponse::STATEFUL_VALIDATION_SUCCESS;
                   notifier_.get_subscriber().on_next(
@@ -91,15 +103,57 @@ namespace iroha {
       });
     }
 
+    TransactionProcessorImpl::~TransactionProcessorImpl() {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      validated_.wait(lock, [this] { return not validating_; });
+    }
+
     void TransactionProcessorImpl::transactionHandle(
         std::shared_ptr<model::Transaction> transaction) {
       log_->info("handle transaction");
+      if (not pool_) {
+        publish(transaction, validator_->validate(*transaction));
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      pending_.push_back(std::move(transaction));
+      if (not validating_) {
+        validating_ = true;
+        pool_->post([this] { this->validatePending(); });
+      }
+    }
+
+    void TransactionProcessorImpl::validatePending() {
+      while (true) {
+        std::vector<std::shared_ptr<model::Transaction>> batch;
+        {
+          std::lock_guard<std::mutex> lock(pending_mutex_);
+          if (pending_.empty()) {
+            validating_ = false;
+            validated_.notify_all();
+            return;
+          }
+          batch.swap(pending_);
+        }
+
+        auto result = validator_->validate(
+            std::vector<std::shared_ptr<const model::Transaction>>(
+                batch.begin(), batch.end()));
+        for (size_t i = 0; i < batch.size(); ++i) {
+          publish(batch[i], result[i]);
+        }
+      }
+    }
+
+    void TransactionProcessorImpl::publish(
+        std::shared_ptr<model::Transaction> transaction, bool valid) {
       model::TransactionResponse response;
       response.tx_hash = hash(*transaction).to_string();
       response.current_status =
           model::TransactionResponse::Status::STATELESS_VALIDATION_FAILED;
 
-      if (validator_->validate(*transaction)) {
+      if (valid) {
         response.current_status =
             TransactionResponse::Status::STATELESS_VALIDATION_SUCCESS;
         pcs_->propagate_transaction(transaction);
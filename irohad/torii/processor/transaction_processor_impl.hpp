@@ -18,9 +18,13 @@
 #ifndef IROHA_TRANSACTION_PROCESSOR_STUB_HPP
 #define IROHA_TRANSACTION_PROCESSOR_STUB_HPP
 
+#include <condition_variable>
+#include <mutex>
+
 #include "logger/logger.hpp"
 #include "model/transaction_response.hpp"
 #include "network/peer_communication_service.hpp"
+#include "thread_pool/thread_pool.hpp"
 #include "torii/processor/transaction_processor.hpp"
 #include "validation/stateless_validator.hpp"
 
@@ -36,6 +40,22 @@ namespace iroha {
           std::shared_ptr<network::PeerCommunicationService> pcs,
           std::shared_ptr<validation::StatelessValidator> validator);
 
+      /**
+       * @param pcs - provide information proposals and commits
+       * @param validator - perform stateless validation
+       * @param pool - run stateless validation off the calling thread,
+       * transactions arriving while a batch is validated form the next batch
+       */
+      TransactionProcessorImpl(
+          std::shared_ptr<network::PeerCommunicationService> pcs,
+          std::shared_ptr<validation::StatelessValidator> validator,
+          std::shared_ptr<ThreadPool> pool);
+
+      /**
+       * Wait for the batch being validated
+       */
+      ~TransactionProcessorImpl() override;
+
       void transactionHandle(
           std::shared_ptr<model::Transaction> transaction) override;
 
@@ -43,11 +63,28 @@ namespace iroha {
       transactionNotifier() override;
 
      private:
+      /**
+       * Validate pending transactions in batches until none is left
+       */
+      void validatePending();
+
+      /**
+       * Propagate transaction if it is valid and notify about its status
+       */
+      void publish(std::shared_ptr<model::Transaction> transaction,
+                   bool valid);
+
       // connections
       std::shared_ptr<network::PeerCommunicationService> pcs_;
 
       // processing
       std::shared_ptr<validation::StatelessValidator> validator_;
+      std::shared_ptr<ThreadPool> pool_;
+
+      std::vector<std::shared_ptr<model::Transaction>> pending_;
+      bool validating_;
+      std::mutex pending_mutex_;
+      std::condition_variable validated_;
 
       std::unordered_set<std::string> proposal_set_;
       std::unordered_set<std::string> candidate_set_;
@@ -0,0 +1,261 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/impl/conflict_groups.hpp"
+
+#include <numeric>
+#include <unordered_map>
+
+#include "common/types.hpp"
+
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/add_peer.hpp"
+#include "model/commands/add_signatory.hpp"
+#include "model/commands/append_role.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/create_role.hpp"
+#include "model/commands/detach_role.hpp"
+#include "model/commands/grant_permission.hpp"
+#include "model/commands/remove_signatory.hpp"
+#include "model/commands/revoke_permission.hpp"
+#include "model/commands/set_account_detail.hpp"
+#include "model/commands/set_quorum.hpp"
+#include "model/commands/subtract_asset_quantity.hpp"
+#include "model/commands/transfer_asset.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    namespace {
+      /**
+       * Part of world state view touched by a transaction
+       */
+      struct Access {
+        std::string key;
+        bool write;
+      };
+
+      // Account key covers the account row, its signatories, roles and
+      // grantable permissions given by it. Permissions of committed roles
+      // never change, permissions of roles created in the proposal are
+      // reached through the role key.
+      std::string account(const std::string &account_id) {
+        return "account:" + account_id;
+      }
+
+      std::string balance(const std::string &account_id,
+                          const std::string &asset_id) {
+        return "balance:" + account_id + "/" + asset_id;
+      }
+
+      std::string asset(const std::string &asset_id) {
+        return "asset:" + asset_id;
+      }
+
+      std::string domain(const std::string &domain_id) {
+        return "domain:" + domain_id;
+      }
+
+      std::string role(const std::string &role_name) {
+        return "role:" + role_name;
+      }
+
+      std::string detail(const std::string &account_id) {
+        return "detail:" + account_id;
+      }
+
+      std::string signatory(const pubkey_t &pubkey) {
+        return "signatory:" + pubkey.to_hexstring();
+      }
+
+      const std::string PEERS = "peers";
+
+      template <typename T>
+      const T *as(const model::Command &command) {
+        return instanceof <T>(command) ? static_cast<const T *>(&command)
+                                       : nullptr;
+      }
+
+      /**
+       * Append parts of world state view read and written by command, which
+       * is executed on behalf of creator
+       * @return false if footprint of command is unknown
+       */
+      bool footprint(const model::Command &command,
+                     const std::string &creator,
+                     std::vector<Access> &accesses) {
+        auto read = [&accesses](std::string key) {
+          accesses.push_back({std::move(key), false});
+        };
+        auto write = [&accesses](std::string key) {
+          accesses.push_back({std::move(key), true});
+        };
+
+        if (auto cmd = as<model::TransferAsset>(command)) {
+          read(account(cmd->src_account_id));
+          read(account(cmd->dest_account_id));
+          read(asset(cmd->asset_id));
+          write(balance(cmd->src_account_id, cmd->asset_id));
+          write(balance(cmd->dest_account_id, cmd->asset_id));
+        } else if (auto cmd = as<model::AddAssetQuantity>(command)) {
+          read(account(cmd->account_id));
+          read(asset(cmd->asset_id));
+          write(balance(cmd->account_id, cmd->asset_id));
+        } else if (auto cmd = as<model::SubtractAssetQuantity>(command)) {
+          read(account(cmd->account_id));
+          read(asset(cmd->asset_id));
+          write(balance(cmd->account_id, cmd->asset_id));
+        } else if (auto cmd = as<model::SetAccountDetail>(command)) {
+          read(account(cmd->account_id));
+          write(detail(cmd->account_id));
+        } else if (auto cmd = as<model::AddSignatory>(command)) {
+          write(account(cmd->account_id));
+          write(signatory(cmd->pubkey));
+        } else if (auto cmd = as<model::RemoveSignatory>(command)) {
+          write(account(cmd->account_id));
+          write(signatory(cmd->pubkey));
+        } else if (auto cmd = as<model::SetQuorum>(command)) {
+          write(account(cmd->account_id));
+        } else if (auto cmd = as<model::CreateAccount>(command)) {
+          read(domain(cmd->domain_id));
+          write(account(cmd->account_name + "@" + cmd->domain_id));
+          write(signatory(cmd->pubkey));
+        } else if (auto cmd = as<model::CreateAsset>(command)) {
+          read(domain(cmd->domain_id));
+          write(asset(cmd->asset_name + "#" + cmd->domain_id));
+        } else if (auto cmd = as<model::CreateDomain>(command)) {
+          read(role(cmd->user_default_role));
+          write(domain(cmd->domain_id));
+        } else if (auto cmd = as<model::CreateRole>(command)) {
+          write(role(cmd->role_name));
+        } else if (auto cmd = as<model::AppendRole>(command)) {
+          read(role(cmd->role_name));
+          write(account(cmd->account_id));
+        } else if (auto cmd = as<model::DetachRole>(command)) {
+          write(account(cmd->account_id));
+        } else if (auto cmd = as<model::GrantPermission>(command)) {
+          read(account(cmd->account_id));
+          write(account(creator));
+        } else if (auto cmd = as<model::RevokePermission>(command)) {
+          read(account(cmd->account_id));
+          write(account(creator));
+        } else if (as<model::AddPeer>(command)) {
+          write(PEERS);
+        } else {
+          return false;
+        }
+        return true;
+      }
+
+      /**
+       * Disjoint sets of transaction indices
+       */
+      class DisjointSets {
+       public:
+        explicit DisjointSets(size_t size) : parents_(size) {
+          std::iota(parents_.begin(), parents_.end(), 0);
+        }
+
+        size_t find(size_t i) {
+          while (parents_[i] != i) {
+            parents_[i] = parents_[parents_[i]];
+            i = parents_[i];
+          }
+          return i;
+        }
+
+        void unite(size_t a, size_t b) {
+          a = find(a);
+          b = find(b);
+          // smaller index becomes root, so that roots are first transactions
+          if (a < b) {
+            parents_[b] = a;
+          } else if (b < a) {
+            parents_[a] = b;
+          }
+        }
+
+       private:
+        std::vector<size_t> parents_;
+      };
+
+      /**
+       * Transactions touching one part of world state view
+       */
+      struct Touches {
+        /// readers since the first writer, which are not joined yet
+        std::vector<size_t> readers;
+        nonstd::optional<size_t> writer;
+      };
+    }  // namespace
+
+    nonstd::optional<std::vector<ConflictGroup>> conflictGroups(
+        const std::vector<model::Transaction> &transactions) {
+      DisjointSets sets(transactions.size());
+      std::unordered_map<std::string, Touches> touches;
+      // typical transaction touches creator, two accounts, asset and two
+      // balances
+      touches.reserve(transactions.size() * 4);
+      std::vector<Access> accesses;
+
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        const auto &tx = transactions[i];
+        accesses.clear();
+        // quorum, signatories and permissions of creator
+        accesses.push_back({account(tx.creator_account_id), false});
+        for (const auto &command : tx.commands) {
+          if (not command
+              or not footprint(*command, tx.creator_account_id, accesses)) {
+            return nonstd::nullopt;
+          }
+        }
+
+        // reads of the same part do not conflict, so readers are joined
+        // only once the part is written
+        for (const auto &access : accesses) {
+          auto &touch = touches[access.key];
+          if (touch.writer) {
+            sets.unite(i, *touch.writer);
+          } else if (access.write) {
+            touch.writer = i;
+            for (auto reader : touch.readers) {
+              sets.unite(i, reader);
+            }
+            touch.readers.clear();
+          } else {
+            touch.readers.push_back(i);
+          }
+        }
+      }
+
+      std::vector<ConflictGroup> groups;
+      std::unordered_map<size_t, size_t> group_of_root;
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        auto root = sets.find(i);
+        auto group = group_of_root.emplace(root, groups.size());
+        if (group.second) {
+          groups.emplace_back();
+        }
+        groups[group.first->second].push_back(i);
+      }
+      return groups;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
@@ -0,0 +1,51 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CONFLICT_GROUPS_HPP
+#define IROHA_CONFLICT_GROUPS_HPP
+
+#include <nonstd/optional.hpp>
+#include <vector>
+
+#include "model/transaction.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Transactions of one group, as indices in proposal in ascending order
+     */
+    using ConflictGroup = std::vector<size_t>;
+
+    /**
+     * Split transactions into groups, such that no transaction reads or
+     * writes a part of world state view written by a transaction of another
+     * group. Parts are accounts with their signatories, roles and grantable
+     * permissions, balances, assets, domains, roles, signatories and peers.
+     * Applying the groups independently in order of the proposal then gives
+     * the same results as applying all transactions in order.
+     * @param transactions - transactions of proposal
+     * @return groups ordered by their first transaction, or nullopt if some
+     * command has unknown footprint and the proposal must be applied in order
+     */
+    nonstd::optional<std::vector<ConflictGroup>> conflictGroups(
+        const std::vector<model::Transaction> &transactions);
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_CONFLICT_GROUPS_HPP
@@ -16,13 +16,21 @@
  */
 
 #include "validation/impl/stateful_validator_impl.hpp"
+#include <algorithm>
+#include <exception>
 #include <numeric>
 #include <set>
 
 namespace iroha {
   namespace validation {
 
-    StatefulValidatorImpl::StatefulValidatorImpl() {
+    StatefulValidatorImpl::StatefulValidatorImpl()
+        : StatefulValidatorImpl(nullptr, nullptr) {}
+
+    StatefulValidatorImpl::StatefulValidatorImpl(
+        std::shared_ptr<ametsuchi::TemporaryFactory> factory,
+        std::shared_ptr<ThreadPool> pool)
+        : factory_(std::move(factory)), pool_(std::move(pool)) {
       log_ = logger::log("SFV");
     }
 
@@ -30,44 +38,126 @@ namespace iroha {
         const model::Proposal &proposal,
         ametsuchi::TemporaryWsv &temporaryWsv) {
       log_->info("transactions in proposal: {}", proposal.transactions.size());
-      auto checking_transaction = [this](auto &tx, auto &queries) {
-        return (queries.getAccount(tx.creator_account_id)
-        | [&](const auto &account) {
-              // Check if tx creator has account and has quorum to execute
-              // transaction
-              return tx.signatures.size() >= account.quorum
-                  ? queries.getSignatories(tx.creator_account_id)
-                  : nonstd::nullopt;
-            }
-        | [&](const auto &signatories) {
-            // Check if signatures in transaction are account signatory
-            return this->signaturesSubset(tx.signatures, signatories)
-                ? nonstd::make_optional(signatories)
-                : nonstd::nullopt;
-          }).has_value();
-      };
-
-      // Filter only valid transactions
-      auto filter = [&temporaryWsv, checking_transaction](auto &acc,
-                                                          const auto &tx) {
-        auto answer = temporaryWsv.apply(tx, checking_transaction);
-        if (answer) {
-          acc.push_back(tx);
-        }
-        return acc;
-      };
 
       auto &txs = proposal.transactions;
-      decltype(txs) valid = {};
+      auto groups = factory_ and pool_
+          ? conflictGroups(txs)
+          : nonstd::optional<std::vector<ConflictGroup>>{};
+      std::vector<char> applied;
+      if (groups and groups->size() > 1) {
+        log_->info("independent groups in proposal: {}", groups->size());
+        applied = applyGroups(txs, *groups, temporaryWsv);
+      } else {
+        applied = applyInOrder(txs, temporaryWsv);
+      }
+
+      std::vector<model::Transaction> valid;
+      for (size_t i = 0; i < txs.size(); ++i) {
+        if (applied[i]) {
+          valid.push_back(txs[i]);
+        }
+      }
 
-      model::Proposal validated_proposal(
-          std::accumulate(txs.begin(), txs.end(), valid, filter));
+      model::Proposal validated_proposal(std::move(valid));
       validated_proposal.height = proposal.height;
       log_->info("transactions in verified proposal: {}",
                  validated_proposal.transactions.size());
       return validated_proposal;
     }
 
+    bool StatefulValidatorImpl::checkSignatures(const model::Transaction &tx,
+                                                ametsuchi::WsvQuery &queries) {
+      return (queries.getAccount(tx.creator_account_id) |
+                  [&](const auto &account) {
+                    // Check if tx creator has account and has quorum to
+                    // execute transaction
+                    return tx.signatures.size() >= account.quorum
+                        ? queries.getSignatories(tx.creator_account_id)
+                        : nonstd::nullopt;
+                  }
+              | [&](const auto &signatories) {
+                  // Check if signatures in transaction are account signatory
+                  return this->signaturesSubset(tx.signatures, signatories)
+                      ? nonstd::make_optional(signatories)
+                      : nonstd::nullopt;
+                })
+          .has_value();
+    }
+
+    std::vector<char> StatefulValidatorImpl::applyInOrder(
+        const std::vector<model::Transaction> &transactions,
+        ametsuchi::TemporaryWsv &temporaryWsv) {
+      auto check = [this](const auto &tx, auto &queries) {
+        return this->checkSignatures(tx, queries);
+      };
+      std::vector<char> applied;
+      applied.reserve(transactions.size());
+      for (const auto &tx : transactions) {
+        applied.push_back(temporaryWsv.apply(tx, check));
+      }
+      return applied;
+    }
+
+    std::vector<char> StatefulValidatorImpl::applyGroups(
+        const std::vector<model::Transaction> &transactions,
+        const std::vector<ConflictGroup> &groups,
+        ametsuchi::TemporaryWsv &temporaryWsv) {
+      // every worker has own temporary wsv, the given one is used by the
+      // first worker. Groups do not see changes of each other, so one wsv
+      // may apply several of them
+      std::vector<std::unique_ptr<ametsuchi::TemporaryWsv>> wsvs;
+      auto workers = std::min(groups.size(), pool_->size() + 1);
+      while (wsvs.size() + 1 < workers) {
+        auto wsv = factory_->createTemporaryWsv();
+        if (not wsv) {
+          log_->warn("Cannot create temporary wsv, {} workers are used",
+                     wsvs.size() + 1);
+          break;
+        }
+        wsvs.push_back(std::move(wsv));
+      }
+      workers = wsvs.size() + 1;
+
+      // largest groups first to the least loaded worker
+      std::vector<size_t> order(groups.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&groups](auto a, auto b) {
+        return groups[a].size() > groups[b].size();
+      });
+      std::vector<std::vector<size_t>> assigned(workers);
+      for (auto group : order) {
+        auto &worker = *std::min_element(
+            assigned.begin(), assigned.end(), [](const auto &a, const auto &b) {
+              return a.size() < b.size();
+            });
+        worker.insert(worker.end(), groups[group].begin(), groups[group].end());
+      }
+
+      auto check = [this](const auto &tx, auto &queries) {
+        return this->checkSignatures(tx, queries);
+      };
+      std::vector<char> applied(transactions.size(), false);
+      std::vector<std::exception_ptr> errors(workers);
+      pool_->parallelFor(workers, [&](size_t worker) {
+        auto &wsv = worker == 0 ? temporaryWsv : *wsvs[worker - 1];
+        auto &indices = assigned[worker];
+        std::sort(indices.begin(), indices.end());
+        try {
+          for (auto i : indices) {
+            applied[i] = wsv.apply(transactions[i], check);
+          }
+        } catch (...) {
+          errors[worker] = std::current_exception();
+        }
+      });
+      for (const auto &error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+      return applied;
+    }
+
     bool StatefulValidatorImpl::signaturesSubset(
         const model::Transaction::SignaturesType &signatures,
         const std::vector<pubkey_t> &public_keys) {
@@ -19,7 +19,10 @@
 
 #include "validation/stateful_validator.hpp"
 
+#include "ametsuchi/temporary_factory.hpp"
 #include "logger/logger.hpp"
+#include "thread_pool/thread_pool.hpp"
+#include "validation/impl/conflict_groups.hpp"
 
 namespace iroha {
   namespace validation {
@@ -31,6 +34,18 @@ namespace iroha {
      public:
       StatefulValidatorImpl();
 
+      /**
+       * Validator, which splits proposal into groups of transactions touching
+       * disjoint parts of world state view and applies the groups on the
+       * pool. Verified proposal is the same as of sequential validation.
+       * @param factory - source of additional temporary world state views for
+       * groups validated concurrently with the given one
+       * @param pool - pool to apply groups on, nullptr validates in order
+       */
+      StatefulValidatorImpl(
+          std::shared_ptr<ametsuchi::TemporaryFactory> factory,
+          std::shared_ptr<ThreadPool> pool);
+
       /**
        * Function perform stateful validation on proposal
        * and return proposal with valid transactions
@@ -44,6 +59,33 @@ namespace iroha {
                                ametsuchi::TemporaryWsv &temporaryWsv) override;
 
      private:
+      /**
+       * Checks if creator of transaction has quorum and signatures belong to
+       * its signatories
+       * @param tx - transaction to check
+       * @param queries - world state view the transaction is applied to
+       * @return true if transaction is signed by its creator
+       */
+      bool checkSignatures(const model::Transaction &tx,
+                           ametsuchi::WsvQuery &queries);
+
+      /**
+       * Apply transactions one after another
+       * @return flags of applied transactions in order of proposal
+       */
+      std::vector<char> applyInOrder(
+          const std::vector<model::Transaction> &transactions,
+          ametsuchi::TemporaryWsv &temporaryWsv);
+
+      /**
+       * Apply groups of independent transactions concurrently
+       * @return flags of applied transactions in order of proposal
+       */
+      std::vector<char> applyGroups(
+          const std::vector<model::Transaction> &transactions,
+          const std::vector<ConflictGroup> &groups,
+          ametsuchi::TemporaryWsv &temporaryWsv);
+
       /**
        * Checks if public keys of signatures are present in vector of pubkeys
        * @param signatures - collection of signatures
@@ -55,6 +97,9 @@ namespace iroha {
           const model::Transaction::SignaturesType &signatures,
           const std::vector<pubkey_t> &public_keys);
 
+      std::shared_ptr<ametsuchi::TemporaryFactory> factory_;
+      std::shared_ptr<ThreadPool> pool_;
+
       logger::Logger log_;
     };
   }  // namespace validation
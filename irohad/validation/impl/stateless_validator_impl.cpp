@@ -40,6 +40,35 @@ namespace iroha {
         return false;
       }
 
+      if (not validateTimestamp(transaction)) {
+        return false;
+      }
+
+      log_->info("transaction validated");
+      return true;
+    }
+
+    std::vector<bool> StatelessValidatorImpl::validate(
+        const std::vector<std::shared_ptr<const model::Transaction>>
+            &transactions) const {
+      auto result = crypto_provider_->verify(transactions);
+      size_t validated = 0;
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        if (not result[i]) {
+          log_->warn("crypto verification broken");
+          continue;
+        }
+        result[i] = validateTimestamp(*transactions[i]);
+        validated += result[i];
+      }
+
+      log_->info(
+          "{} of {} transactions validated", validated, transactions.size());
+      return result;
+    }
+
+    bool StatelessValidatorImpl::validateTimestamp(
+        const model::Transaction &transaction) const {
       // time between creation and validation of tx
       ts64_t now = time::now();
 
@@ -58,7 +87,6 @@ namespace iroha {
         return false;
       }
 
-      log_->info("transaction validated");
       return true;
     }
 
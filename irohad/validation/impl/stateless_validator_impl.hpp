@@ -31,9 +31,17 @@ namespace iroha {
       explicit StatelessValidatorImpl(
           std::shared_ptr<model::ModelCryptoProvider> crypto_provider);
       bool validate(const model::Transaction &transaction) const override;
+      std::vector<bool> validate(
+          const std::vector<std::shared_ptr<const model::Transaction>>
+              &transactions) const override;
       bool validate(const model::Query &query) const override;
 
      private:
+      /**
+       * Check that transaction is neither from future nor too old
+       */
+      bool validateTimestamp(const model::Transaction &transaction) const;
+
       static constexpr auto MAX_DELAY =
           std::chrono::hours(24)
           / std::chrono::milliseconds(
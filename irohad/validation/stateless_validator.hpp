@@ -19,6 +19,7 @@
 #define IROHA_STATELESS_VALIDATOR_HPP
 
 #include <memory>
+#include <vector>
 #include "model/query.hpp"
 #include "model/transaction.hpp"
 
@@ -28,6 +29,15 @@ namespace iroha {
     class StatelessValidator {
      public:
       virtual bool validate(const model::Transaction &transaction) const = 0;
+
+      /**
+       * Validate batch of transactions, verifying their signatures together
+       * @param transactions - transactions to validate
+       * @return validation result of each transaction, in the same order
+       */
+      virtual std::vector<bool> validate(
+          const std::vector<std::shared_ptr<const model::Transaction>>
+              &transactions) const = 0;
       virtual bool validate(const model::Query &query) const = 0;
     };
   }
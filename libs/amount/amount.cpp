@@ -17,26 +17,14 @@
 
 #include <utility>
 
+#include <algorithm>
+#include <limits>
+
 #include <logger/logger.hpp>
-#include <regex>
 #include "amount/amount.hpp"
 
 namespace iroha {
 
-  // to raise to power integer values
-  int ipow(int base, int exp) {
-    int result = 1;
-    while (exp != 0) {
-      if (exp & 1) {
-        result *= base;
-      }
-      exp >>= 1;
-      base *= base;
-    }
-
-    return result;
-  }
-
   uint256_t getJointUint256(uint64_t first,
                             uint64_t second,
                             uint64_t third,
@@ -53,12 +41,26 @@ namespace iroha {
     return res;
   }
 
+  FixedUint256 toFixed(const uint256_t &value) {
+    FixedUint256::Limbs limbs;
+    for (int i = 0; i < 4; i++) {
+      limbs[3 - i] = static_cast<uint64_t>(
+          (value >> i * 64) & std::numeric_limits<uint64_t>::max());
+    }
+    return FixedUint256(limbs);
+  }
+
+  uint256_t toBoost(const FixedUint256 &value) {
+    const auto &limbs = value.limbs();
+    return getJointUint256(limbs[0], limbs[1], limbs[2], limbs[3]);
+  }
+
   Amount::Amount() {}
 
-  Amount::Amount(uint256_t value) : value_(value) {}
+  Amount::Amount(uint256_t value) : value_(toFixed(value)) {}
 
   Amount::Amount(uint256_t amount, uint8_t precision)
-      : value_(amount), precision_(precision) {}
+      : value_(toFixed(amount)), precision_(precision) {}
 
   Amount::Amount(uint64_t first,
                  uint64_t second,
@@ -71,9 +73,11 @@ namespace iroha {
                  uint64_t third,
                  uint64_t fourth,
                  uint8_t precision)
-      : precision_(precision) {
-    value_ = getJointUint256(first, second, third, fourth);
-  }
+      : value_(FixedUint256::Limbs{{first, second, third, fourth}}),
+        precision_(precision) {}
+
+  Amount::Amount(FixedUint256 value, uint8_t precision)
+      : value_(value), precision_(precision) {}
 
   Amount::Amount(const Amount &am)
       : value_(am.value_), precision_(am.precision_) {}
@@ -95,56 +99,58 @@ namespace iroha {
   }
 
   nonstd::optional<Amount> Amount::createFromString(std::string str_amount) {
-    // check if valid number
-    std::regex e("([0-9]*\\.[0-9]+|[0-9]+)");
-    if (!std::regex_match(str_amount, e)) {
+    // check if valid number: digits with optional dot followed by digits
+    auto dot_place = str_amount.find('.');
+    auto is_digit = [](char c) { return c >= '0' and c <= '9'; };
+    if (str_amount.empty() or dot_place == str_amount.size() - 1
+        or not std::all_of(str_amount.begin(),
+                           str_amount.end(),
+                           [&is_digit](char c) {
+                             return is_digit(c) or c == '.';
+                           })
+        or std::count(str_amount.begin(), str_amount.end(), '.') > 1) {
       return nonstd::nullopt;
     }
 
     // get precision
-    auto dot_place = str_amount.find('.');
     size_t precision;
     if (dot_place > str_amount.size()) {
       precision = 0;
     } else {
       precision = str_amount.size() - dot_place - 1;
       // erase dot from the string
-      str_amount.erase(std::remove(str_amount.begin(), str_amount.end(), '.'),
-                       str_amount.end());
+      str_amount.erase(dot_place, 1);
     }
 
     auto begin = str_amount.find_first_not_of('0');
 
     // create uint256 value from obtained string
-    uint256_t value = 0;
-    if (begin <= str_amount.size()) {
-      value = uint256_t(str_amount.substr(begin));
+    auto value = begin < str_amount.size()
+        ? FixedUint256::fromString(str_amount.substr(begin))
+        : FixedUint256();
+    if (not value) {
+      return nonstd::nullopt;
     }
-    return Amount(value, precision);
+    return Amount(*value, precision);
   }
 
-  uint256_t Amount::getIntValue() { return value_; }
+  uint256_t Amount::getIntValue() { return toBoost(value_); }
 
   uint8_t Amount::getPrecision() { return precision_; }
 
   std::vector<uint64_t> Amount::to_uint64s() {
-    std::vector<uint64_t> array(4);
-    ;
-    for (int i = 0; i < 4; i++) {
-      uint64_t res = (value_ >> i * 64).convert_to<uint64_t>();
-      array[3 - i] = res;
-    }
-    return array;
+    const auto &limbs = value_.limbs();
+    return std::vector<uint64_t>(limbs.begin(), limbs.end());
   }
 
   Amount Amount::percentage(uint256_t percents) const {
-    uint256_t new_val = value_ * percents / 100;
+    uint256_t new_val = toBoost(value_) * percents / 100;
     return {new_val, precision_};
   }
 
   Amount Amount::percentage(const Amount &am) const {
     // multiply two amount values
-    uint256_t new_value = value_ * am.value_;
+    uint256_t new_value = toBoost(value_) * toBoost(am.value_);
 
     // new value should be decreased by the scale of am to move floating point
     // to the left, as it is done when we multiply manually
@@ -154,25 +160,34 @@ namespace iroha {
     return {new_value, precision_};
   }
 
-  Amount Amount::add(const Amount &other) const {
-    auto new_val = value_ + other.value_;
-    return {new_val, precision_};
+  nonstd::optional<Amount> Amount::add(const Amount &other) const {
+    auto new_val = value_.add(other.value_);
+    if (not new_val) {
+      return nonstd::nullopt;
+    }
+    return Amount(*new_val, precision_);
   }
 
-  Amount Amount::subtract(const Amount &other) const {
-    auto new_val = value_ - other.value_;
-    return {new_val, precision_};
+  nonstd::optional<Amount> Amount::subtract(const Amount &other) const {
+    auto new_val = value_.subtract(other.value_);
+    if (not new_val) {
+      return nonstd::nullopt;
+    }
+    return Amount(*new_val, precision_);
   }
 
   int Amount::compareTo(const Amount &other) const {
     if (precision_ == other.precision_) {
-      return (value_ < other.value_) ? -1 : (value_ > other.value_) ? 1 : 0;
+      return value_.compare(other.value_);
+    }
+    // when different precisions transform to have the same scale, value
+    // which overflows on scaling is greater than any other
+    if (precision_ < other.precision_) {
+      auto scaled = value_.scale(other.precision_ - precision_);
+      return scaled ? scaled->compare(other.value_) : 1;
     }
-    // when different precisions transform to have the same scale
-    auto max_precision = std::max(precision_, other.precision_);
-    auto val1 = value_ * ipow(10, max_precision - precision_);
-    auto val2 = other.value_ * ipow(10, max_precision - other.precision_);
-    return (val1 < val2) ? -1 : (val1 > val2) ? 1 : 0;
+    auto scaled = other.value_.scale(precision_ - other.precision_);
+    return scaled ? value_.compare(*scaled) : -1;
   }
 
   bool Amount::operator==(const Amount &other) const {
@@ -200,11 +215,13 @@ namespace iroha {
   }
 
   std::string Amount::to_string() const {
+    auto digits = value_.toString();
     if (precision_ > 0) {
-      cpp_dec_float_50 float50(value_);
-      float50 /= pow(10, precision_);
-      return float50.str(precision_, std::ios_base::fixed);
+      if (digits.size() <= precision_) {
+        digits.insert(0, precision_ + 1 - digits.size(), '0');
+      }
+      digits.insert(digits.size() - precision_, 1, '.');
     }
-    return value_.str(0, std::ios_base::fixed);
+    return digits;
   }
 }  // namespace iroha
@@ -23,6 +23,8 @@
 #include <nonstd/optional.hpp>
 #include <string>
 
+#include "amount/fixed_uint256.hpp"
+
 namespace iroha {
 
   using namespace boost::multiprecision;
@@ -104,12 +106,7 @@ namespace iroha {
       if (a->precision_ != b->precision_) {
         return nonstd::nullopt;
       }
-      auto res = a->add(*b);
-      // check overflow
-      if (res.value_ < a->value_ or res.value_ < b->value_) {
-        return nonstd::nullopt;
-      }
-      return res;
+      return a->add(*b);
     }
 
     /**
@@ -126,10 +123,6 @@ namespace iroha {
       if (a->precision_ != b->precision_) {
         return nonstd::nullopt;
       }
-      // check if a greater than b
-      if (a->value_ < b->value_) {
-        return nonstd::nullopt;
-      }
       return a->subtract(*b);
     }
 
@@ -160,18 +153,18 @@ namespace iroha {
 
     /**
      * Sums two amounts.
-     * @return
+     * @return sum, nullopt on overflow
      */
-    Amount add(const Amount&) const;
+    nonstd::optional<Amount> add(const Amount&) const;
     /**
      * Subtracts one amount from another.
-     * Requires to have the same scale between both amounts.
-     * Otherwise nullopt is returned
-     * @return
+     * @return difference, nullopt if other amount is greater
      */
-    Amount subtract(const Amount&) const;
+    nonstd::optional<Amount> subtract(const Amount&) const;
+
+    Amount(FixedUint256 value, uint8_t precision);
 
-    boost::multiprecision::uint256_t value_{0};
+    FixedUint256 value_;
     uint8_t precision_{0};
   };
 }
@@ -0,0 +1,212 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_FIXED_UINT256_HPP
+#define IROHA_FIXED_UINT256_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <nonstd/optional.hpp>
+
+namespace iroha {
+
+  /**
+   * Unsigned 256-bit integer of four 64-bit limbs, most significant limb
+   * first, which is the layout of Amount::to_uint64s.
+   * Arithmetic reports overflow instead of wrapping around.
+   */
+  class FixedUint256 {
+   public:
+    using Limbs = std::array<uint64_t, 4>;
+
+    /// largest power of ten, which fits into a limb
+    static constexpr uint64_t LIMB_POWER_OF_TEN = 10000000000000000000ull;
+    static constexpr size_t LIMB_DIGITS = 19;
+
+    FixedUint256() = default;
+
+    explicit FixedUint256(uint64_t value) : limbs_{{0, 0, 0, value}} {}
+
+    explicit FixedUint256(const Limbs &limbs) : limbs_(limbs) {}
+
+    const Limbs &limbs() const {
+      return limbs_;
+    }
+
+    bool isZero() const {
+      return (limbs_[0] | limbs_[1] | limbs_[2] | limbs_[3]) == 0;
+    }
+
+    /**
+     * @return sum, nullopt on overflow
+     */
+    nonstd::optional<FixedUint256> add(const FixedUint256 &other) const {
+      FixedUint256 result;
+      uint64_t carry = 0;
+      for (auto i = limbs_.size(); i-- > 0;) {
+        auto sum = limbs_[i] + other.limbs_[i];
+        auto next_carry = static_cast<uint64_t>(sum < limbs_[i]);
+        result.limbs_[i] = sum + carry;
+        next_carry |= static_cast<uint64_t>(result.limbs_[i] < sum);
+        carry = next_carry;
+      }
+      if (carry != 0) {
+        return nonstd::nullopt;
+      }
+      return result;
+    }
+
+    /**
+     * @return difference, nullopt if other is greater
+     */
+    nonstd::optional<FixedUint256> subtract(const FixedUint256 &other) const {
+      FixedUint256 result;
+      uint64_t borrow = 0;
+      for (auto i = limbs_.size(); i-- > 0;) {
+        auto difference = limbs_[i] - other.limbs_[i];
+        auto next_borrow = static_cast<uint64_t>(limbs_[i] < other.limbs_[i]);
+        result.limbs_[i] = difference - borrow;
+        next_borrow |= static_cast<uint64_t>(difference < borrow);
+        borrow = next_borrow;
+      }
+      if (borrow != 0) {
+        return nonstd::nullopt;
+      }
+      return result;
+    }
+
+    /**
+     * @return product, nullopt on overflow
+     */
+    nonstd::optional<FixedUint256> multiply(uint64_t factor) const {
+      FixedUint256 result;
+      uint64_t carry = 0;
+      for (auto i = limbs_.size(); i-- > 0;) {
+        auto product = static_cast<Wide>(limbs_[i]) * factor + carry;
+        result.limbs_[i] = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+      }
+      if (carry != 0) {
+        return nonstd::nullopt;
+      }
+      return result;
+    }
+
+    /**
+     * Multiply by power of ten
+     * @return product, nullopt on overflow
+     */
+    nonstd::optional<FixedUint256> scale(size_t exponent) const {
+      nonstd::optional<FixedUint256> result = *this;
+      for (; exponent >= LIMB_DIGITS and result; exponent -= LIMB_DIGITS) {
+        result = result->multiply(LIMB_POWER_OF_TEN);
+      }
+      uint64_t factor = 1;
+      for (; exponent > 0; --exponent) {
+        factor *= 10;
+      }
+      return result ? result->multiply(factor) : result;
+    }
+
+    /**
+     * Divide by divisor in place
+     * @param divisor - non-zero divisor
+     * @return remainder
+     */
+    uint64_t divide(uint64_t divisor) {
+      uint64_t remainder = 0;
+      for (auto &limb : limbs_) {
+        auto dividend = (static_cast<Wide>(remainder) << 64) | limb;
+        limb = static_cast<uint64_t>(dividend / divisor);
+        remainder = static_cast<uint64_t>(dividend % divisor);
+      }
+      return remainder;
+    }
+
+    /**
+     * @return negative, zero or positive value, if this is less, equal or
+     * greater than other
+     */
+    int compare(const FixedUint256 &other) const {
+      for (size_t i = 0; i < limbs_.size(); ++i) {
+        if (limbs_[i] != other.limbs_[i]) {
+          return limbs_[i] < other.limbs_[i] ? -1 : 1;
+        }
+      }
+      return 0;
+    }
+
+    /**
+     * @return decimal digits without leading zeros, "0" for zero
+     */
+    std::string toString() const {
+      if (isZero()) {
+        return "0";
+      }
+      // chunks of LIMB_DIGITS digits, least significant first
+      std::array<uint64_t, 5> chunks{};
+      size_t count = 0;
+      for (auto value = *this; not value.isZero();) {
+        chunks[count++] = value.divide(LIMB_POWER_OF_TEN);
+      }
+      auto result = std::to_string(chunks[count - 1]);
+      for (auto i = count - 1; i-- > 0;) {
+        auto chunk = std::to_string(chunks[i]);
+        result.append(LIMB_DIGITS - chunk.size(), '0');
+        result += chunk;
+      }
+      return result;
+    }
+
+    /**
+     * Parse decimal digits
+     * @param digits - non-empty string of decimal digits
+     * @return value, nullopt on overflow or unexpected character
+     */
+    static nonstd::optional<FixedUint256> fromString(const std::string &digits) {
+      nonstd::optional<FixedUint256> result = FixedUint256();
+      // first chunk is shorter, so that others are exactly LIMB_DIGITS long
+      auto chunk_size = (digits.size() - 1) % LIMB_DIGITS + 1;
+      for (size_t position = 0; position < digits.size() and result;
+           position += chunk_size, chunk_size = LIMB_DIGITS) {
+        uint64_t chunk = 0;
+        uint64_t factor = 1;
+        for (auto i = position; i < position + chunk_size; ++i) {
+          if (digits[i] < '0' or digits[i] > '9') {
+            return nonstd::nullopt;
+          }
+          chunk = chunk * 10 + (digits[i] - '0');
+          factor *= 10;
+        }
+        result = result->multiply(factor);
+        if (result) {
+          result = result->add(FixedUint256(chunk));
+        }
+      }
+      return result;
+    }
+
+   private:
+    __extension__ using Wide = unsigned __int128;
+
+    Limbs limbs_{};
+  };
+}  // namespace iroha
+
+#endif  // IROHA_FIXED_UINT256_HPP
@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_pool/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace iroha {
+
+  ThreadPool::ThreadPool(size_t threads) : stopped_(false) {
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this] { this->work(); });
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    condition_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void ThreadPool::post(std::function<void()> task) {
+    if (workers_.empty()) {
+      task();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push(std::move(task));
+    }
+    condition_.notify_one();
+  }
+
+  void ThreadPool::parallelFor(size_t count,
+                               const std::function<void(size_t)> &function) {
+    struct Progress {
+      std::atomic<size_t> next{0};
+      std::atomic<size_t> done{0};
+      std::mutex mutex;
+      std::condition_variable finished;
+    };
+    auto progress = std::make_shared<Progress>();
+
+    // helpers may start after all indices are taken, then they do nothing
+    // and never touch the function reference
+    auto run = [progress, &function, count] {
+      size_t index;
+      while ((index = progress->next++) < count) {
+        function(index);
+        if (++progress->done == count) {
+          std::lock_guard<std::mutex> lock(progress->mutex);
+          progress->finished.notify_all();
+        }
+      }
+    };
+
+    auto helpers = std::min(workers_.size(), count > 0 ? count - 1 : 0);
+    for (size_t i = 0; i < helpers; ++i) {
+      post(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(progress->mutex);
+    progress->finished.wait(
+        lock, [&progress, count] { return progress->done == count; });
+  }
+
+  size_t ThreadPool::size() const {
+    return workers_.size();
+  }
+
+  void ThreadPool::work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock,
+                        [this] { return stopped_ or not tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+}  // namespace iroha
@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_THREAD_POOL_HPP
+#define IROHA_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace iroha {
+
+  /**
+   * Fixed set of worker threads executing posted tasks in FIFO order.
+   * Used to spread CPU-bound work, such as signature verification,
+   * across cores.
+   */
+  class ThreadPool {
+   public:
+    /**
+     * Start pool
+     * @param threads - number of worker threads, 0 makes every task run on
+     * the calling thread
+     */
+    explicit ThreadPool(size_t threads);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Finish queued tasks and join workers
+     */
+    ~ThreadPool();
+
+    /**
+     * Schedule task for execution on one of the workers
+     * @param task - task to run, must not throw
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * Call function for every index in [0, count) and wait for all calls to
+     * finish. Calling thread takes part in the work, so it is safe to call
+     * from a task running on the same pool.
+     * @param count - number of indices
+     * @param function - function to call, must not throw
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)> &function);
+
+    /**
+     * @return number of worker threads
+     */
+    size_t size() const;
+
+   private:
+    void work();
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopped_;
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_THREAD_POOL_HPP
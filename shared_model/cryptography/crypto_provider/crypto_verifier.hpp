@@ -18,9 +18,12 @@
 #ifndef IROHA_CRYPTO_VERIFIER_HPP
 #define IROHA_CRYPTO_VERIFIER_HPP
 
+#include <vector>
+
 #include "cryptography/blob.hpp"
 #include "cryptography/crypto_provider/crypto_defaults.hpp"
 #include "cryptography/keypair.hpp"
+#include "cryptography/signature_check.hpp"
 #include "cryptography/signed.hpp"
 
 namespace shared_model {
@@ -46,6 +49,16 @@ namespace shared_model {
         return Algorithm::verify(signedData, source, pubKey);
       }
 
+      /**
+       * Verify batch of signatures
+       * @param checks - signatures with signed data and public keys
+       * @return validity of each signature, in the same order
+       */
+      static std::vector<bool> verifyBatch(
+          const std::vector<SignatureCheck> &checks) {
+        return Algorithm::verifyBatch(checks);
+      }
+
       /// close constructor for forbidding instantiation
       CryptoVerifier() = delete;
     };
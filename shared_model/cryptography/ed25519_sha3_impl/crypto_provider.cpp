@@ -34,6 +34,11 @@ namespace shared_model {
       return Verifier::verify(signedData, orig, publicKey);
     }
 
+    std::vector<bool> CryptoProviderEd25519Sha3::verifyBatch(
+        const std::vector<SignatureCheck> &checks) {
+      return Verifier::verifyBatch(checks);
+    }
+
     Seed CryptoProviderEd25519Sha3::generateSeed() {
       return Seed(iroha::create_seed().to_string());
     }
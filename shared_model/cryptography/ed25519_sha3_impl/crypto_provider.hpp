@@ -18,8 +18,11 @@
 #ifndef IROHA_CRYPTOPROVIDER_HPP
 #define IROHA_CRYPTOPROVIDER_HPP
 
+#include <vector>
+
 #include "cryptography/keypair.hpp"
 #include "cryptography/seed.hpp"
+#include "cryptography/signature_check.hpp"
 #include "cryptography/signed.hpp"
 
 namespace shared_model {
@@ -47,6 +50,15 @@ namespace shared_model {
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verifies batch of signatures.
+       * @param checks - signatures with original messages and public keys
+       * @return validity of each signature, in the same order
+       */
+      static std::vector<bool> verifyBatch(
+          const std::vector<SignatureCheck> &checks);
+
       /**
        * Generates new seed
        * @return Seed generated
@@ -66,6 +66,21 @@ namespace iroha {
                        sig);
   }
 
+  /**
+   * Verify batch of signatures
+   */
+  std::vector<bool> verifyBatch(const std::vector<SignatureCheck> &checks) {
+    // the linked ed25519 library has no batched verification equation, so
+    // the batch is checked signature by signature, which also gives the
+    // per-item result of the fallback directly
+    std::vector<bool> result;
+    result.reserve(checks.size());
+    for (const auto &check : checks) {
+      result.push_back(verify(check.msg, check.pub, check.sig));
+    }
+    return result;
+  }
+
   /**
    * Generate seed
    */
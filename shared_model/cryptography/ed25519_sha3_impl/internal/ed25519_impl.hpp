@@ -20,6 +20,7 @@
 
 #include "common/types.hpp"
 #include <string>
+#include <vector>
 
 namespace iroha {
 
@@ -55,6 +56,25 @@ namespace iroha {
 
   bool verify(const std::string &msg, const pubkey_t &pub, const sig_t &sig);
 
+  /**
+   * Signature of ed25519 crypto algorithm with the message and public key
+   * it is verified against
+   */
+  struct SignatureCheck {
+    const std::string &msg;
+    const pubkey_t &pub;
+    const sig_t &sig;
+  };
+
+  /**
+   * Verify batch of signatures of ed25519 crypto algorithm. Validity is
+   * reported per signature, so an invalid one is identified without
+   * rejecting the rest of the batch
+   * @param checks - signatures with their messages and public keys
+   * @return validity of each signature, in the same order
+   */
+  std::vector<bool> verifyBatch(const std::vector<SignatureCheck> &checks);
+
   /**
    * Generate random seed reading from /dev/urandom
    */
@@ -29,5 +29,27 @@ namespace shared_model {
           publicKey.makeOldModel<PublicKey::OldPublicKeyType>(),
           signedData.makeOldModel<Signed::OldSignatureType>());
     }
+
+    std::vector<bool> Verifier::verifyBatch(
+        const std::vector<SignatureCheck> &checks) {
+      // old model values have to outlive the batch they are referenced from
+      std::vector<std::string> hashes;
+      std::vector<iroha::pubkey_t> keys;
+      std::vector<iroha::sig_t> signatures;
+      hashes.reserve(checks.size());
+      keys.reserve(checks.size());
+      signatures.reserve(checks.size());
+      std::vector<iroha::SignatureCheck> batch;
+      for (const auto &check : checks) {
+        hashes.push_back(
+            iroha::sha3_256(crypto::toBinaryString(check.source)).to_string());
+        keys.push_back(
+            check.pubKey.makeOldModel<PublicKey::OldPublicKeyType>());
+        signatures.push_back(
+            check.signedData.makeOldModel<Signed::OldSignatureType>());
+        batch.push_back({hashes.back(), keys.back(), signatures.back()});
+      }
+      return iroha::verifyBatch(batch);
+    }
   }  // namespace crypto
 }  // namespace shared_model
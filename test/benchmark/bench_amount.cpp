@@ -0,0 +1,138 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Compares Amount operations on fixed-width limbs with the same
+/// operations on boost multiprecision, which Amount used before: sum with
+/// overflow check, comparison of amounts with different precisions,
+/// formatting and parsing.
+///
+
+#include <benchmark/benchmark.h>
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <regex>
+
+#include "amount/amount.hpp"
+
+using boost::multiprecision::cpp_dec_float_50;
+using boost::multiprecision::uint256_t;
+
+const uint256_t BALANCE("123456789012345678901234567890");
+const uint8_t PRECISION = 2;
+
+/**
+ * Amount on boost multiprecision
+ */
+struct BoostAmount {
+  uint256_t value;
+  uint8_t precision;
+};
+
+static void BM_Add(benchmark::State &state, bool fixed) {
+  if (fixed) {
+    nonstd::optional<iroha::Amount> balance =
+        iroha::Amount(BALANCE, PRECISION);
+    nonstd::optional<iroha::Amount> quantity = iroha::Amount(100, PRECISION);
+    while (state.KeepRunning()) {
+      benchmark::DoNotOptimize(balance + quantity);
+    }
+    return;
+  }
+  BoostAmount balance{BALANCE, PRECISION}, quantity{100, PRECISION};
+  while (state.KeepRunning()) {
+    nonstd::optional<BoostAmount> sum;
+    if (balance.precision == quantity.precision) {
+      BoostAmount result{balance.value + quantity.value, balance.precision};
+      if (not(result.value < balance.value or result.value < quantity.value)) {
+        sum = result;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK_CAPTURE(BM_Add, Boost, false);
+BENCHMARK_CAPTURE(BM_Add, Fixed, true);
+
+static void BM_CompareScaled(benchmark::State &state, bool fixed) {
+  if (fixed) {
+    iroha::Amount balance(BALANCE, PRECISION), quantity(100, PRECISION + 4);
+    while (state.KeepRunning()) {
+      benchmark::DoNotOptimize(balance < quantity);
+    }
+    return;
+  }
+  BoostAmount balance{BALANCE, PRECISION}, quantity{100, PRECISION + 4};
+  while (state.KeepRunning()) {
+    auto max_precision = std::max(balance.precision, quantity.precision);
+    uint256_t val1 = balance.value
+        * boost::multiprecision::pow(uint256_t(10),
+                                     max_precision - balance.precision);
+    uint256_t val2 = quantity.value
+        * boost::multiprecision::pow(uint256_t(10),
+                                     max_precision - quantity.precision);
+    benchmark::DoNotOptimize(val1 < val2);
+  }
+}
+BENCHMARK_CAPTURE(BM_CompareScaled, Boost, false);
+BENCHMARK_CAPTURE(BM_CompareScaled, Fixed, true);
+
+static void BM_ToString(benchmark::State &state, bool fixed) {
+  if (fixed) {
+    iroha::Amount balance(BALANCE, PRECISION);
+    while (state.KeepRunning()) {
+      benchmark::DoNotOptimize(balance.to_string());
+    }
+    return;
+  }
+  BoostAmount balance{BALANCE, PRECISION};
+  while (state.KeepRunning()) {
+    cpp_dec_float_50 float50(balance.value);
+    float50 /= pow(cpp_dec_float_50(10), balance.precision);
+    benchmark::DoNotOptimize(
+        float50.str(balance.precision, std::ios_base::fixed));
+  }
+}
+BENCHMARK_CAPTURE(BM_ToString, Boost, false);
+BENCHMARK_CAPTURE(BM_ToString, Fixed, true);
+
+static void BM_FromString(benchmark::State &state, bool fixed) {
+  const std::string balance = "1234567890123456789012345678.90";
+  if (fixed) {
+    while (state.KeepRunning()) {
+      benchmark::DoNotOptimize(iroha::Amount::createFromString(balance));
+    }
+    return;
+  }
+  const std::regex number("([0-9]*\\.[0-9]+|[0-9]+)");
+  while (state.KeepRunning()) {
+    nonstd::optional<BoostAmount> amount;
+    if (std::regex_match(balance, number)) {
+      auto digits = balance;
+      auto dot_place = digits.find('.');
+      digits.erase(dot_place, 1);
+      amount = BoostAmount{
+          uint256_t(digits.substr(digits.find_first_not_of('0'))),
+          static_cast<uint8_t>(balance.size() - dot_place - 1)};
+    }
+    benchmark::DoNotOptimize(amount);
+  }
+}
+BENCHMARK_CAPTURE(BM_FromString, Boost, false);
+BENCHMARK_CAPTURE(BM_FromString, Fixed, true);
+
+BENCHMARK_MAIN();
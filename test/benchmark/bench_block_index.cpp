@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Compares lookups in block index backends: Redis and embedded.
+/// Redis is taken from IROHA_REDIS_HOST and IROHA_REDIS_PORT environment
+/// variables, localhost:6379 by default. The database is flushed.
+///
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <cpp_redis/cpp_redis>
+
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/embedded_block_index.hpp"
+#include "ametsuchi/impl/embedded_block_query.hpp"
+#include "ametsuchi/impl/redis_block_index.hpp"
+#include "ametsuchi/impl/redis_block_query.hpp"
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+
+const uint32_t BLOCKS = 100;
+const uint32_t TXS_PER_BLOCK = 100;
+const std::string BLOCK_STORE_PATH = "/tmp/bench_block_index";
+const std::string ACCOUNT = "user1@test";
+
+/**
+ * Ledger shared by all benchmarks, indexed in both backends
+ */
+class Ledger {
+ public:
+  Ledger() {
+    boost::filesystem::remove_all(BLOCK_STORE_PATH);
+    block_store = SegmentedFile::create(BLOCK_STORE_PATH);
+    embedded_index = EmbeddedIndex::create(BLOCK_STORE_PATH + "/"
+                                           + EmbeddedIndex::JOURNAL_DIR);
+
+    auto host = std::getenv("IROHA_REDIS_HOST");
+    auto port = std::getenv("IROHA_REDIS_PORT");
+    client.connect(host ? host : "localhost",
+                   port ? std::stoull(port) : 6379);
+    client.flushall();
+    client.sync_commit();
+
+    RedisBlockIndex redis_index(client);
+    EmbeddedBlockIndex embedded_block_index(*embedded_index);
+    BlockSerializer serializer;
+    for (uint32_t height = 1; height <= BLOCKS; ++height) {
+      Block block;
+      block.height = height;
+      for (uint32_t i = 0; i < TXS_PER_BLOCK; ++i) {
+        Transaction tx;
+        tx.creator_account_id = ACCOUNT;
+        tx.created_ts = height * TXS_PER_BLOCK + i;
+        tx_hashes.push_back(iroha::hash(tx).to_string());
+        block.transactions.push_back(tx);
+      }
+      block_store->add(height, serializer.serialize(block));
+      redis_index.index(block);
+      embedded_block_index.index(block);
+    }
+    client.sync_commit();
+    embedded_block_index.commit();
+
+    // caches are disabled to measure index and block store only
+    redis_query = std::make_shared<RedisBlockQuery>(
+        client, *block_store, std::make_shared<BlockCache>(0));
+    embedded_query = std::make_shared<EmbeddedBlockQuery>(
+        *embedded_index, *block_store, std::make_shared<BlockCache>(0));
+  }
+
+  static Ledger &instance() {
+    static Ledger ledger;
+    return ledger;
+  }
+
+  cpp_redis::client client;
+  std::unique_ptr<KeyValueStorage> block_store;
+  std::unique_ptr<EmbeddedIndex> embedded_index;
+  std::shared_ptr<BlockQuery> redis_query;
+  std::shared_ptr<BlockQuery> embedded_query;
+  std::vector<std::string> tx_hashes;
+};
+
+/// Lookup of transactions by hash
+static void BM_TxByHash(benchmark::State &state, bool embedded) {
+  auto &ledger = Ledger::instance();
+  auto &query = embedded ? ledger.embedded_query : ledger.redis_query;
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    auto tx =
+        query->getTxByHashSync(ledger.tx_hashes[i++ % ledger.tx_hashes.size()]);
+    benchmark::DoNotOptimize(tx);
+  }
+}
+BENCHMARK_CAPTURE(BM_TxByHash, Redis, false);
+BENCHMARK_CAPTURE(BM_TxByHash, Embedded, true);
+
+/// Lookup of all transactions of an account
+static void BM_AccountTransactions(benchmark::State &state, bool embedded) {
+  auto &ledger = Ledger::instance();
+  auto &query = embedded ? ledger.embedded_query : ledger.redis_query;
+  while (state.KeepRunning()) {
+    size_t count = 0;
+    query->getAccountTransactions(ACCOUNT).as_blocking().subscribe(
+        [&count](const auto &) { ++count; });
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK_CAPTURE(BM_AccountTransactions, Redis, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AccountTransactions, Embedded, true)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
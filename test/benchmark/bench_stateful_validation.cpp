@@ -0,0 +1,171 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Compares stateful validation of a proposal in order with validation of
+/// independent groups of transactions on a thread pool. Workloads are
+/// transfers between disjoint pairs of accounts, and transfers all paying
+/// one account, which make a single group. State is kept in embedded world
+/// state view, so the numbers show CPU cost only; with PostgreSQL every
+/// group additionally overlaps its queries with other groups.
+///
+
+#include <benchmark/benchmark.h>
+
+#include "ametsuchi/impl/embedded_wsv/embedded_temporary_wsv.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_command.hpp"
+#include "ametsuchi/temporary_factory.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "model/permissions.hpp"
+#include "validation/impl/stateful_validator_impl.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+
+const size_t ACCOUNTS = 2000;
+const size_t PROPOSAL_SIZE = 1000;
+const std::string ASSET = "coin#test";
+
+std::string accountId(size_t i) {
+  return "user" + std::to_string(i) + "@test";
+}
+
+pubkey_t pubkey(size_t i) {
+  pubkey_t key{};
+  key[0] = i & 0xff;
+  key[1] = i >> 8;
+  return key;
+}
+
+/**
+ * Temporary world state views over one embedded snapshot
+ */
+class EmbeddedTemporaryFactory : public TemporaryFactory {
+ public:
+  EmbeddedTemporaryFactory() {
+    auto state = std::make_shared<EmbeddedWsvState>();
+    EmbeddedWsvCommand command(*state);
+    command.insertRole("user");
+    command.insertRolePermissions("user", {can_transfer, can_receive});
+    Domain domain;
+    domain.domain_id = "test";
+    domain.default_role = "user";
+    command.insertDomain(domain);
+    Asset asset;
+    asset.asset_id = ASSET;
+    asset.domain_id = "test";
+    asset.precision = 2;
+    command.insertAsset(asset);
+    for (size_t i = 0; i < ACCOUNTS; ++i) {
+      Account account;
+      account.account_id = accountId(i);
+      account.domain_id = "test";
+      account.quorum = 1;
+      account.json_data = "{}";
+      command.insertAccount(account);
+      command.insertSignatory(pubkey(i));
+      command.insertAccountSignatory(account.account_id, pubkey(i));
+      command.insertAccountRole(account.account_id, "user");
+      AccountAsset balance;
+      balance.account_id = account.account_id;
+      balance.asset_id = ASSET;
+      balance.balance = Amount(1000000ul, 2);
+      command.upsertAccountAsset(balance);
+    }
+    state_ = state;
+    command_executors_ = CommandExecutorFactory::create().value();
+  }
+
+  std::unique_ptr<TemporaryWsv> createTemporaryWsv() override {
+    return std::make_unique<EmbeddedTemporaryWsv>(state_, command_executors_);
+  }
+
+ private:
+  std::shared_ptr<const EmbeddedWsvState> state_;
+  std::shared_ptr<CommandExecutorFactory> command_executors_;
+};
+
+/**
+ * @param contended - all transfers pay the same account
+ */
+Proposal makeProposal(bool contended) {
+  std::vector<Transaction> txs;
+  for (size_t i = 0; i < PROPOSAL_SIZE; ++i) {
+    auto src = 2 * i + 1;
+    auto dest = contended ? 0 : 2 * i + 2;
+    auto command = std::make_shared<TransferAsset>();
+    command->src_account_id = accountId(src % ACCOUNTS);
+    command->dest_account_id = accountId(dest % ACCOUNTS);
+    command->asset_id = ASSET;
+    command->amount = Amount(100ul, 2);
+
+    Transaction tx;
+    tx.creator_account_id = command->src_account_id;
+    tx.created_ts = i;
+    tx.signatures.emplace_back(iroha::sig_t{}, pubkey(src % ACCOUNTS));
+    tx.commands.push_back(command);
+    txs.push_back(tx);
+  }
+  Proposal proposal(txs);
+  proposal.height = 2;
+  return proposal;
+}
+
+/**
+ * @param state.range(0) - worker threads of pool, zero validates in order
+ */
+static void BM_Validate(benchmark::State &state, bool contended) {
+  auto factory = std::make_shared<EmbeddedTemporaryFactory>();
+  auto workers = static_cast<size_t>(state.range(0));
+  auto validator = workers == 0
+      ? std::make_unique<validation::StatefulValidatorImpl>()
+      : std::make_unique<validation::StatefulValidatorImpl>(
+            factory, std::make_shared<ThreadPool>(workers));
+  auto proposal = makeProposal(contended);
+  spdlog::set_level(spdlog::level::off);
+
+  while (state.KeepRunning()) {
+    auto wsv = factory->createTemporaryWsv();
+    benchmark::DoNotOptimize(validator->validate(proposal, *wsv));
+  }
+  state.SetItemsProcessed(state.iterations() * PROPOSAL_SIZE);
+}
+BENCHMARK_CAPTURE(BM_Validate, Disjoint, false)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(3)
+    ->Arg(7)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Validate, Contended, true)
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(7)
+    ->UseRealTime();
+
+static void BM_ConflictGroups(benchmark::State &state, bool contended) {
+  auto proposal = makeProposal(contended);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        validation::conflictGroups(proposal.transactions));
+  }
+  state.SetItemsProcessed(state.iterations() * PROPOSAL_SIZE);
+}
+BENCHMARK_CAPTURE(BM_ConflictGroups, Disjoint, false);
+BENCHMARK_CAPTURE(BM_ConflictGroups, Contended, true);
+
+BENCHMARK_MAIN();
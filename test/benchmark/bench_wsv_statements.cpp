@@ -0,0 +1,216 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+///
+/// Compares WSV statements built by string concatenation with prepared
+/// statements, which are used by PostgresWsvQuery and PostgresWsvCommand,
+/// and balance writes of a block one by one with PostgresWsvBatch.
+/// PostgreSQL is taken from IROHA_POSTGRES_HOST, IROHA_POSTGRES_PORT,
+/// IROHA_POSTGRES_USER and IROHA_POSTGRES_PASSWORD environment variables.
+/// All changes are made in a transaction, which is rolled back.
+///
+
+#include <benchmark/benchmark.h>
+#include <pqxx/pqxx>
+
+#include "ametsuchi/impl/postgres_amount.hpp"
+#include "ametsuchi/impl/postgres_wsv_command.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+
+const std::string DOMAIN_ID = "bench";
+const std::string ACCOUNT_ID = "user@bench";
+const std::string ASSET_ID = "coin#bench";
+/// number of assets of the account, which bounds balances written per block
+const size_t BLOCK_ASSETS = 1024;
+
+const std::string SCHEMA = R"(
+CREATE TABLE IF NOT EXISTS role (
+    role_id character varying(45),
+    PRIMARY KEY (role_id)
+);
+CREATE TABLE IF NOT EXISTS domain (
+    domain_id character varying(164),
+    default_role character varying(45) NOT NULL REFERENCES role(role_id),
+    PRIMARY KEY (domain_id)
+);
+CREATE TABLE IF NOT EXISTS account (
+    account_id character varying(197),
+    domain_id character varying(164) NOT NULL REFERENCES domain,
+    quorum int NOT NULL,
+    transaction_count int NOT NULL DEFAULT 0,
+    data JSONB,
+    PRIMARY KEY (account_id)
+);
+CREATE TABLE IF NOT EXISTS asset (
+    asset_id character varying(197),
+    domain_id character varying(164) NOT NULL REFERENCES domain,
+    precision int NOT NULL,
+    data json,
+    PRIMARY KEY (asset_id)
+);
+CREATE TABLE IF NOT EXISTS account_has_asset (
+    account_id character varying(197) NOT NULL REFERENCES account,
+    asset_id character varying(197) NOT NULL REFERENCES asset,
+    amount_0 bigint NOT NULL,
+    amount_1 bigint NOT NULL,
+    amount_2 bigint NOT NULL,
+    amount_3 bigint NOT NULL,
+    amount_precision smallint NOT NULL,
+    PRIMARY KEY (account_id, asset_id)
+);
+)";
+
+/**
+ * Connection with world state, which has one account with one asset
+ */
+class Wsv {
+ public:
+  Wsv() {
+    auto host = std::getenv("IROHA_POSTGRES_HOST");
+    auto port = std::getenv("IROHA_POSTGRES_PORT");
+    auto user = std::getenv("IROHA_POSTGRES_USER");
+    auto password = std::getenv("IROHA_POSTGRES_PASSWORD");
+    connection = std::make_unique<pqxx::lazyconnection>(
+        std::string("host=") + (host ? host : "localhost") + " port="
+        + (port ? port : "5432") + " user=" + (user ? user : "postgres")
+        + " password=" + (password ? password : "mysecretpassword"));
+    transaction = std::make_unique<pqxx::nontransaction>(*connection);
+    transaction->exec("BEGIN;");
+    transaction->exec(SCHEMA);
+
+    query = std::make_unique<PostgresWsvQuery>(*transaction);
+    command = std::make_unique<PostgresWsvCommand>(*transaction);
+
+    command->insertRole("user");
+    command->insertDomain(Domain{DOMAIN_ID, "user"});
+    Account account;
+    account.account_id = ACCOUNT_ID;
+    account.domain_id = DOMAIN_ID;
+    account.quorum = 1;
+    account.json_data = "{}";
+    command->insertAccount(account);
+    Asset asset;
+    asset.asset_id = ASSET_ID;
+    asset.domain_id = DOMAIN_ID;
+    asset.precision = 2;
+    command->insertAsset(asset);
+    account_asset.account_id = ACCOUNT_ID;
+    account_asset.asset_id = ASSET_ID;
+    account_asset.balance = *iroha::Amount::createFromString("100.00");
+    command->upsertAccountAsset(account_asset);
+
+    for (size_t i = 0; i < BLOCK_ASSETS; ++i) {
+      asset.asset_id = "coin" + std::to_string(i) + "#" + DOMAIN_ID;
+      command->insertAsset(asset);
+      account_asset.asset_id = asset.asset_id;
+      block_assets.push_back(account_asset);
+    }
+    account_asset.asset_id = ASSET_ID;
+  }
+
+  ~Wsv() {
+    transaction->exec("ROLLBACK;");
+  }
+
+  static Wsv &instance() {
+    static Wsv wsv;
+    return wsv;
+  }
+
+  std::unique_ptr<pqxx::lazyconnection> connection;
+  std::unique_ptr<pqxx::nontransaction> transaction;
+  std::unique_ptr<PostgresWsvQuery> query;
+  std::unique_ptr<PostgresWsvCommand> command;
+  AccountAsset account_asset;
+  std::vector<AccountAsset> block_assets;
+};
+
+/// Account lookup, as done by the most of stateful validation checks
+static void BM_GetAccount(benchmark::State &state, bool prepared) {
+  auto &wsv = Wsv::instance();
+  auto &transaction = *wsv.transaction;
+  while (state.KeepRunning()) {
+    if (prepared) {
+      auto account = wsv.query->getAccount(ACCOUNT_ID);
+      benchmark::DoNotOptimize(account);
+    } else {
+      auto result =
+          transaction.exec("SELECT * FROM account WHERE account_id = "
+                           + transaction.quote(ACCOUNT_ID) + ";");
+      benchmark::DoNotOptimize(result);
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_GetAccount, AdHoc, false);
+BENCHMARK_CAPTURE(BM_GetAccount, Prepared, true);
+
+/// Balance update, as done by transfer and add asset quantity commands
+static void BM_UpsertAccountAsset(benchmark::State &state, bool prepared) {
+  auto &wsv = Wsv::instance();
+  auto &transaction = *wsv.transaction;
+  const auto &asset = wsv.account_asset;
+  while (state.KeepRunning()) {
+    if (prepared) {
+      wsv.command->upsertAccountAsset(asset);
+    } else {
+      auto balance = toAmountColumns(asset.balance);
+      transaction.exec(
+          "INSERT INTO account_has_asset(account_id, asset_id, "
+          + AMOUNT_COLUMNS + ") VALUES ("
+          + transaction.quote(asset.account_id) + ", "
+          + transaction.quote(asset.asset_id) + ", "
+          + std::to_string(balance.limbs[0]) + ", "
+          + std::to_string(balance.limbs[1]) + ", "
+          + std::to_string(balance.limbs[2]) + ", "
+          + std::to_string(balance.limbs[3]) + ", "
+          + std::to_string(balance.precision)
+          + ") ON CONFLICT (account_id, asset_id) DO UPDATE SET ("
+          + AMOUNT_COLUMNS
+          + ") = (EXCLUDED.amount_0, EXCLUDED.amount_1, EXCLUDED.amount_2, "
+            "EXCLUDED.amount_3, EXCLUDED.amount_precision);");
+    }
+  }
+}
+BENCHMARK_CAPTURE(BM_UpsertAccountAsset, AdHoc, false);
+BENCHMARK_CAPTURE(BM_UpsertAccountAsset, Prepared, true);
+
+/// Balance updates of a block with given number of transfers, written by a
+/// statement each or by a single statement on flush
+static void BM_WriteBlockBalances(benchmark::State &state, bool batched) {
+  auto &wsv = Wsv::instance();
+  auto batch = std::make_shared<PostgresWsvBatch>(*wsv.transaction);
+  PostgresWsvCommand command(*wsv.transaction, batched ? batch : nullptr);
+  const auto count = static_cast<size_t>(state.range(0));
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < count; ++i) {
+      command.upsertAccountAsset(wsv.block_assets[i]);
+    }
+    batch->flush();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_CAPTURE(BM_WriteBlockBalances, Single, false)
+    ->RangeMultiplier(4)
+    ->Range(16, BLOCK_ASSETS);
+BENCHMARK_CAPTURE(BM_WriteBlockBalances, Batched, true)
+    ->RangeMultiplier(4)
+    ->Range(16, BLOCK_ASSETS);
+
+BENCHMARK_MAIN();
@@ -134,6 +134,17 @@ namespace iroha {
                    rxcpp::observable<model::Block>(uint32_t, uint32_t));
       MOCK_METHOD1(getBlocksFrom, rxcpp::observable<model::Block>(uint32_t));
       MOCK_METHOD1(getTopBlocks, rxcpp::observable<model::Block>(uint32_t));
+      MOCK_METHOD0(getTopBlock, std::shared_ptr<const model::Block>());
+      MOCK_METHOD1(getBlockByHash,
+                   boost::optional<model::Block>(const model::Block::HashType &));
+    };
+
+    class MockTemporaryWsv : public TemporaryWsv {
+     public:
+      MOCK_METHOD2(
+          apply,
+          bool(const model::Transaction &,
+               std::function<bool(const model::Transaction &, WsvQuery &)>));
     };
 
     class MockTemporaryFactory : public TemporaryFactory {
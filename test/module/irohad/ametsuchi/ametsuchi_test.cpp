@@ -263,6 +263,105 @@ TEST_F(AmetsuchiTest, SampleTest) {
       blocks, "non_existing_user", "non_existing_asset", 0, 0);
 }
 
+/**
+ * @given storage with embedded block index
+ * @when block is committed and storage is reopened
+ * @then transactions are found by account and hash before and after
+ * reopening
+ */
+TEST_F(AmetsuchiTest, EmbeddedBlockIndex) {
+  StorageOptions options;
+  options.block_index = BlockIndexType::EMBEDDED;
+  auto storage = StorageImpl::create(
+      block_store_path, redishost_, redisport_, pgopt_, options);
+  ASSERT_TRUE(storage);
+
+  Transaction txn;
+  txn.creator_account_id = "admin1";
+  txn.commands.push_back(std::make_shared<CreateRole>(
+      "user", std::set<std::string>{can_get_my_account}));
+  txn.commands.push_back(std::make_shared<CreateDomain>("ru", "user"));
+  txn.commands.push_back(cmd_gen.generateCreateAccount("user1", "ru", {}));
+  auto tx_hash = iroha::hash(txn);
+
+  Block block;
+  block.transactions.push_back(txn);
+  block.height = 1;
+  block.prev_hash.fill(0);
+  block.hash = iroha::hash(block);
+  block.txs_number = block.transactions.size();
+
+  apply(storage, block);
+
+  auto validate = [&](auto blocks) {
+    validateAccountTransactions(blocks, "admin1", 1, 3);
+    validateAccountTransactions(blocks, "non_existing_user", 0, 0);
+    auto tx = blocks->getTxByHashSync(tx_hash.to_string());
+    ASSERT_TRUE(tx);
+    ASSERT_EQ(tx_hash, iroha::hash(*tx));
+  };
+  validate(storage->getBlockQuery());
+
+  storage.reset();
+  storage = StorageImpl::create(
+      block_store_path, redishost_, redisport_, pgopt_, options);
+  ASSERT_TRUE(storage);
+  validate(storage->getBlockQuery());
+
+  storage->dropStorage();
+}
+
+/**
+ * @given storage with embedded world state view and block index
+ * @when block is committed and storage is reopened
+ * @then world state is read from committed snapshot, and restored from
+ * block store after reopening
+ */
+TEST_F(AmetsuchiTest, EmbeddedWsv) {
+  StorageOptions options;
+  options.block_index = BlockIndexType::EMBEDDED;
+  options.wsv = WsvType::EMBEDDED;
+  auto storage = StorageImpl::create(
+      block_store_path, redishost_, redisport_, pgopt_, options);
+  ASSERT_TRUE(storage);
+
+  Transaction txn;
+  txn.creator_account_id = "admin1";
+  txn.commands.push_back(std::make_shared<CreateRole>(
+      "user", std::set<std::string>{can_get_my_account}));
+  txn.commands.push_back(std::make_shared<CreateDomain>("ru", "user"));
+  txn.commands.push_back(cmd_gen.generateCreateAccount("user1", "ru", {}));
+
+  Block block;
+  block.transactions.push_back(txn);
+  block.height = 1;
+  block.prev_hash.fill(0);
+  block.hash = iroha::hash(block);
+  block.txs_number = block.transactions.size();
+
+  auto wsv = storage->getWsvQuery();
+  ASSERT_FALSE(wsv->getAccount("user1@ru"));
+  apply(storage, block);
+
+  auto validate = [](auto wsv) {
+    auto account = wsv->getAccount("user1@ru");
+    ASSERT_TRUE(account);
+    ASSERT_EQ("ru", account->domain_id);
+    ASSERT_EQ(std::vector<std::string>{"user"},
+              *wsv->getAccountRoles("user1@ru"));
+  };
+  validate(wsv);
+
+  storage.reset();
+  storage = StorageImpl::create(
+      block_store_path, redishost_, redisport_, pgopt_, options);
+  ASSERT_TRUE(storage);
+  validate(storage->getWsvQuery());
+
+  storage->dropStorage();
+  ASSERT_FALSE(storage->getWsvQuery()->getAccount("user1@ru"));
+}
+
 TEST_F(AmetsuchiTest, PeerTest) {
   auto storage =
       StorageImpl::create(block_store_path, redishost_, redisport_, pgopt_);
@@ -688,6 +787,36 @@ TEST_F(AmetsuchiTest, TestingStorageWhenInsertBlock) {
   storage->dropStorage();
 }
 
+/**
+ * @given Redis index of a block without its hash entry, as written before
+ * blocks were looked up by hash
+ * @when storage is reopened
+ * @then the entry is restored and the block is found by hash
+ */
+TEST_F(AmetsuchiTest, RedisBlockHashesAreBackfilled) {
+  auto storage =
+      StorageImpl::create(block_store_path, redishost_, redisport_, pgopt_);
+  ASSERT_TRUE(storage);
+  auto block = getBlock();
+  ASSERT_TRUE(storage->insertBlock(block));
+
+  cpp_redis::client client;
+  client.connect(redishost_, redisport_);
+  client.del({"block:" + block.hash.to_string(), "block:backfilled"});
+  client.sync_commit();
+  ASSERT_FALSE(storage->getBlockQuery()->getBlockByHash(block.hash));
+
+  storage.reset();
+  storage =
+      StorageImpl::create(block_store_path, redishost_, redisport_, pgopt_);
+  ASSERT_TRUE(storage);
+  auto found = storage->getBlockQuery()->getBlockByHash(block.hash);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(1, found->height);
+
+  storage->dropStorage();
+}
+
 TEST_F(AmetsuchiTest, TestingStorageWhenDropAll) {
   auto logger = logger::testLog("TestStorage");
   logger->info(
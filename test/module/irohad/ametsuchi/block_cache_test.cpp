@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+
+std::shared_ptr<const Block> makeBlock(Block::BlockHeightType height) {
+  Block block;
+  block.height = height;
+  return std::make_shared<const Block>(block);
+}
+
+/**
+ * @given empty cache
+ * @when block is put and requested along with a missing one
+ * @then cached block is returned and hits and misses are counted
+ */
+TEST(BlockCacheTest, PutAndGet) {
+  BlockCache cache(100);
+  cache.put(makeBlock(1), 10);
+
+  auto block = cache.get(1);
+  ASSERT_TRUE(block);
+  ASSERT_EQ(block->height, 1);
+  ASSERT_FALSE(cache.get(2));
+
+  ASSERT_EQ(cache.hits(), 1);
+  ASSERT_EQ(cache.misses(), 1);
+  ASSERT_EQ(cache.used(), 10);
+}
+
+/**
+ * @given cache filled up to its budget
+ * @when one block is accessed and another one is put
+ * @then least recently used block is evicted
+ */
+TEST(BlockCacheTest, LeastRecentlyUsedIsEvicted) {
+  BlockCache cache(30);
+  for (auto height = 1u; height <= 3u; ++height) {
+    cache.put(makeBlock(height), 10);
+  }
+
+  ASSERT_TRUE(cache.get(1));
+  cache.put(makeBlock(4), 10);
+
+  ASSERT_TRUE(cache.get(1));
+  ASSERT_FALSE(cache.get(2));
+  ASSERT_TRUE(cache.get(3));
+  ASSERT_TRUE(cache.get(4));
+  ASSERT_EQ(cache.used(), 30);
+}
+
+/**
+ * @given cache with a block
+ * @when block with the same height is put again, a block larger than
+ * budget is put, and then the cache is cleared
+ * @then block is replaced, oversized block is ignored, and cache is empty
+ * after clear
+ */
+TEST(BlockCacheTest, ReplaceOversizedAndClear) {
+  BlockCache cache(30);
+  cache.put(makeBlock(1), 10);
+  cache.put(makeBlock(1), 20);
+  ASSERT_EQ(cache.used(), 20);
+
+  cache.put(makeBlock(2), 40);
+  ASSERT_FALSE(cache.get(2));
+  ASSERT_TRUE(cache.get(1));
+
+  cache.clear();
+  ASSERT_EQ(cache.used(), 0);
+  ASSERT_FALSE(cache.get(1));
+}
@@ -16,6 +16,7 @@
  */
 
 #include <boost/optional.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
 #include "ametsuchi/impl/redis_block_index.hpp"
 #include "ametsuchi/impl/redis_block_query.hpp"
 #include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
@@ -51,6 +52,7 @@ class BlockQueryTest : public AmetsuchiTest {
     block1.transactions.push_back(txn1_1);
     block1.transactions.push_back(txn1_2);
     auto block1hash = iroha::hash(block1);
+    block1.hash = block1hash;
 
     // First tx in block 1
     Transaction txn2_1;
@@ -68,6 +70,8 @@ class BlockQueryTest : public AmetsuchiTest {
     block2.prev_hash = block1hash;
     block2.transactions.push_back(txn2_1);
     block2.transactions.push_back(txn2_2);
+    block2.hash = iroha::hash(block2);
+    block_hashes = {block1.hash, block2.hash};
 
     for (const auto &b : {block1, block2}) {
       file->add(b.height, iroha::stringToBytes(converters::jsonToString(
@@ -77,6 +81,7 @@ class BlockQueryTest : public AmetsuchiTest {
   }
 
   std::vector<iroha::hash256_t> tx_hashes;
+  std::vector<Block::HashType> block_hashes;
   std::shared_ptr<BlockQuery> blocks;
   std::shared_ptr<BlockIndex> index;
   std::unique_ptr<FlatFile> file;
@@ -212,3 +217,48 @@ TEST_F(BlockQueryTest, GetTransactionsWithInvalidTxAndValidTx) {
   });
   ASSERT_TRUE(wrapper.validate());
 }
+
+/**
+ * @given block store with 2 blocks
+ * AND index entry of older format, which stores only block height for tx hash
+ * @when query to get transaction with this hash is invoked
+ * @then transaction is found by scanning the block
+ */
+TEST_F(BlockQueryTest, GetTransactionWithLegacyIndexEntry) {
+  client.set(tx_hashes[3].to_string(), "2");
+  client.sync_commit();
+
+  auto tx = blocks->getTxByHashSync(tx_hashes[3].to_string());
+  ASSERT_TRUE(tx);
+  ASSERT_EQ(tx_hashes[3], iroha::hash(*tx));
+}
+
+/**
+ * @given block store with 2 blocks
+ * @when blocks are requested by their hashes and by unknown hash
+ * @then blocks with given hashes are returned, unknown hash is not found
+ */
+TEST_F(BlockQueryTest, GetBlockByHash) {
+  for (size_t i = 0; i < block_hashes.size(); ++i) {
+    auto block = blocks->getBlockByHash(block_hashes[i]);
+    ASSERT_TRUE(block);
+    ASSERT_EQ(block->height, i + 1);
+    ASSERT_EQ(block->hash, block_hashes[i]);
+  }
+
+  Block::HashType unknown_hash;
+  unknown_hash.fill(1);
+  ASSERT_FALSE(blocks->getBlockByHash(unknown_hash));
+}
+
+/**
+ * @given block store with 2 blocks
+ * @when top block is requested
+ * @then the last block is returned
+ */
+TEST_F(BlockQueryTest, GetTopBlock) {
+  auto block = blocks->getTopBlock();
+  ASSERT_TRUE(block);
+  ASSERT_EQ(block->height, 2);
+  ASSERT_EQ(block->hash, block_hashes[1]);
+}
@@ -16,6 +16,7 @@
  */
 
 #include <boost/optional.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
 #include "ametsuchi/impl/redis_block_index.hpp"
 #include "ametsuchi/impl/redis_block_query.hpp"
 #include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_serializer.hpp"
+#include <gtest/gtest.h>
+#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/converters/json_common.hpp"
+
+using namespace iroha::ametsuchi;
+
+class BlockSerializerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    iroha::model::Transaction tx;
+    tx.creator_account_id = "admin@test";
+    tx.created_ts = 2;
+    tx.tx_counter = 1;
+    tx.commands = {
+        std::make_shared<iroha::model::CreateDomain>("test", "user")};
+
+    iroha::model::Signature signature;
+    std::fill(signature.pubkey.begin(), signature.pubkey.end(), 0x22);
+    std::fill(signature.signature.begin(), signature.signature.end(), 0x10);
+
+    block.created_ts = 1;
+    block.height = 3;
+    std::fill(block.prev_hash.begin(), block.prev_hash.end(), 0x3);
+    block.sigs = {signature};
+    block.txs_number = 1;
+    block.transactions = {tx};
+    block.hash = iroha::hash(block);
+  }
+
+  iroha::model::Block block;
+  BlockSerializer serializer;
+};
+
+/**
+ * @given block
+ * @when block is serialized and deserialized back
+ * @then record is tagged as binary and the same block is restored
+ */
+TEST_F(BlockSerializerTest, BinaryRoundTrip) {
+  auto bytes = serializer.serialize(block);
+  ASSERT_EQ(bytes.front(), BlockSerializer::PROTOBUF_V1);
+
+  auto restored = serializer.deserialize(bytes);
+  ASSERT_TRUE(restored);
+  ASSERT_EQ(*restored, block);
+}
+
+/**
+ * @given binary record which stored hash differs from the payload hash
+ * @when record is deserialized
+ * @then the stored hash is taken as is, without hashing the payload
+ */
+TEST_F(BlockSerializerTest, StoredHashIsNotRecomputed) {
+  auto stored = block;
+  std::fill(stored.hash.begin(), stored.hash.end(), 0x7);
+  auto bytes = serializer.serialize(stored);
+
+  auto restored = serializer.deserialize(bytes);
+  ASSERT_TRUE(restored);
+  ASSERT_EQ(stored.hash, restored->hash);
+  ASSERT_EQ(stored.hash, iroha::hash(*restored));
+}
+
+/**
+ * @given block stored in legacy JSON format
+ * @when record is deserialized
+ * @then the same block is restored
+ */
+TEST_F(BlockSerializerTest, LegacyJsonIsAccepted) {
+  auto bytes = iroha::stringToBytes(iroha::model::converters::jsonToString(
+      iroha::model::converters::JsonBlockFactory().serialize(block)));
+
+  auto restored = serializer.deserialize(bytes);
+  ASSERT_TRUE(restored);
+  ASSERT_EQ(*restored, block);
+}
+
+/**
+ * @given malformed records: empty, truncated, and with unknown tag
+ * @when records are deserialized
+ * @then nothing is restored
+ */
+TEST_F(BlockSerializerTest, MalformedRecordsAreRejected) {
+  auto bytes = serializer.serialize(block);
+  auto truncated = std::vector<uint8_t>(bytes.begin(), bytes.begin() + 10);
+  auto unknown = bytes;
+  unknown.front() = 0xff;
+
+  ASSERT_FALSE(serializer.deserialize(std::vector<uint8_t>{}));
+  ASSERT_FALSE(serializer.deserialize(truncated));
+  ASSERT_FALSE(serializer.deserialize(unknown));
+}
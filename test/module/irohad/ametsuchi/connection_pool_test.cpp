@@ -0,0 +1,134 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/connection_pool.hpp"
+#include <gtest/gtest.h>
+
+using namespace iroha::ametsuchi;
+
+/**
+ * Fake connection which counts its instances
+ */
+struct Connection {
+  explicit Connection(size_t &opened) : opened(opened) {
+    ++opened;
+  }
+  ~Connection() {
+    --opened;
+  }
+
+  size_t &opened;
+  bool broken = false;
+};
+
+class ConnectionPoolTest : public ::testing::Test {
+ public:
+  std::shared_ptr<ConnectionPool<Connection>> createPool(size_t capacity) {
+    return ConnectionPool<Connection>::create(
+        [this] { return std::make_unique<Connection>(opened); },
+        [](Connection &connection) { return not connection.broken; },
+        [this](Connection &connection) {
+          ++resets;
+          return not connection.broken;
+        },
+        capacity,
+        std::chrono::milliseconds(10));
+  }
+
+  size_t opened = 0;
+  size_t resets = 0;
+};
+
+/**
+ * @given pool with returned connection
+ * @when connection is acquired again
+ * @then the same connection is reused after reset
+ */
+TEST_F(ConnectionPoolTest, ReturnedConnectionIsReused) {
+  auto pool = createPool(2);
+  Connection *first;
+  {
+    auto connection = pool->acquire();
+    ASSERT_TRUE(connection);
+    first = connection.get();
+    ASSERT_EQ(pool->inUse(), 1);
+  }
+  ASSERT_EQ(resets, 1);
+  ASSERT_EQ(pool->idle(), 1);
+
+  auto connection = pool->acquire();
+  ASSERT_EQ(connection.get(), first);
+  ASSERT_EQ(opened, 1);
+}
+
+/**
+ * @given pool with connections broken while in use and while idle
+ * @when connections are returned and acquired
+ * @then broken connections are closed and replaced with new ones
+ */
+TEST_F(ConnectionPoolTest, BrokenConnectionIsReplaced) {
+  auto pool = createPool(2);
+  {
+    auto connection = pool->acquire();
+    connection->broken = true;
+  }
+  ASSERT_EQ(pool->idle(), 0);
+  ASSERT_EQ(opened, 0);
+
+  Connection *idle;
+  {
+    auto connection = pool->acquire();
+    idle = connection.get();
+  }
+  idle->broken = true;
+  auto connection = pool->acquire();
+  ASSERT_TRUE(connection);
+  ASSERT_FALSE(connection->broken);
+  ASSERT_EQ(opened, 1);
+}
+
+/**
+ * @given pool with capacity of one connection, which is in use
+ * @when another connection is acquired
+ * @then nothing is returned after timeout, and connection is available
+ * after the first one is returned
+ */
+TEST_F(ConnectionPoolTest, CapacityIsBounded) {
+  auto pool = createPool(1);
+  auto connection = pool->acquire();
+  ASSERT_TRUE(connection);
+  ASSERT_FALSE(pool->acquire());
+
+  connection.reset();
+  ASSERT_TRUE(pool->acquire());
+}
+
+/**
+ * @given connection acquired from pool
+ * @when pool is destroyed before connection is returned
+ * @then connection is closed on return
+ */
+TEST_F(ConnectionPoolTest, ConnectionOutlivesPool) {
+  auto pool = createPool(1);
+  auto connection = pool->acquire();
+  pool.reset();
+  ASSERT_EQ(opened, 1);
+
+  connection.reset();
+  ASSERT_EQ(opened, 0);
+  ASSERT_EQ(resets, 0);
+}
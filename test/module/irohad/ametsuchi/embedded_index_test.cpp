@@ -0,0 +1,172 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/embedded_index/embedded_index.hpp"
+#include <gtest/gtest.h>
+#include "ametsuchi/impl/embedded_block_index.hpp"
+#include <boost/filesystem.hpp>
+#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
+#include "model/commands/transfer_asset.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+
+class EmbeddedIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // user1 transfers coin to user2, user2 creates transaction without
+    // commands
+    Transaction transfer;
+    transfer.creator_account_id = creator1;
+    transfer.commands.push_back(
+        std::make_shared<TransferAsset>(
+            creator1, creator2, asset, iroha::Amount()));
+    Transaction empty;
+    empty.creator_account_id = creator2;
+
+    block.height = 1;
+    block.hash.fill(1);
+    block.transactions = {transfer, empty};
+    tx_hashes = {iroha::hash(transfer).to_string(),
+                 iroha::hash(empty).to_string()};
+  }
+
+  void TearDown() override {
+    boost::filesystem::remove_all(index_path);
+  }
+
+  /**
+   * Check that the block from SetUp is indexed
+   */
+  void checkIndexed(const EmbeddedIndex &index) {
+    ASSERT_EQ(index.lastHeight(), 1);
+    auto height = index.getBlockHeight(block.hash.to_string());
+    ASSERT_TRUE(height);
+    ASSERT_EQ(*height, 1);
+
+    auto position = index.getTxPosition(tx_hashes[1]);
+    ASSERT_TRUE(position);
+    ASSERT_EQ(position->height, 1);
+    ASSERT_EQ(position->index, 1);
+
+    ASSERT_EQ(index.getBlockIds(creator1), std::vector<uint64_t>{1});
+    ASSERT_EQ(index.getBlockIds(creator2), std::vector<uint64_t>{1});
+    ASSERT_EQ(index.getTxIndexes(creator1, 1), std::vector<size_t>{0});
+    ASSERT_EQ(index.getTxIndexes(creator2, 1), std::vector<size_t>{1});
+    ASSERT_EQ(index.getTxIndexes(creator1, 1, asset), std::vector<size_t>{0});
+    ASSERT_EQ(index.getTxIndexes(creator2, 1, asset), std::vector<size_t>{0});
+  }
+
+  std::string index_path = "/tmp/embedded_index";
+  std::string creator1 = "user1@test";
+  std::string creator2 = "user2@test";
+  std::string asset = "coin#test";
+  Block block;
+  std::vector<std::string> tx_hashes;
+};
+
+/**
+ * @given empty index
+ * @when block with transfer is added
+ * @then transactions are found by hash, creator, and transferred asset
+ */
+TEST_F(EmbeddedIndexTest, IndexAndQuery) {
+  auto index = EmbeddedIndex::create(index_path);
+  ASSERT_TRUE(index);
+  ASSERT_TRUE(index->add(1, EmbeddedIndex::encode(block)));
+
+  checkIndexed(*index);
+  ASSERT_FALSE(index->getTxPosition("unknown"));
+  ASSERT_FALSE(index->getBlockHeight("unknown"));
+  ASSERT_TRUE(index->getTxIndexes(creator1, 2).empty());
+  ASSERT_TRUE(index->getTxIndexes(creator1, 1, "other#test").empty());
+}
+
+/**
+ * @given index with a block
+ * @when index is reopened
+ * @then block is restored from the journal
+ */
+TEST_F(EmbeddedIndexTest, IndexIsRestoredFromJournal) {
+  {
+    auto index = EmbeddedIndex::create(index_path);
+    ASSERT_TRUE(index);
+    ASSERT_TRUE(index->add(1, EmbeddedIndex::encode(block)));
+  }
+
+  auto index = EmbeddedIndex::create(index_path);
+  ASSERT_TRUE(index);
+  checkIndexed(*index);
+}
+
+/**
+ * @given empty index
+ * @when block which does not follow the last indexed one is added
+ * @then block is rejected
+ */
+TEST_F(EmbeddedIndexTest, NonConsecutiveBlockIsRejected) {
+  auto index = EmbeddedIndex::create(index_path);
+  ASSERT_TRUE(index);
+  ASSERT_FALSE(index->add(2, EmbeddedIndex::encode(block)));
+  ASSERT_EQ(index->lastHeight(), 0);
+  ASSERT_FALSE(index->getTxPosition(tx_hashes[0]));
+}
+
+/**
+ * @given block index with pending blocks, one of which does not follow
+ * the previous one
+ * @when pending blocks are committed
+ * @then blocks after the rejected one are not indexed
+ */
+TEST_F(EmbeddedIndexTest, CommitStopsAtRejectedBlock) {
+  auto index = EmbeddedIndex::create(index_path);
+  ASSERT_TRUE(index);
+  EmbeddedBlockIndex block_index(*index);
+  auto skipped = block;
+  skipped.height = 3;
+  skipped.hash.fill(3);
+  auto next = block;
+  next.height = 2;
+  next.hash.fill(2);
+
+  block_index.index(block);
+  block_index.index(skipped);
+  block_index.index(next);
+  block_index.commit();
+
+  ASSERT_EQ(index->lastHeight(), 1);
+  ASSERT_FALSE(index->getBlockHeight(next.hash.to_string()));
+}
+
+/**
+ * @given index with a block
+ * @when index is dropped and reopened
+ * @then index is empty
+ */
+TEST_F(EmbeddedIndexTest, DropAll) {
+  auto index = EmbeddedIndex::create(index_path);
+  ASSERT_TRUE(index);
+  ASSERT_TRUE(index->add(1, EmbeddedIndex::encode(block)));
+
+  index->dropAll();
+  ASSERT_EQ(index->lastHeight(), 0);
+  ASSERT_FALSE(index->getTxPosition(tx_hashes[0]));
+
+  index = EmbeddedIndex::create(index_path);
+  ASSERT_TRUE(index);
+  ASSERT_TRUE(index->getBlockIds(creator1).empty());
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_command.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_query.hpp"
+#include "ametsuchi/impl/wsv_overlay.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+
+class EmbeddedWsvTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    account.account_id = "admin@test";
+    account.domain_id = "test";
+    account.quorum = 1;
+    account.json_data = "{}";
+
+    auto state = std::make_shared<EmbeddedWsvState>();
+    EmbeddedWsvCommand command(*state);
+    ASSERT_TRUE(command.insertRole("user"));
+    ASSERT_TRUE(command.insertDomain(makeDomain("test", "user")));
+    ASSERT_TRUE(command.insertAccount(account));
+    ASSERT_TRUE(command.insertAccountRole(account.account_id, "user"));
+    wsv.commit(state);
+  }
+
+  model::Domain makeDomain(const std::string &domain_id,
+                           const std::string &default_role) {
+    model::Domain domain;
+    domain.domain_id = domain_id;
+    domain.default_role = default_role;
+    return domain;
+  }
+
+  model::Account account;
+  EmbeddedWsv wsv;
+};
+
+/**
+ * @given committed state
+ * @when a copy of it is written and committed
+ * @then readers of the old snapshot still see old state
+ */
+TEST_F(EmbeddedWsvTest, SnapshotIsNotChangedByCopy) {
+  EmbeddedWsvQuery old_state(wsv.snapshot());
+  EmbeddedWsvQuery committed(wsv);
+
+  auto state = std::make_shared<EmbeddedWsvState>(*wsv.snapshot());
+  EmbeddedWsvCommand command(*state);
+  auto updated = account;
+  updated.quorum = 2;
+  ASSERT_TRUE(command.updateAccount(updated));
+  wsv.commit(state);
+
+  ASSERT_EQ(1, old_state.getAccount(account.account_id)->quorum);
+  ASSERT_EQ(2, committed.getAccount(account.account_id)->quorum);
+}
+
+/**
+ * @given committed state
+ * @when rows with duplicate keys or missing references are inserted
+ * @then inserts fail
+ */
+TEST_F(EmbeddedWsvTest, ConstraintsAreChecked) {
+  auto state = std::make_shared<EmbeddedWsvState>(*wsv.snapshot());
+  EmbeddedWsvCommand command(*state);
+  ASSERT_FALSE(command.insertRole("user"));
+  ASSERT_FALSE(command.insertAccount(account));
+  ASSERT_FALSE(command.insertDomain(makeDomain("ru", "missing")));
+  ASSERT_FALSE(command.insertAccountRole(account.account_id, "missing"));
+  ASSERT_FALSE(command.upsertAccountAsset(model::AccountAsset()));
+}
+
+/**
+ * @given changes of roles and details written through overlay
+ * @when they are flushed to a copy of state
+ * @then committed state contains them, and json data of account lists
+ * details like PostgreSQL does
+ */
+TEST_F(EmbeddedWsvTest, OverlayIsFlushed) {
+  EmbeddedWsvQuery committed(wsv.snapshot());
+  WsvOverlay overlay(committed);
+  ASSERT_TRUE(overlay.insertRole("admin"));
+  ASSERT_TRUE(overlay.insertRolePermissions("admin", {model::can_transfer}));
+  ASSERT_TRUE(overlay.insertAccountRole(account.account_id, "admin"));
+  ASSERT_TRUE(overlay.setAccountKV(
+      account.account_id, account.account_id, "name", "Alice"));
+  ASSERT_TRUE(
+      overlay.setAccountKV(account.account_id, account.account_id, "a", "1"));
+
+  auto state = std::make_shared<EmbeddedWsvState>(*wsv.snapshot());
+  EmbeddedWsvCommand command(*state);
+  ASSERT_TRUE(overlay.flush(command));
+  wsv.commit(state);
+
+  EmbeddedWsvQuery query(wsv);
+  ASSERT_EQ((std::vector<std::string>{"user", "admin"}),
+            *query.getAccountRoles(account.account_id));
+  ASSERT_TRUE(query.getAccountPermissions(account.account_id)
+                  ->test(static_cast<size_t>(model::Permission::TRANSFER)));
+  ASSERT_EQ(std::string("Alice"),
+            *query.getAccountDetail(
+                account.account_id, account.account_id, "name"));
+  ASSERT_EQ("{\"admin@test\": {\"a\": \"1\", \"name\": \"Alice\"}}",
+            query.getAccount(account.account_id)->json_data);
+}
@@ -0,0 +1,364 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/segmented_file/segmented_file.hpp"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <thread>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "common/files.hpp"
+
+using namespace iroha::ametsuchi;
+
+class SegmentedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mkdir(block_store_path.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+  }
+  void TearDown() override {
+    iroha::remove_all(block_store_path);
+    rmdir(block_store_path.c_str());
+  }
+
+  /**
+   * @return number of files with given extension in storage folder
+   */
+  size_t countFiles(const std::string &extension) {
+    return std::count_if(
+        boost::filesystem::directory_iterator{block_store_path},
+        boost::filesystem::directory_iterator{},
+        [&extension](const boost::filesystem::path &p) {
+          return p.extension() == extension;
+        });
+  }
+
+  std::string block_store_path = "/tmp/segmented_dump";
+  std::string last_segment = block_store_path + "/0000000000000001.seg";
+};
+
+/**
+ * @given empty segmented storage
+ * @when two blocks are added
+ * @then both blocks are returned unchanged, absent block is not returned
+ */
+TEST_F(SegmentedFileTest, ReadWrite) {
+  std::vector<uint8_t> block1(100000, 5), block2(1000, 7);
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+
+  bl_store->add(1u, block1);
+  bl_store->add(2u, block2);
+
+  ASSERT_EQ(bl_store->last_id(), 2);
+  ASSERT_EQ(*bl_store->get(1u), block1);
+  ASSERT_EQ(*bl_store->get(2u), block2);
+  ASSERT_FALSE(bl_store->get(3u));
+  ASSERT_FALSE(bl_store->get(0u));
+}
+
+/**
+ * @given segmented storage with last id 1
+ * @when block with id 3 is added
+ * @then block is not inserted, and the failure is reported
+ */
+TEST_F(SegmentedFileTest, NonConsecutiveBlockIsRejected) {
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+
+  ASSERT_TRUE(bl_store->add(1u, std::vector<uint8_t>(10, 1)));
+  ASSERT_FALSE(bl_store->add(3u, std::vector<uint8_t>(10, 3)));
+
+  ASSERT_EQ(bl_store->last_id(), 1);
+  ASSERT_FALSE(bl_store->get(3u));
+}
+
+/**
+ * @given segmented storage with small segment size
+ * @when blocks exceeding segment size are added and storage is reopened
+ * @then several segments are created and all blocks are readable
+ */
+TEST_F(SegmentedFileTest, BlocksAreSplitIntoSegments) {
+  const auto blocks = 10u;
+  {
+    auto bl_store = SegmentedFile::create(block_store_path, 2500);
+    ASSERT_TRUE(bl_store);
+    for (auto id = 1u; id <= blocks; ++id) {
+      bl_store->add(id, std::vector<uint8_t>(1000, id));
+    }
+  }
+  ASSERT_EQ(countFiles(".seg"), 5);
+
+  auto bl_store = SegmentedFile::create(block_store_path, 2500);
+  ASSERT_TRUE(bl_store);
+  ASSERT_EQ(bl_store->last_id(), blocks);
+  for (auto id = 1u; id <= blocks; ++id) {
+    ASSERT_EQ(*bl_store->get(id), std::vector<uint8_t>(1000, id));
+  }
+}
+
+/**
+ * @given segmented storage with 3 blocks, and the last one partially written
+ * @when storage is reopened
+ * @then torn block is truncated, and the next block can be appended
+ */
+TEST_F(SegmentedFileTest, TornTailIsTruncated) {
+  {
+    auto bl_store = SegmentedFile::create(block_store_path);
+    ASSERT_TRUE(bl_store);
+    for (auto id = 1u; id <= 3u; ++id) {
+      bl_store->add(id, std::vector<uint8_t>(1000, id));
+    }
+  }
+  auto size = boost::filesystem::file_size(last_segment);
+  boost::filesystem::resize_file(last_segment, size - 10);
+
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+  ASSERT_EQ(bl_store->last_id(), 2);
+  ASSERT_EQ(boost::filesystem::file_size(last_segment),
+            2 * (1000 + SegmentedFile::RECORD_HEADER_SIZE));
+
+  bl_store->add(3u, std::vector<uint8_t>(500, 3));
+  ASSERT_EQ(*bl_store->get(3u), std::vector<uint8_t>(500, 3));
+}
+
+/**
+ * @given segmented storage with a corrupted payload of the last block
+ * @when storage is reopened
+ * @then corrupted block is dropped
+ */
+TEST_F(SegmentedFileTest, CorruptedBlockIsDropped) {
+  {
+    auto bl_store = SegmentedFile::create(block_store_path);
+    ASSERT_TRUE(bl_store);
+    bl_store->add(1u, std::vector<uint8_t>(1000, 1));
+    bl_store->add(2u, std::vector<uint8_t>(1000, 2));
+  }
+  {
+    std::fstream file(last_segment,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put(42);
+  }
+
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+  ASSERT_EQ(bl_store->last_id(), 1);
+}
+
+/**
+ * @given folder of legacy flat file storage with 3 blocks
+ * @when segmented storage is created in the folder
+ * @then all blocks are imported and legacy files are removed
+ */
+TEST_F(SegmentedFileTest, FlatFilesAreImported) {
+  {
+    auto flat_file = FlatFile::create(block_store_path);
+    ASSERT_TRUE(flat_file);
+    for (auto id = 1u; id <= 3u; ++id) {
+      flat_file->add(id, std::vector<uint8_t>(100, id));
+    }
+  }
+
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+  ASSERT_EQ(bl_store->last_id(), 3);
+  ASSERT_EQ(*bl_store->get(2u), std::vector<uint8_t>(100, 2));
+  ASSERT_FALSE(boost::filesystem::exists(block_store_path
+                                         + "/0000000000000001"));
+}
+
+/**
+ * @given segmented storage with blocks and a foreign file in its folder
+ * @when all blocks are dropped
+ * @then storage is empty and accepts blocks from the first one, foreign
+ * file is kept
+ */
+TEST_F(SegmentedFileTest, DropAll) {
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+  bl_store->add(1u, std::vector<uint8_t>(10, 1));
+  std::ofstream(block_store_path + "/foreign") << "data";
+
+  bl_store->dropAll();
+  ASSERT_EQ(bl_store->last_id(), 0);
+  ASSERT_FALSE(bl_store->get(1u));
+  ASSERT_TRUE(boost::filesystem::exists(block_store_path + "/foreign"));
+
+  bl_store->add(1u, std::vector<uint8_t>(10, 2));
+  ASSERT_EQ(*bl_store->get(1u), std::vector<uint8_t>(10, 2));
+}
+
+/**
+ * @given segmented storage with blocks in several segments
+ * @when blocks are viewed, including ones appended after the first view
+ * @then views have the same content as blocks read by get
+ */
+TEST_F(SegmentedFileTest, ViewMatchesGet) {
+  auto bl_store = SegmentedFile::create(block_store_path, 2500);
+  ASSERT_TRUE(bl_store);
+  for (auto id = 1u; id <= 10u; ++id) {
+    bl_store->add(id, std::vector<uint8_t>(1000, id));
+    for (auto viewed = 1u; viewed <= id; ++viewed) {
+      auto view = bl_store->view(viewed);
+      ASSERT_TRUE(view);
+      ASSERT_EQ(std::vector<uint8_t>(view->begin(), view->end()),
+                *bl_store->get(viewed));
+    }
+  }
+  ASSERT_FALSE(bl_store->view(11u));
+}
+
+/**
+ * @given view of a block in segmented storage
+ * @when all blocks are dropped and storage is destroyed
+ * @then view still holds the content of the block
+ */
+TEST_F(SegmentedFileTest, ViewOutlivesStorage) {
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+  bl_store->add(1u, std::vector<uint8_t>(100, 1));
+
+  auto view = bl_store->view(1u);
+  ASSERT_TRUE(view);
+  bl_store->dropAll();
+  bl_store.reset();
+
+  ASSERT_EQ(std::vector<uint8_t>(view->begin(), view->end()),
+            std::vector<uint8_t>(100, 1));
+}
+
+/**
+ * @given closed segmented storage with a corrupted block before the tail
+ * covered by checkpoint
+ * @when storage is reopened with checkpoint and in repair mode
+ * @then checkpoint trusts the block, and full scan drops it with the rest
+ */
+TEST_F(SegmentedFileTest, RepairModeVerifiesAllBlocks) {
+  const auto blocks = SegmentedFile::CHECKPOINT_TAIL + 4;
+  {
+    auto bl_store = SegmentedFile::create(block_store_path);
+    ASSERT_TRUE(bl_store);
+    for (auto id = 1u; id <= blocks; ++id) {
+      bl_store->add(id, std::vector<uint8_t>(100, id));
+    }
+  }
+  ASSERT_TRUE(boost::filesystem::exists(block_store_path + "/MANIFEST"));
+  {
+    std::fstream file(last_segment,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(SegmentedFile::RECORD_HEADER_SIZE);
+    file.put(42);
+  }
+
+  {
+    auto bl_store = SegmentedFile::create(block_store_path);
+    ASSERT_TRUE(bl_store);
+    ASSERT_EQ(bl_store->last_id(), blocks);
+  }
+
+  auto bl_store =
+      SegmentedFile::create(block_store_path,
+                            SegmentedFile::DEFAULT_SEGMENT_SIZE,
+                            SegmentedFile::RecoveryMode::FULL_SCAN);
+  ASSERT_TRUE(bl_store);
+  ASSERT_EQ(bl_store->last_id(), 0);
+}
+
+/**
+ * @given segmented storage with checkpoint, and blocks appended after it
+ * with the last one partially written
+ * @when storage is reopened
+ * @then blocks after checkpoint are verified and torn block is truncated
+ */
+TEST_F(SegmentedFileTest, BlocksAfterCheckpointAreVerified) {
+  const auto manifest = block_store_path + "/MANIFEST";
+  const auto old_manifest = block_store_path + "/MANIFEST.old";
+  {
+    auto bl_store = SegmentedFile::create(block_store_path);
+    ASSERT_TRUE(bl_store);
+    for (auto id = 1u; id <= 3u; ++id) {
+      bl_store->add(id, std::vector<uint8_t>(100, id));
+    }
+    ASSERT_TRUE(bl_store->checkpoint());
+    boost::filesystem::copy_file(manifest, old_manifest);
+    bl_store->add(4u, std::vector<uint8_t>(100, 4));
+    bl_store->add(5u, std::vector<uint8_t>(100, 5));
+  }
+  // simulate crash before the next checkpoint
+  boost::filesystem::rename(old_manifest, manifest);
+  auto size = boost::filesystem::file_size(last_segment);
+  boost::filesystem::resize_file(last_segment, size - 10);
+
+  auto bl_store = SegmentedFile::create(block_store_path);
+  ASSERT_TRUE(bl_store);
+  ASSERT_EQ(bl_store->last_id(), 4);
+  ASSERT_EQ(*bl_store->get(4u), std::vector<uint8_t>(100, 4));
+}
+
+/**
+ * @given segmented storages without syncing and with sync of each block
+ * @when blocks are added
+ * @then only the second storage syncs, once per block
+ */
+TEST_F(SegmentedFileTest, EachBlockIsSynced) {
+  {
+    auto bl_store = SegmentedFile::create(block_store_path);
+    ASSERT_TRUE(bl_store);
+    bl_store->add(1u, std::vector<uint8_t>(100, 1));
+    ASSERT_EQ(bl_store->syncs(), 0);
+    bl_store->dropAll();
+  }
+
+  auto bl_store = SegmentedFile::create(block_store_path,
+                                        SegmentedFile::DEFAULT_SEGMENT_SIZE,
+                                        SegmentedFile::RecoveryMode::CHECKPOINT,
+                                        SyncPolicy{SyncMode::EACH_BLOCK});
+  ASSERT_TRUE(bl_store);
+  for (auto id = 1u; id <= 3u; ++id) {
+    bl_store->add(id, std::vector<uint8_t>(100, id));
+  }
+  ASSERT_EQ(bl_store->syncs(), 3);
+  ASSERT_LE(bl_store->maxSyncTime(), bl_store->syncTime());
+}
+
+/**
+ * @given segmented storage with group commit of 4 blocks
+ * @when 9 blocks are added
+ * @then storage syncs once per full group, and the rest is synced after
+ * group delay
+ */
+TEST_F(SegmentedFileTest, GroupOfBlocksIsSyncedOnce) {
+  SyncPolicy policy{SyncMode::GROUP, 4, std::chrono::milliseconds(50)};
+  auto bl_store = SegmentedFile::create(block_store_path,
+                                        SegmentedFile::DEFAULT_SEGMENT_SIZE,
+                                        SegmentedFile::RecoveryMode::CHECKPOINT,
+                                        policy);
+  ASSERT_TRUE(bl_store);
+  for (auto id = 1u; id <= 8u; ++id) {
+    bl_store->add(id, std::vector<uint8_t>(100, id));
+  }
+  ASSERT_EQ(bl_store->syncs(), 2);
+
+  bl_store->add(9u, std::vector<uint8_t>(100, 9));
+  for (auto i = 0; i < 100 and bl_store->syncs() < 3; ++i) {
+    std::this_thread::sleep_for(policy.group_delay);
+  }
+  ASSERT_EQ(bl_store->syncs(), 3);
+}
@@ -0,0 +1,218 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/cached_wsv_command.hpp"
+#include "ametsuchi/impl/cached_wsv_query.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+using ::testing::Return;
+
+class WsvCacheTest : public ::testing::Test {
+ public:
+  /**
+   * Create query and command of a transaction over given mocks
+   */
+  void begin(std::unique_ptr<MockWsvQuery> query,
+             std::unique_ptr<MockWsvCommand> command =
+                 std::make_unique<MockWsvCommand>()) {
+    written = std::make_shared<WsvCache::Keys>();
+    wsv = std::make_unique<CachedWsvQuery>(std::move(query), cache, written);
+    executor = std::make_unique<CachedWsvCommand>(std::move(command), written);
+  }
+
+  model::Account makeAccount(uint32_t quorum) {
+    model::Account account;
+    account.account_id = "admin@test";
+    account.domain_id = "test";
+    account.quorum = quorum;
+    return account;
+  }
+
+  std::shared_ptr<WsvCache> cache = std::make_shared<WsvCache>();
+  std::shared_ptr<WsvCache::Keys> written;
+  std::unique_ptr<WsvQuery> wsv;
+  std::unique_ptr<WsvCommand> executor;
+};
+
+/**
+ * @given account which was read once
+ * @when it is read again by another transaction
+ * @then it is served from the cache
+ */
+TEST_F(WsvCacheTest, CachedAccountIsNotQueriedAgain) {
+  auto query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccount("admin@test"))
+      .WillOnce(Return(makeAccount(1)));
+  begin(std::move(query));
+  ASSERT_EQ(1, wsv->getAccount("admin@test")->quorum);
+
+  begin(std::make_unique<MockWsvQuery>());
+  ASSERT_EQ(1, wsv->getAccount("admin@test")->quorum);
+  ASSERT_EQ(1, cache->hits());
+  ASSERT_EQ(1, cache->misses());
+}
+
+/**
+ * @given cached account
+ * @when it is updated in a transaction
+ * @then the transaction reads it from the database, and other transactions
+ * still read committed value from the cache
+ */
+TEST_F(WsvCacheTest, WrittenAccountBypassesCache) {
+  auto query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccount("admin@test"))
+      .WillOnce(Return(makeAccount(1)));
+  begin(std::move(query));
+  wsv->getAccount("admin@test");
+
+  query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccount("admin@test"))
+      .WillOnce(Return(makeAccount(2)));
+  auto command = std::make_unique<MockWsvCommand>();
+  EXPECT_CALL(*command, updateAccount(::testing::_)).WillOnce(Return(true));
+  begin(std::move(query), std::move(command));
+  executor->updateAccount(makeAccount(2));
+  ASSERT_EQ(2, wsv->getAccount("admin@test")->quorum);
+  auto uncommitted = written;
+
+  begin(std::make_unique<MockWsvQuery>());
+  ASSERT_EQ(1, wsv->getAccount("admin@test")->quorum);
+
+  cache->invalidate(*uncommitted);
+  query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccount("admin@test"))
+      .WillOnce(Return(makeAccount(2)));
+  begin(std::move(query));
+  ASSERT_EQ(2, wsv->getAccount("admin@test")->quorum);
+}
+
+/**
+ * @given roles of account and permissions of role, which were read before
+ * @when role is granted to the account and permissions are added to role
+ * @then only written entries are invalidated on commit
+ */
+TEST_F(WsvCacheTest, CommitInvalidatesWrittenKeysOnly) {
+  std::vector<std::string> roles{"user"};
+  std::vector<std::string> permissions{"can_transfer"};
+  auto query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccountRoles("admin@test")).WillOnce(Return(roles));
+  EXPECT_CALL(*query, getRolePermissions("user"))
+      .WillOnce(Return(permissions));
+  EXPECT_CALL(*query, getSignatories("admin@test"))
+      .WillOnce(Return(std::vector<pubkey_t>{}));
+  begin(std::move(query));
+  wsv->getAccountRoles("admin@test");
+  wsv->getRolePermissions("user");
+  wsv->getSignatories("admin@test");
+
+  auto command = std::make_unique<MockWsvCommand>();
+  EXPECT_CALL(*command, insertAccountRole("admin@test", "admin"))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*command, insertRolePermissions("user", ::testing::_))
+      .WillOnce(Return(true));
+  begin(std::make_unique<MockWsvQuery>(), std::move(command));
+  executor->insertAccountRole("admin@test", "admin");
+  executor->insertRolePermissions("user", {"can_receive"});
+  cache->invalidate(*written);
+
+  query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccountRoles("admin@test"))
+      .WillOnce(Return(std::vector<std::string>{"user", "admin"}));
+  EXPECT_CALL(*query, getRolePermissions("user"))
+      .WillOnce(Return(std::vector<std::string>{"can_transfer", "can_receive"}));
+  begin(std::move(query));
+  ASSERT_EQ(2, wsv->getAccountRoles("admin@test")->size());
+  ASSERT_EQ(2, wsv->getRolePermissions("user")->size());
+  ASSERT_TRUE(wsv->getSignatories("admin@test"));
+}
+
+/**
+ * @given value read before a commit
+ * @when it is put to the cache after the commit
+ * @then it is not cached
+ */
+TEST_F(WsvCacheTest, ValueReadBeforeCommitIsNotCached) {
+  auto generation = cache->generation();
+  cache->invalidate(WsvCache::Keys{});
+  cache->putAccount(makeAccount(1), generation);
+  ASSERT_FALSE(cache->getAccount("admin@test"));
+
+  cache->putAccount(makeAccount(1), cache->generation());
+  ASSERT_TRUE(cache->getAccount("admin@test"));
+}
+
+/**
+ * @given full cache of two accounts, the first of which was read recently
+ * @when the third account is put
+ * @then only the least recently used account is evicted
+ */
+TEST_F(WsvCacheTest, LeastRecentlyUsedEntryIsEvicted) {
+  WsvCache bounded(2);
+  auto put = [&bounded](const std::string &account_id) {
+    model::Account account;
+    account.account_id = account_id;
+    bounded.putAccount(account, bounded.generation());
+  };
+  put("a@test");
+  put("b@test");
+  ASSERT_TRUE(bounded.getAccount("a@test"));
+
+  put("c@test");
+  ASSERT_TRUE(bounded.getAccount("a@test"));
+  ASSERT_FALSE(bounded.getAccount("b@test"));
+  ASSERT_TRUE(bounded.getAccount("c@test"));
+}
+
+/**
+ * @given cached permission sets of two accounts
+ * @when role of one account is changed, and then permissions of a role
+ * @then only its set is invalidated first, and all sets after that
+ */
+TEST_F(WsvCacheTest, PermissionSetsAreInvalidatedByRoleChanges) {
+  std::vector<std::string> roles{"user"};
+  std::vector<std::string> permissions{model::can_transfer};
+  auto query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccountRoles(::testing::_))
+      .Times(2)
+      .WillRepeatedly(Return(roles));
+  EXPECT_CALL(*query, getRolePermissions("user"))
+      .Times(2)
+      .WillRepeatedly(Return(permissions));
+  begin(std::move(query));
+  wsv->getAccountPermissions("admin@test");
+  wsv->getAccountPermissions("user@test");
+
+  WsvCache::Keys keys;
+  keys.account_roles.insert("admin@test");
+  cache->invalidate(keys);
+
+  query = std::make_unique<MockWsvQuery>();
+  EXPECT_CALL(*query, getAccountRoles("admin@test")).WillOnce(Return(roles));
+  EXPECT_CALL(*query, getRolePermissions("user"))
+      .WillOnce(Return(permissions));
+  begin(std::move(query));
+  ASSERT_EQ(1, wsv->getAccountPermissions("admin@test")->count());
+  ASSERT_EQ(1, wsv->getAccountPermissions("user@test")->count());
+
+  keys = WsvCache::Keys{};
+  keys.role_permissions.insert("user");
+  cache->invalidate(keys);
+  ASSERT_FALSE(cache->getAccountPermissions("admin@test"));
+  ASSERT_FALSE(cache->getAccountPermissions("user@test"));
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_overlay.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class WsvOverlayTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    account.account_id = "admin@test";
+    account.domain_id = "test";
+    account.quorum = 1;
+
+    balance.account_id = account.account_id;
+    balance.asset_id = "coin#test";
+    balance.balance = Amount(100, 2);
+
+    ON_CALL(committed, getAccount(_)).WillByDefault(Return(nonstd::nullopt));
+    ON_CALL(committed, getAccount(account.account_id))
+        .WillByDefault(Return(account));
+    ON_CALL(committed, getAsset(balance.asset_id))
+        .WillByDefault(Return(model::Asset(balance.asset_id, "test", 2)));
+    ON_CALL(committed, getAccountAsset(account.account_id, balance.asset_id))
+        .WillByDefault(Return(balance));
+    ON_CALL(committed, getRoles())
+        .WillByDefault(Return(std::vector<std::string>{"user"}));
+    ON_CALL(committed, getAccountRoles(account.account_id))
+        .WillByDefault(Return(std::vector<std::string>{"user"}));
+    ON_CALL(committed, getRolePermissions(_))
+        .WillByDefault(Return(std::vector<std::string>{}));
+    ON_CALL(committed, getRolePermissions("user"))
+        .WillByDefault(
+            Return(std::vector<std::string>{model::can_add_signatory}));
+    ON_CALL(committed, getSignatories(account.account_id))
+        .WillByDefault(Return(std::vector<pubkey_t>{pubkey_t{}}));
+  }
+
+  model::Account account;
+  model::AccountAsset balance;
+  NiceMock<MockWsvQuery> committed;
+  WsvOverlay overlay{committed};
+};
+
+/**
+ * @given balance changed by released transaction
+ * @when next transaction changes it and is rolled back
+ * @then balance of released transaction is read
+ */
+TEST_F(WsvOverlayTest, RollbackRestoresReleasedBalance) {
+  auto changed = balance;
+  changed.balance = Amount(50, 2);
+  ASSERT_TRUE(overlay.upsertAccountAsset(changed));
+  overlay.release();
+
+  auto discarded = balance;
+  discarded.balance = Amount(10, 2);
+  ASSERT_TRUE(overlay.upsertAccountAsset(discarded));
+  ASSERT_EQ(Amount(10, 2),
+            overlay.getAccountAsset(account.account_id, balance.asset_id)
+                ->balance);
+
+  overlay.rollback();
+  ASSERT_EQ(Amount(50, 2),
+            overlay.getAccountAsset(account.account_id, balance.asset_id)
+                ->balance);
+}
+
+/**
+ * @given role created and appended to account in a transaction
+ * @when permissions of the account are read
+ * @then they include permissions of both committed and created roles
+ * until the transaction is rolled back
+ */
+TEST_F(WsvOverlayTest, AppendedRoleGrantsPermissions) {
+  ASSERT_TRUE(overlay.insertRole("admin"));
+  ASSERT_TRUE(overlay.insertRolePermissions("admin", {model::can_transfer}));
+  ASSERT_TRUE(overlay.insertAccountRole(account.account_id, "admin"));
+
+  auto permissions = overlay.getAccountPermissions(account.account_id);
+  ASSERT_TRUE(permissions);
+  ASSERT_TRUE(permissions->test(
+      static_cast<size_t>(model::Permission::TRANSFER)));
+  ASSERT_TRUE(permissions->test(
+      static_cast<size_t>(model::Permission::ADD_SIGNATORY)));
+
+  overlay.rollback();
+  ASSERT_EQ(std::vector<std::string>{"user"},
+            *overlay.getAccountRoles(account.account_id));
+  ASSERT_EQ(std::vector<std::string>{"user"}, *overlay.getRoles());
+}
+
+/**
+ * @given committed signatory of account
+ * @when it is removed and another one is added
+ * @then only the added one is read
+ */
+TEST_F(WsvOverlayTest, SignatoriesApplyChanges) {
+  pubkey_t added;
+  added.fill(1);
+  ASSERT_TRUE(overlay.insertAccountSignatory(account.account_id, added));
+  ASSERT_TRUE(overlay.deleteAccountSignatory(account.account_id, pubkey_t{}));
+  ASSERT_EQ(std::vector<pubkey_t>{added},
+            *overlay.getSignatories(account.account_id));
+}
+
+/**
+ * @given committed account, role and signatory
+ * @when they are inserted again, or rows reference missing keys
+ * @then writes fail as database constraints would
+ */
+TEST_F(WsvOverlayTest, ConstraintsAreChecked) {
+  ASSERT_FALSE(overlay.insertAccount(account));
+  ASSERT_FALSE(overlay.insertRole("user"));
+  ASSERT_FALSE(overlay.insertRolePermissions("missing", {}));
+  ASSERT_FALSE(overlay.insertAccountRole(account.account_id, "user"));
+  ASSERT_FALSE(overlay.insertAccountSignatory(account.account_id, pubkey_t{}));
+
+  auto unknown = balance;
+  unknown.account_id = "unknown@test";
+  ASSERT_FALSE(overlay.upsertAccountAsset(unknown));
+  ASSERT_FALSE(overlay.insertRole(std::string(46, 'a')));
+  ASSERT_FALSE(
+      overlay.setAccountKV(account.account_id, "admin@test", "key", "\""));
+}
+
+/**
+ * @given account detail set in a transaction
+ * @when it is read
+ * @then the value is read without querying committed state
+ */
+TEST_F(WsvOverlayTest, DetailIsReadFromOverlay) {
+  EXPECT_CALL(committed, getAccountDetail(_, _, _)).Times(0);
+  ASSERT_TRUE(
+      overlay.setAccountKV(account.account_id, "admin@test", "age", "18"));
+  ASSERT_EQ(std::string("18"),
+            *overlay.getAccountDetail(account.account_id, "admin@test", "age"));
+}
+
+/**
+ * @given account detail values with JSON escapes, valid and invalid
+ * @when they are set in a transaction
+ * @then they are accepted and decoded or rejected as jsonb string contents
+ * are by the database
+ */
+TEST_F(WsvOverlayTest, DetailIsDecodedAsJsonString) {
+  auto set = [this](const std::string &val) {
+    return overlay.setAccountKV(account.account_id, "admin@test", "key", val);
+  };
+  auto get = [this] {
+    return *overlay.getAccountDetail(account.account_id, "admin@test", "key");
+  };
+
+  ASSERT_TRUE(set(R"(a\"b)"));
+  ASSERT_EQ(std::string("a\"b"), get());
+  ASSERT_TRUE(set(R"(x\\y\/z\n)"));
+  ASSERT_EQ(std::string("x\\y/z\n"), get());
+  ASSERT_TRUE(set(R"(é😀)"));
+  ASSERT_EQ(std::string("\xc3\xa9\xf0\x9f\x98\x80"), get());
+
+  for (const auto &val : {R"(a"b)",
+                          R"(a\)",
+                          R"(\x)",
+                          R"(\u12)",
+                          R"(\u0000)",
+                          R"(\ud83d)",
+                          R"(\ude00)",
+                          "\x01",
+                          "\xff"}) {
+    ASSERT_FALSE(set(val)) << val;
+  }
+}
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <limits>
+
 #include "ametsuchi/impl/postgres_wsv_command.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
@@ -102,7 +104,11 @@ CREATE TABLE IF NOT EXISTS asset (
 CREATE TABLE IF NOT EXISTS account_has_asset (
     account_id character varying(197) NOT NULL REFERENCES account,
     asset_id character varying(197) NOT NULL REFERENCES asset,
-    amount bigint NOT NULL,
+    amount_0 bigint NOT NULL,
+    amount_1 bigint NOT NULL,
+    amount_2 bigint NOT NULL,
+    amount_3 bigint NOT NULL,
+    amount_precision smallint NOT NULL,
     PRIMARY KEY (account_id, asset_id)
 );
 CREATE TABLE IF NOT EXISTS role_has_permissions (
@@ -321,6 +327,30 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
       ASSERT_EQ(1, roles->size());
     }
 
+    /**
+     * @given account with two roles, which share a permission
+     * @when permissions of account are queried
+     * @then union of permissions of both roles is returned
+     */
+    TEST_F(AccountRoleTest, GetAccountPermissionsOfAllRoles) {
+      auto other_role = role + "2";
+      ASSERT_TRUE(command->insertRole(other_role));
+      ASSERT_TRUE(command->insertRolePermissions(
+          role, {model::can_transfer, model::can_receive}));
+      ASSERT_TRUE(command->insertRolePermissions(
+          other_role, {model::can_transfer, model::can_add_peer}));
+      ASSERT_TRUE(command->insertAccountRole(account.account_id, role));
+      ASSERT_TRUE(command->insertAccountRole(account.account_id, other_role));
+
+      auto permissions = query->getAccountPermissions(account.account_id);
+      ASSERT_TRUE(permissions);
+      ASSERT_EQ(model::makePermissionSet(std::vector<std::string>{
+                    model::can_transfer,
+                    model::can_receive,
+                    model::can_add_peer}),
+                *permissions);
+    }
+
     class AccountGrantablePermissionTest : public WsvQueryCommandTest {
      public:
       AccountGrantablePermissionTest() {
@@ -377,5 +407,90 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
       ASSERT_FALSE(query->hasAccountGrantablePermission(
           permittee_account.account_id, account.account_id, permission));
     }
+
+    class AccountAssetBatchTest : public WsvQueryCommandTest {
+     public:
+      void SetUp() override {
+        WsvQueryCommandTest::SetUp();
+        batch = std::make_shared<PostgresWsvBatch>(*wsv_transaction);
+        command =
+            std::make_unique<PostgresWsvCommand>(*wsv_transaction, batch);
+        query = std::make_unique<PostgresWsvQuery>(*wsv_transaction, batch);
+        ASSERT_TRUE(command->insertRole(role));
+        ASSERT_TRUE(command->insertDomain(domain));
+        ASSERT_TRUE(command->insertAccount(account));
+        ASSERT_TRUE(command->insertAsset(asset));
+      }
+
+      model::AccountAsset makeAccountAsset(uint64_t balance) {
+        model::AccountAsset account_asset;
+        account_asset.account_id = account.account_id;
+        account_asset.asset_id = asset.asset_id;
+        account_asset.balance = Amount(balance, 0);
+        return account_asset;
+      }
+
+      model::Asset asset{"coin#" + domain.domain_id, domain.domain_id, 0};
+      std::shared_ptr<PostgresWsvBatch> batch;
+    };
+
+    /**
+     * @given batch with balance written twice
+     * @when balance is read before and after flush
+     * @then the last balance is read from batch, and it is in the database
+     * only after flush
+     */
+    TEST_F(AccountAssetBatchTest, BalanceIsWrittenOnFlush) {
+      ASSERT_TRUE(command->upsertAccountAsset(makeAccountAsset(100)));
+      ASSERT_TRUE(command->upsertAccountAsset(makeAccountAsset(70)));
+      ASSERT_EQ(1, batch->size());
+
+      auto pending = query->getAccountAsset(account.account_id, asset.asset_id);
+      ASSERT_TRUE(pending);
+      ASSERT_EQ(makeAccountAsset(70).balance, pending->balance);
+
+      PostgresWsvQuery database(*wsv_transaction);
+      ASSERT_FALSE(database.getAccountAsset(account.account_id, asset.asset_id));
+
+      ASSERT_TRUE(batch->flush());
+      ASSERT_EQ(0, batch->size());
+      auto written =
+          database.getAccountAsset(account.account_id, asset.asset_id);
+      ASSERT_TRUE(written);
+      ASSERT_EQ(makeAccountAsset(70).balance, written->balance);
+    }
+
+    /**
+     * @given batch with balance of account which does not exist
+     * @when batch is flushed
+     * @then flush fails like a single upsert would
+     */
+    TEST_F(AccountAssetBatchTest, FlushFailsWhenNoAccount) {
+      auto account_asset = makeAccountAsset(100);
+      account_asset.account_id = "no@" + domain.domain_id;
+      ASSERT_TRUE(command->upsertAccountAsset(account_asset));
+      ASSERT_FALSE(batch->flush());
+    }
+
+    /**
+     * @given balance with all limbs set, including the most significant bit
+     * @when it is written without batch and read back
+     * @then value and precision are the same
+     */
+    TEST_F(AccountAssetBatchTest, LargeBalanceIsReadBack) {
+      auto max = std::numeric_limits<uint64_t>::max();
+      auto account_asset = makeAccountAsset(0);
+      account_asset.balance = Amount(max, 1, max - 1, 2, 18);
+
+      PostgresWsvCommand single(*wsv_transaction);
+      ASSERT_TRUE(single.upsertAccountAsset(account_asset));
+      PostgresWsvQuery database(*wsv_transaction);
+      auto written =
+          database.getAccountAsset(account.account_id, asset.asset_id);
+      ASSERT_TRUE(written);
+      ASSERT_EQ(account_asset.balance.to_uint64s(),
+                written->balance.to_uint64s());
+      ASSERT_EQ(18, written->balance.getPrecision());
+    }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -1219,9 +1219,9 @@ class GrantPermissionTest : public CommandValidateExecuteTest {
  public:
   void SetUp() override {
     CommandValidateExecuteTest::SetUp();
-    exact_command = std::make_shared<GrantPermission>("yoda", "CanTeach");
+    exact_command = std::make_shared<GrantPermission>("yoda", can_set_quorum);
     command = exact_command;
-    role_permissions = {"CanGrantCanTeach"};
+    role_permissions = {can_grant + can_set_quorum};
   }
   std::shared_ptr<GrantPermission> exact_command;
 };
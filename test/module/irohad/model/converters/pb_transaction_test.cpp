@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include "commands.pb.h"
+#include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
 #include "model/converters/pb_transaction_factory.hpp"
 #include "model/transaction.hpp"
 
@@ -58,3 +59,66 @@ TEST(TransactionTest, tx_test) {
   auto serial_tx = factory.deserialize(proto_tx);
   ASSERT_EQ(orig_tx, *serial_tx);
 }
+
+/**
+ * @given transaction deserialized from protobuf
+ * @when it is hashed, then copied and the copy is modified and reset
+ * @then the copy reports the hash of its source until it is reset, and
+ * the hash of the modified payload afterwards
+ */
+TEST(TransactionTest, MemoizedHashIsCopied) {
+  auto orig_tx = iroha::model::Transaction();
+  orig_tx.creator_account_id = "andr@kek";
+  orig_tx.created_ts = 2;
+  orig_tx.tx_counter = 1;
+
+  auto factory = iroha::model::converters::PbTransactionFactory();
+  auto serial_tx = factory.deserialize(factory.serialize(orig_tx));
+  auto orig_hash = iroha::hash(orig_tx);
+  ASSERT_EQ(orig_hash, iroha::hash(*serial_tx));
+
+  auto copy = *serial_tx;
+  copy.tx_counter = 2;
+  ASSERT_EQ(orig_hash, iroha::hash(copy));
+
+  copy.hash_memo.reset();
+  orig_tx.tx_counter = 2;
+  ASSERT_EQ(iroha::hash(orig_tx), iroha::hash(copy));
+  ASSERT_EQ(orig_hash, iroha::hash(*serial_tx));
+}
+
+/**
+ * @given hash memo
+ * @when hash is requested before and after the memo is enabled, and from
+ * copies of the memo
+ * @then it is computed on every call before, once after, and copies of
+ * the filled memo do not compute it again until they are reset
+ */
+TEST(TransactionTest, HashMemoComputesOnceEnabled) {
+  iroha::model::HashMemo memo;
+  size_t computed = 0;
+  auto compute = [&computed] {
+    ++computed;
+    return iroha::hash256_t{};
+  };
+
+  memo.get(compute);
+  memo.get(compute);
+  ASSERT_EQ(2, computed);
+
+  memo.enable();
+  memo.get(compute);
+  memo.get(compute);
+  ASSERT_EQ(3, computed);
+
+  auto copy = memo;
+  iroha::model::HashMemo assigned;
+  assigned = copy;
+  copy.get(compute);
+  assigned.get(compute);
+  ASSERT_EQ(3, computed);
+
+  copy.reset();
+  copy.get(compute);
+  ASSERT_EQ(4, computed);
+}
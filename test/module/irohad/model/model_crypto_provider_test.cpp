@@ -44,6 +44,63 @@ namespace iroha {
       ASSERT_FALSE(provider.verify(model_tx));
     }
 
+    /**
+     * @given provider verifying on a pool and signed transactions, one of
+     * them modified after signing
+     * @when the transactions are verified as a batch
+     * @then only the modified transaction fails, and the result matches
+     * the one of verification one by one
+     */
+    TEST_F(CryptoProviderTest, VerifyTransactionBatch) {
+      ModelCryptoProviderImpl pooled(
+          create_keypair(), std::make_shared<ThreadPool>(4), nullptr);
+      std::vector<std::shared_ptr<const Transaction>> transactions;
+      for (size_t i = 0; i < 16; ++i) {
+        auto model_tx = generators::TransactionGenerator().generateTransaction(
+            "test", i, {});
+        provider.sign(model_tx);
+        pooled.sign(model_tx);
+        if (i == 5) {
+          model_tx.creator_account_id = "test1";
+        }
+        transactions.push_back(std::make_shared<Transaction>(model_tx));
+      }
+
+      auto result = pooled.verify(transactions);
+
+      ASSERT_EQ(transactions.size(), result.size());
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        ASSERT_EQ(i != 5, result[i]);
+        ASSERT_EQ(provider.verify(*transactions[i]), result[i]);
+      }
+    }
+
+    /**
+     * @given two providers sharing signature cache
+     * @when transaction is verified by both, and then modified
+     * @then the second verification is served from the cache, and the
+     * modified transaction is verified and rejected
+     */
+    TEST_F(CryptoProviderTest, VerifiedSignaturesAreCached) {
+      auto cache = std::make_shared<SignatureCache>();
+      ModelCryptoProviderImpl ingest(create_keypair(), nullptr, cache);
+      ModelCryptoProviderImpl loader(create_keypair(), nullptr, cache);
+      auto model_tx =
+          generators::TransactionGenerator().generateTransaction("test", 0, {});
+      provider.sign(model_tx);
+
+      ASSERT_TRUE(ingest.verify(model_tx));
+      ASSERT_EQ(0, cache->hits());
+      ASSERT_TRUE(loader.verify(
+          std::vector<std::shared_ptr<const Transaction>>{
+              std::make_shared<Transaction>(model_tx)})[0]);
+      ASSERT_EQ(1, cache->hits());
+
+      model_tx.creator_account_id = "test1";
+      ASSERT_FALSE(loader.verify(model_tx));
+      ASSERT_EQ(1, cache->hits());
+    }
+
     TEST_F(CryptoProviderTest, SignAndVerifyQuery) {
       auto query =
           generators::QueryGenerator().generateGetAccount(0, "test", 0, "test");
@@ -29,6 +29,10 @@ namespace iroha {
     class MockCryptoProvider : public ModelCryptoProvider {
      public:
       MOCK_CONST_METHOD1(verify, bool(const Transaction &));
+      MOCK_CONST_METHOD1(
+          verify,
+          std::vector<bool>(
+              const std::vector<std::shared_ptr<const Transaction>> &));
       MOCK_CONST_METHOD1(verify, bool(const Query &));
       MOCK_CONST_METHOD1(verify, bool(const Block &));
       MOCK_CONST_METHOD1(sign, void(Block &));
@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/permissions.hpp"
+#include <gtest/gtest.h>
+
+using namespace iroha::model;
+
+/**
+ * @given names of all permissions
+ * @when they are mapped to enumerated permissions and back
+ * @then each name maps to its own permission
+ */
+TEST(PermissionsTest, NamesMapToTheirPermissions) {
+  const auto &names = permissionNames();
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto permission = permissionOf(names[i]);
+    ASSERT_TRUE(permission) << names[i];
+    ASSERT_EQ(i, static_cast<size_t>(*permission));
+    ASSERT_EQ(names[i], permissionName(*permission));
+  }
+  for (const auto &name : all_perm_group) {
+    ASSERT_TRUE(permissionOf(name)) << name;
+  }
+  ASSERT_FALSE(permissionOf("CanDoAnything"));
+}
+
+/**
+ * @given names of permissions which are not in all_perm_group
+ * @when they are mapped to enumerated permissions
+ * @then each of them is known
+ */
+TEST(PermissionsTest, UngroupedNamesAreKnown) {
+  for (const auto &name : {can_transfer,
+                           can_receive,
+                           can_set_detail,
+                           can_get_domain_accounts,
+                           can_get_domain_signatories,
+                           can_get_domain_acc_ast,
+                           can_get_all_acc_detail,
+                           can_get_domain_acc_detail,
+                           can_get_domain_acc_txs,
+                           can_get_domain_acc_ast_txs}) {
+    ASSERT_TRUE(permissionOf(name)) << name;
+  }
+}
+
+/**
+ * @given names of role permissions with unknown name among them
+ * @when set of permissions is made from them
+ * @then only known permissions are in the set
+ */
+TEST(PermissionsTest, SetIsMadeOfKnownNames) {
+  auto permissions = makePermissionSet(
+      std::set<std::string>{can_transfer, can_receive, "CanDoAnything"});
+  ASSERT_EQ(2, permissions.count());
+  ASSERT_TRUE(permissions.test(static_cast<size_t>(Permission::TRANSFER)));
+  ASSERT_TRUE(permissions.test(static_cast<size_t>(Permission::RECEIVE)));
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "model/signature_cache.hpp"
+
+using namespace iroha::model;
+
+namespace {
+  iroha::sig_t makeSignature(uint8_t seed) {
+    iroha::sig_t signature;
+    signature.fill(seed);
+    return signature;
+  }
+}  // namespace
+
+/**
+ * @given cache with a put signature
+ * @when the same and a different signature are looked up
+ * @then only the put one is found, and hits and misses are counted
+ */
+TEST(SignatureCacheTest, FindsPutSignature) {
+  SignatureCache cache;
+  iroha::pubkey_t pubkey;
+  pubkey.fill(1);
+
+  cache.put("message", pubkey, makeSignature(1));
+
+  ASSERT_TRUE(cache.contains("message", pubkey, makeSignature(1)));
+  ASSERT_FALSE(cache.contains("message", pubkey, makeSignature(2)));
+  ASSERT_FALSE(cache.contains("other", pubkey, makeSignature(1)));
+  ASSERT_EQ(1, cache.hits());
+  ASSERT_EQ(2, cache.misses());
+}
+
+/**
+ * @given cache with less entries than signatures put in it
+ * @when signatures are put from several threads
+ * @then the number of cached signatures does not exceed the bound
+ */
+TEST(SignatureCacheTest, IsBounded) {
+  SignatureCache cache(32);
+  iroha::pubkey_t pubkey;
+  pubkey.fill(1);
+
+  std::vector<std::thread> threads;
+  for (uint8_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, &pubkey, t] {
+      for (uint8_t i = 0; i < 64; ++i) {
+        cache.put(std::to_string(t), pubkey, makeSignature(i));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  size_t cached = 0;
+  for (uint8_t t = 0; t < 4; ++t) {
+    for (uint8_t i = 0; i < 64; ++i) {
+      cached += cache.contains(std::to_string(t), pubkey, makeSignature(i));
+    }
+  }
+  ASSERT_LE(cached, 32);
+  ASSERT_GT(cached, 0);
+}
+
+/**
+ * @given disabled cache
+ * @when signature is put
+ * @then it is not found
+ */
+TEST(SignatureCacheTest, ZeroEntriesDisablesCache) {
+  SignatureCache cache(0);
+  iroha::pubkey_t pubkey;
+
+  cache.put("message", pubkey, makeSignature(1));
+
+  ASSERT_FALSE(cache.contains("message", pubkey, makeSignature(1)));
+}
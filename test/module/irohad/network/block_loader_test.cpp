@@ -74,8 +74,8 @@ TEST_F(BlockLoaderTest, ValidWhenSameTopBlock) {
   block.height = 1;
 
   EXPECT_CALL(*peer_query, getLedgerPeers()).WillOnce(Return(peers));
-  EXPECT_CALL(*storage, getTopBlocks(1))
-      .WillOnce(Return(rxcpp::observable<>::just(block)));
+  EXPECT_CALL(*storage, getTopBlock())
+      .WillOnce(Return(std::make_shared<const Block>(block)));
   EXPECT_CALL(*storage, getBlocksFrom(block.height + 1))
       .WillOnce(Return(rxcpp::observable<>::empty<Block>()));
   auto wrapper =
@@ -95,8 +95,8 @@ TEST_F(BlockLoaderTest, ValidWhenOneBlock) {
 
   EXPECT_CALL(*provider, verify(A<const Block &>())).WillOnce(Return(true));
   EXPECT_CALL(*peer_query, getLedgerPeers()).WillOnce(Return(peers));
-  EXPECT_CALL(*storage, getTopBlocks(1))
-      .WillOnce(Return(rxcpp::observable<>::just(block)));
+  EXPECT_CALL(*storage, getTopBlock())
+      .WillOnce(Return(std::make_shared<const Block>(block)));
   EXPECT_CALL(*storage, getBlocksFrom(block.height + 1))
       .WillOnce(Return(rxcpp::observable<>::just(top_block)));
   auto wrapper =
@@ -126,8 +126,8 @@ TEST_F(BlockLoaderTest, ValidWhenMultipleBlocks) {
       .Times(num_blocks)
       .WillRepeatedly(Return(true));
   EXPECT_CALL(*peer_query, getLedgerPeers()).WillOnce(Return(peers));
-  EXPECT_CALL(*storage, getTopBlocks(1))
-      .WillOnce(Return(rxcpp::observable<>::just(block)));
+  EXPECT_CALL(*storage, getTopBlock())
+      .WillOnce(Return(std::make_shared<const Block>(block)));
   EXPECT_CALL(*storage, getBlocksFrom(next_height))
       .WillOnce(Return(rxcpp::observable<>::iterate(blocks)));
   auto wrapper = make_test_subscriber<CallExact>(
@@ -146,8 +146,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockPresent) {
 
   EXPECT_CALL(*provider, verify(A<const Block &>())).WillOnce(Return(true));
   EXPECT_CALL(*peer_query, getLedgerPeers()).WillOnce(Return(peers));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(Return(rxcpp::observable<>::just(requested_block)));
+  EXPECT_CALL(*storage, getBlockByHash(requested_block.hash))
+      .WillOnce(Return(requested_block));
   auto block = loader->retrieveBlock(peer.pubkey, requested_block.hash);
 
   ASSERT_TRUE(block.has_value());
@@ -163,8 +163,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockMissing) {
   hash.fill(0);
 
   EXPECT_CALL(*peer_query, getLedgerPeers()).WillOnce(Return(peers));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(Return(rxcpp::observable<>::just(present_block)));
+  EXPECT_CALL(*storage, getBlockByHash(hash))
+      .WillOnce(Return(boost::none));
   auto block = loader->retrieveBlock(peer.pubkey, hash);
 
   ASSERT_FALSE(block.has_value());
@@ -31,6 +31,7 @@ using namespace iroha::simulator;
 using namespace iroha::network;
 using namespace framework::test_subscriber;
 
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnArg;
 using ::testing::A;
@@ -77,10 +78,12 @@ TEST_F(SimulatorTest, ValidWhenPreviousBlock) {
   model::Block block;
   block.height = proposal.height - 1;
 
-  EXPECT_CALL(*factory, createTemporaryWsv()).Times(1);
+  EXPECT_CALL(*factory, createTemporaryWsv()).WillOnce(Invoke([] {
+    return std::make_unique<MockTemporaryWsv>();
+  }));
 
-  EXPECT_CALL(*query, getTopBlocks(1))
-      .WillOnce(Return(rxcpp::observable<>::just(block)));
+  EXPECT_CALL(*query, getTopBlock())
+      .WillOnce(Return(std::make_shared<const model::Block>(block)));
 
   EXPECT_CALL(*validator, validate(_, _)).WillOnce(Return(proposal));
 
@@ -120,8 +123,46 @@ TEST_F(SimulatorTest, FailWhenNoBlock) {
 
   EXPECT_CALL(*factory, createTemporaryWsv()).Times(0);
 
-  EXPECT_CALL(*query, getTopBlocks(1))
-      .WillOnce(Return(rxcpp::observable<>::empty<model::Block>()));
+  EXPECT_CALL(*query, getTopBlock()).WillOnce(Return(nullptr));
+
+  EXPECT_CALL(*validator, validate(_, _)).Times(0);
+
+  EXPECT_CALL(*ordering_gate, on_proposal())
+      .WillOnce(Return(rxcpp::observable<>::empty<Proposal>()));
+
+  EXPECT_CALL(*crypto_provider, sign(A<Block &>())).Times(0);
+
+  init();
+
+  auto proposal_wrapper =
+      make_test_subscriber<CallExact>(simulator->on_verified_proposal(), 0);
+  proposal_wrapper.subscribe();
+
+  auto block_wrapper =
+      make_test_subscriber<CallExact>(simulator->on_block(), 0);
+  block_wrapper.subscribe();
+
+  simulator->process_proposal(proposal);
+
+  ASSERT_TRUE(proposal_wrapper.validate());
+  ASSERT_TRUE(block_wrapper.validate());
+}
+
+TEST_F(SimulatorTest, FailWhenNoTemporaryStorage) {
+  // height 2 proposal => temporary storage not created => no validated proposal
+  auto txs = std::vector<model::Transaction>(2);
+  auto proposal = model::Proposal(txs);
+  proposal.height = 2;
+
+  model::Block block;
+  block.height = proposal.height - 1;
+
+  EXPECT_CALL(*factory, createTemporaryWsv()).WillOnce(Invoke([] {
+    return std::unique_ptr<TemporaryWsv>();
+  }));
+
+  EXPECT_CALL(*query, getTopBlock())
+      .WillOnce(Return(std::make_shared<const model::Block>(block)));
 
   EXPECT_CALL(*validator, validate(_, _)).Times(0);
 
@@ -157,8 +198,8 @@ TEST_F(SimulatorTest, FailWhenSameAsProposalHeight) {
 
   EXPECT_CALL(*factory, createTemporaryWsv()).Times(0);
 
-  EXPECT_CALL(*query, getTopBlocks(1))
-      .WillOnce(Return(rxcpp::observable<>::just(block)));
+  EXPECT_CALL(*query, getTopBlock())
+      .WillOnce(Return(std::make_shared<const model::Block>(block)));
 
   EXPECT_CALL(*validator, validate(_, _)).Times(0);
 
@@ -34,6 +34,7 @@ using namespace framework::test_subscriber;
 using ::testing::Return;
 using ::testing::_;
 using ::testing::A;
+using ::testing::Invoke;
 
 class TransactionProcessorTest : public ::testing::Test {
  public:
@@ -103,3 +104,38 @@ TEST_F(TransactionProcessorTest,
 
   ASSERT_TRUE(wrapper.validate());
 }
+
+/**
+ * Transaction processor test case, when transactions are validated in
+ * batches on a pool
+ */
+TEST_F(TransactionProcessorTest,
+       TransactionProcessorWhereTransactionsAreValidatedOnPool) {
+  EXPECT_CALL(*pcs, propagate_transaction(_)).Times(3);
+
+  EXPECT_CALL(*validation, validate(A<const Transaction &>())).Times(0);
+  EXPECT_CALL(
+      *validation,
+      validate(A<const std::vector<std::shared_ptr<const Transaction>> &>()))
+      .WillRepeatedly(Invoke([](const auto &transactions) {
+        return std::vector<bool>(transactions.size(), true);
+      }));
+
+  auto pooled = std::make_shared<TransactionProcessorImpl>(
+      pcs, validation, std::make_shared<ThreadPool>(2));
+
+  auto wrapper =
+      make_test_subscriber<CallExact>(pooled->transactionNotifier(), 3);
+  wrapper.subscribe([](auto response) {
+    auto resp = static_cast<TransactionResponse &>(*response);
+    ASSERT_EQ(resp.current_status,
+              iroha::model::TransactionResponse::STATELESS_VALIDATION_SUCCESS);
+  });
+  for (int i = 0; i < 3; ++i) {
+    pooled->transactionHandle(std::make_shared<Transaction>());
+  }
+  // waits for pending transactions to be validated
+  pooled.reset();
+
+  ASSERT_TRUE(wrapper.validate());
+}
@@ -0,0 +1,230 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "ametsuchi/impl/embedded_wsv/embedded_temporary_wsv.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv.hpp"
+#include "ametsuchi/impl/embedded_wsv/embedded_wsv_command.hpp"
+#include "ametsuchi/temporary_factory.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/set_quorum.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "model/permissions.hpp"
+#include "validation/impl/conflict_groups.hpp"
+#include "validation/impl/stateful_validator_impl.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+using namespace iroha::validation;
+
+/**
+ * Temporary world state views over one embedded snapshot
+ */
+class EmbeddedTemporaryFactory : public TemporaryFactory {
+ public:
+  EmbeddedTemporaryFactory(
+      std::shared_ptr<const EmbeddedWsvState> state,
+      std::shared_ptr<CommandExecutorFactory> command_executors)
+      : state_(std::move(state)),
+        command_executors_(std::move(command_executors)) {}
+
+  std::unique_ptr<TemporaryWsv> createTemporaryWsv() override {
+    return std::make_unique<EmbeddedTemporaryWsv>(state_, command_executors_);
+  }
+
+ private:
+  std::shared_ptr<const EmbeddedWsvState> state_;
+  std::shared_ptr<CommandExecutorFactory> command_executors_;
+};
+
+class StatefulValidationTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto state = std::make_shared<EmbeddedWsvState>();
+    EmbeddedWsvCommand command(*state);
+    ASSERT_TRUE(command.insertRole("user"));
+    ASSERT_TRUE(command.insertRolePermissions(
+        "user", {can_transfer, can_receive, can_create_account}));
+    Domain domain;
+    domain.domain_id = "test";
+    domain.default_role = "user";
+    ASSERT_TRUE(command.insertDomain(domain));
+    Asset asset;
+    asset.asset_id = "coin#test";
+    asset.domain_id = "test";
+    asset.precision = 2;
+    ASSERT_TRUE(command.insertAsset(asset));
+
+    for (size_t i = 0; i < ACCOUNTS; ++i) {
+      Account account;
+      account.account_id = accountId(i);
+      account.domain_id = "test";
+      account.quorum = 1;
+      account.json_data = "{}";
+      ASSERT_TRUE(command.insertAccount(account));
+      ASSERT_TRUE(command.insertSignatory(pubkey(i)));
+      ASSERT_TRUE(command.insertAccountSignatory(account.account_id, pubkey(i)));
+      ASSERT_TRUE(command.insertAccountRole(account.account_id, "user"));
+      AccountAsset balance;
+      balance.account_id = account.account_id;
+      balance.asset_id = "coin#test";
+      balance.balance = Amount(10000ul, 2);
+      ASSERT_TRUE(command.upsertAccountAsset(balance));
+    }
+
+    factory = std::make_shared<EmbeddedTemporaryFactory>(
+        state, CommandExecutorFactory::create().value());
+  }
+
+  std::string accountId(size_t i) {
+    return "user" + std::to_string(i) + "@test";
+  }
+
+  pubkey_t pubkey(size_t i) {
+    pubkey_t key{};
+    key[0] = i + 1;
+    return key;
+  }
+
+  Transaction makeTx(size_t creator,
+                     std::vector<std::shared_ptr<Command>> commands) {
+    Transaction tx;
+    tx.creator_account_id = accountId(creator);
+    tx.created_ts = ++ts;
+    tx.signatures.emplace_back(iroha::sig_t{}, pubkey(creator));
+    tx.commands = std::move(commands);
+    return tx;
+  }
+
+  Transaction transfer(size_t src, size_t dest, uint64_t amount) {
+    auto command = std::make_shared<TransferAsset>();
+    command->src_account_id = accountId(src);
+    command->dest_account_id = accountId(dest);
+    command->asset_id = "coin#test";
+    command->amount = Amount(amount, 2);
+    return makeTx(src, {command});
+  }
+
+  Proposal validate(StatefulValidatorImpl &validator,
+                    const std::vector<Transaction> &txs) {
+    Proposal proposal(txs);
+    proposal.height = 2;
+    auto wsv = factory->createTemporaryWsv();
+    return validator.validate(proposal, *wsv);
+  }
+
+  static constexpr size_t ACCOUNTS = 8;
+  std::shared_ptr<EmbeddedTemporaryFactory> factory;
+  ts64_t ts = 0;
+};
+
+constexpr size_t StatefulValidationTest::ACCOUNTS;
+
+/**
+ * @given transfers between disjoint pairs of accounts and a chain of
+ * transfers sharing accounts
+ * @when transactions are grouped by conflicts
+ * @then each disjoint transfer is a group and the chain is one group
+ */
+TEST_F(StatefulValidationTest, TransfersAreGroupedByAccounts) {
+  std::vector<Transaction> txs{transfer(0, 1, 10),
+                               transfer(2, 3, 10),
+                               transfer(1, 4, 10),
+                               transfer(5, 6, 10),
+                               transfer(4, 7, 10)};
+
+  auto groups = conflictGroups(txs);
+
+  ASSERT_TRUE(groups);
+  std::vector<ConflictGroup> expected{{0, 2, 4}, {1}, {3}};
+  ASSERT_EQ(expected, *groups);
+}
+
+/**
+ * @given transactions reading the same asset and account
+ * @when transactions are grouped by conflicts
+ * @then they are joined only when the account is written
+ */
+TEST_F(StatefulValidationTest, ReadsDoNotConflict) {
+  // transfer reads permissions of user0 as receiver, creation of account
+  // reads permissions of user0 as creator
+  std::vector<Transaction> txs{
+      transfer(1, 0, 10),
+      transfer(2, 3, 10),
+      makeTx(0, {std::make_shared<CreateAccount>("new", "test", pubkey(9))})};
+
+  auto groups = conflictGroups(txs);
+
+  ASSERT_TRUE(groups);
+  ASSERT_EQ(3, groups->size());
+
+  txs.push_back(makeTx(0, {std::make_shared<SetQuorum>(accountId(0), 1)}));
+  groups = conflictGroups(txs);
+
+  ASSERT_TRUE(groups);
+  std::vector<ConflictGroup> expected{{0, 2, 3}, {1}};
+  ASSERT_EQ(expected, *groups);
+}
+
+/**
+ * @given transaction with a command of unknown footprint
+ * @when transactions are grouped by conflicts
+ * @then grouping is refused
+ */
+TEST_F(StatefulValidationTest, UnknownCommandIsNotGrouped) {
+  struct UnknownCommand : public Command {
+    bool operator==(const Command &rhs) const override {
+      return false;
+    }
+  };
+  std::vector<Transaction> txs{transfer(0, 1, 10),
+                               makeTx(2, {std::make_shared<UnknownCommand>()})};
+
+  ASSERT_FALSE(conflictGroups(txs));
+}
+
+/**
+ * @given proposal with independent transfers, chains of transfers, which
+ * are valid only in order, and transfers exceeding balance
+ * @when it is validated in order and by groups on a pool
+ * @then both verified proposals are the same
+ */
+TEST_F(StatefulValidationTest, ParallelResultIsSameAsSequential) {
+  std::vector<Transaction> txs{
+      transfer(0, 1, 10000),  // whole balance of user0
+      transfer(1, 2, 15000),  // valid only after the previous one
+      transfer(0, 3, 100),    // user0 has nothing left
+      transfer(4, 5, 5000),
+      transfer(5, 4, 20000),  // exceeds balance
+      transfer(6, 7, 9999),
+      transfer(7, 6, 19999),
+      transfer(3, 2, 1),
+  };
+
+  StatefulValidatorImpl sequential;
+  auto pool = std::make_shared<ThreadPool>(3);
+  StatefulValidatorImpl parallel(factory, pool);
+
+  auto expected = validate(sequential, txs);
+  auto verified = validate(parallel, txs);
+
+  ASSERT_EQ(6, expected.transactions.size());
+  ASSERT_EQ(expected.transactions, verified.transactions);
+  ASSERT_EQ(expected.height, verified.height);
+}
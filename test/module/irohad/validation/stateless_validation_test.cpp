@@ -108,3 +108,28 @@ TEST(stateless_validation,
 
   ASSERT_FALSE(transaction_validator.validate(tx));
 }
+
+TEST(stateless_validation, stateless_validation_of_batch) {
+  spdlog::set_level(spdlog::level::off);
+
+  auto crypto_provider = std::make_shared<iroha::model::MockCryptoProvider>();
+  iroha::validation::StatelessValidatorImpl transaction_validator(
+      crypto_provider);
+
+  auto tx = create_transaction();
+  auto late_tx = create_transaction();
+  late_tx.created_ts = iroha::time::now(1h);
+  std::vector<std::shared_ptr<const iroha::model::Transaction>> transactions{
+      std::make_shared<iroha::model::Transaction>(tx),
+      std::make_shared<iroha::model::Transaction>(tx),
+      std::make_shared<iroha::model::Transaction>(late_tx)};
+
+  EXPECT_CALL(
+      *crypto_provider,
+      verify(A<const std::vector<
+                 std::shared_ptr<const iroha::model::Transaction>> &>()))
+      .WillOnce(Return(std::vector<bool>{true, false, true}));
+
+  ASSERT_EQ(std::vector<bool>({true, false, false}),
+            transaction_validator.validate(transactions));
+}
@@ -28,6 +28,10 @@ namespace iroha {
     class MockStatelessValidator : public StatelessValidator {
      public:
       MOCK_CONST_METHOD1(validate, bool(const model::Transaction &));
+      MOCK_CONST_METHOD1(
+          validate,
+          std::vector<bool>(
+              const std::vector<std::shared_ptr<const model::Transaction>> &));
       MOCK_CONST_METHOD1(validate, bool(const model::Query &));
     };
 
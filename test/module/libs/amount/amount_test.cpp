@@ -16,6 +16,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <limits>
+#include <random>
 #include <amount/amount.hpp>
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
@@ -94,3 +96,59 @@ TEST_F(AmountTest, TestStringConversion) {
   ASSERT_FALSE(iroha::Amount::createFromString("0..20"));
   ASSERT_FALSE(iroha::Amount::createFromString("-0.20"));
 }
+
+/**
+ * @given pseudo-random 256-bit values
+ * @when they are converted, summed, subtracted and printed
+ * @then results are the same as of boost multiprecision
+ */
+TEST_F(AmountTest, FixedWidthMatchesBoost) {
+  using boost::multiprecision::uint256_t;
+  std::mt19937_64 random(42);
+  for (int i = 0; i < 1000; i++) {
+    std::vector<uint64_t> limbs{random(), random(), random(), random()};
+    // cover shorter values too
+    std::fill_n(limbs.begin(), i % 4, 0);
+    uint256_t value = 0;
+    for (auto limb : limbs) {
+      value = (value << 64) | limb;
+    }
+
+    iroha::Amount a(limbs.at(0), limbs.at(1), limbs.at(2), limbs.at(3));
+    ASSERT_EQ(limbs, a.to_uint64s());
+    ASSERT_EQ(value, a.getIntValue());
+    ASSERT_EQ(value.str(), a.to_string());
+    ASSERT_EQ(limbs, iroha::Amount(value).to_uint64s());
+
+    auto half = value / 2;
+    auto sum = iroha::Amount(half) + iroha::Amount(value - half);
+    ASSERT_TRUE(sum);
+    ASSERT_EQ(value, sum->getIntValue());
+
+    auto difference = iroha::Amount(value) - iroha::Amount(half);
+    ASSERT_TRUE(difference);
+    ASSERT_EQ(value - half, difference->getIntValue());
+    ASSERT_LE(*difference, a);
+  }
+}
+
+/**
+ * @given amounts at the bounds of 256-bit range
+ * @when they overflow on sum, subtraction, scaling or parsing
+ * @then overflow is reported instead of wrapping around
+ */
+TEST_F(AmountTest, OverflowIsDetected) {
+  auto max = std::numeric_limits<uint64_t>::max();
+  iroha::Amount largest(max, max, max, max);
+
+  ASSERT_FALSE(largest + iroha::Amount(1));
+  ASSERT_FALSE(iroha::Amount(0) - iroha::Amount(1));
+
+  // scaling largest value to precision of other amount overflows
+  ASSERT_GT(largest, iroha::Amount(1, 1));
+  ASSERT_LT(iroha::Amount(1, 1), largest);
+
+  ASSERT_EQ(largest.to_string(),
+            iroha::Amount::createFromString(largest.to_string())->to_string());
+  ASSERT_FALSE(iroha::Amount::createFromString(std::string(78, '9')));
+}
@@ -44,3 +44,27 @@ TEST(Signature, PrintkeyPair) {
   ASSERT_NO_THROW({ std::cout << keypair.pubkey.to_base64() << std::endl; });
   ASSERT_NO_THROW({ std::cout << keypair.privkey.to_base64() << std::endl; });
 }
+
+/**
+ * @given batch of signatures with one of them made by another key
+ * @when the batch is verified
+ * @then only that signature is reported invalid
+ */
+TEST(Signature, VerifyBatch) {
+  auto keypair = iroha::create_keypair();
+  auto other = iroha::create_keypair();
+
+  std::vector<std::string> messages{"first", "second", "third"};
+  std::vector<iroha::sig_t> signatures;
+  for (const auto &message : messages) {
+    signatures.push_back(sign(message, keypair.pubkey, keypair.privkey));
+  }
+  signatures[1] = sign(messages[1], other.pubkey, other.privkey);
+
+  std::vector<iroha::SignatureCheck> checks;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    checks.push_back({messages[i], keypair.pubkey, signatures[i]});
+  }
+
+  ASSERT_EQ(std::vector<bool>({true, false, true}), iroha::verifyBatch(checks));
+}
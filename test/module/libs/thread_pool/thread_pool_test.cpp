@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+
+#include "thread_pool/thread_pool.hpp"
+
+using namespace iroha;
+
+/**
+ * @given pool with several workers
+ * @when parallelFor is called
+ * @then function is called exactly once for every index
+ */
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndex) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> visits(1000);
+  for (auto &visit : visits) {
+    visit = 0;
+  }
+
+  pool.parallelFor(visits.size(), [&visits](size_t i) { ++visits[i]; });
+
+  for (auto &visit : visits) {
+    ASSERT_EQ(1, visit);
+  }
+}
+
+/**
+ * @given pool with a single worker
+ * @when parallelFor is called from a task running on that worker
+ * @then it completes on the calling worker without deadlock
+ */
+TEST(ThreadPoolTest, NestedParallelForCompletes) {
+  ThreadPool pool(1);
+  std::promise<size_t> sum;
+
+  pool.post([&pool, &sum] {
+    std::atomic<size_t> total{0};
+    pool.parallelFor(10, [&total](size_t i) { total += i; });
+    sum.set_value(total);
+  });
+
+  ASSERT_EQ(45, sum.get_future().get());
+}
+
+/**
+ * @given pool without workers
+ * @when task is posted
+ * @then it runs on the calling thread
+ */
+TEST(ThreadPoolTest, EmptyPoolRunsInline) {
+  ThreadPool pool(0);
+  auto caller = std::this_thread::get_id();
+  std::thread::id executor;
+
+  pool.post([&executor] { executor = std::this_thread::get_id(); });
+
+  ASSERT_EQ(caller, executor);
+}
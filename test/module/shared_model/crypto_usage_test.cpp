@@ -46,3 +46,19 @@ TEST_F(CryptoInitialization, RawSignAndVerifyTest) {
       CryptoVerifier<>::verify(signed_blob, *data, keypair->publicKey());
   ASSERT_TRUE(verified);
 }
+
+/**
+ * @given signatures of two blobs, the second one checked against other data
+ * @when they are verified as a batch
+ * @then only the first one is valid
+ */
+TEST_F(CryptoInitialization, RawSignAndVerifyBatchTest) {
+  Blob other("other data");
+  auto signed_blob = CryptoSigner<>::sign(*data, *keypair);
+  auto signed_other = CryptoSigner<>::sign(other, *keypair);
+
+  auto verified = CryptoVerifier<>::verifyBatch(
+      {{signed_blob, *data, keypair->publicKey()},
+       {signed_other, *data, keypair->publicKey()}});
+  ASSERT_EQ(std::vector<bool>({true, false}), verified);
+}